@@ -191,6 +191,14 @@ static QString unsupportedHint(const QString& t)
                "to the generated glue. Use the std spelling (`std::string`, "
                "`std::vector<T>`, `std::map<std::string, T>`) or the untyped "
                "`LogosMap` / `LogosList`.";
+    if (t.startsWith("std::future<") || t.startsWith("std::shared_future<"))
+        return "A std::future can only be waited on, which parks a host thread "
+               "for the whole call. Return `logos::Deferred<T>` "
+               "(logos_deferred.h) and resolve it when the value is ready: the "
+               "contract publishes plain `T` either way.";
+    if (t.startsWith("logos::Deferred<") || t.startsWith("Deferred<"))
+        return "`logos::Deferred<T>` is a method RETURN type only; a parameter "
+               "or an event has no reply to defer. Declare the plain `T`.";
     if (t.endsWith("*") || t.endsWith("&&"))
         return "A pointer or rvalue reference has no wire form. Pass the value "
                "(by value or `const T&`), or a `struct` declared in this "
@@ -857,6 +865,17 @@ static bool parseMethodLine(const QString& line, MethodDecl& out,
         return false;
     out.name = methodName.toStdString();
     QString retTypeStr = stripDeclarationSpecifiers(prefix.left(nameStart).trimmed());
+    // A method that answers later returns logos::Deferred<T> (logos_deferred.h)
+    // and publishes plain T: the generated dispatch tells the two apart at
+    // compile time, and no consumer can observe which one the impl chose. An
+    // event has no reply to defer, so there the spelling stays unsupported.
+    if (kind == "method") {
+        static const QRegularExpression deferredRe(
+            "^(?:logos::)?Deferred\\s*<\\s*(.+)\\s*>$");
+        const QRegularExpressionMatch dm = deferredRe.match(normalizeCppSpelling(retTypeStr));
+        if (dm.hasMatch())
+            retTypeStr = dm.captured(1).trimmed();
+    }
     out.returnType = cppTypeToLidl(
         retTypeStr, QString("%1 '%2': return type").arg(kind, methodName), retTypeStr,
         QString(), /*nameEmitted=*/kind == "event");
@@ -20,6 +20,7 @@
 //   std::vector<int64_t>          → [int]
 //   std::vector<uint64_t>         → [uint]
 //   void                          → void
+//   logos::Deferred<T> (return)   → T, answered later (logos_deferred.h)
 
 struct ImplParseResult {
     ModuleDecl module;
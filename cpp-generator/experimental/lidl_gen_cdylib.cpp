@@ -1,11 +1,15 @@
 #include "lidl_gen_cdylib.h"
 #include "lidl_emit_common.h"
 
+#include <QStringList>
 #include <QTextStream>
 
+#include <algorithm>
 #include <functional>
+#include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 QString lidlToPascalCase(const QString& name);
 QString lidlTypeToQt(const TypeExpr& te);
@@ -409,6 +413,138 @@ void emitRecordCodecs(QTextStream& s, const ModuleDecl& module,
     s << "}}  // namespace logos::detail\n\n";
 }
 
+// ── The generated reply writers ─────────────────────────────────────────────
+//
+// A typed return is written straight into the reply buffer with a
+// logos::ReplyWriter (logos_reply_buffer.h), never through the nlohmann::json
+// the codec above builds: for a `[Record]` return that DOM cost as much as the
+// text, and the text was then copied out of it. A record gets a writer of its
+// own, `lidlWrite_<Name>`, which is its codec's `to()` written as text.
+//
+// The bytes are the ones the DOM would have dumped to. The one thing a DOM
+// does that text does not is sort an object's keys, so a record's fields are
+// written in key order rather than declaration order. A typed map is written
+// in its own iteration order: a std::map's is the DOM's; an unordered_map
+// gives the same object in another order.
+//
+// Untyped JSON — `any`, LogosMap, LogosList — and the result object are JSON
+// already, and still go through logos::dumpToMalloc.
+
+QString replyWriterFn(const std::string& record)
+{
+    return "lidlWrite_" + qs(record);
+}
+
+// Whether the return is written as text, rather than dumped from the JSON it
+// already is.
+bool replyIsWritten(const MethodDecl& md, const std::set<std::string>& recs)
+{
+    if (md.resultReturn) return false;
+    const QString cpp = lidlTypeToStdCdylib(md.returnType, recs);
+    return cpp != "LogosMap" && cpp != "LogosList";
+}
+
+// The statement writing `expr` (of contract type `te`) to the writer `w`.
+// `depth` keeps a nested loop's variable from shadowing its enclosing one.
+QString replyWriteStmt(const TypeExpr& te, const QString& expr,
+                       const std::set<std::string>& recs, int depth = 0)
+{
+    const QString cpp = lidlTypeToStdCdylib(te, recs);
+    if (cpp == "LogosMap" || cpp == "LogosList")
+        return "w.value(" + expr + ");";
+    if (te.kind == TypeExpr::Optional)
+        return "if (" + expr + ") { "
+             + replyWriteStmt(optionalValueType(te), "(*" + expr + ")", recs, depth)
+             + " } else { w.null(); }";
+    if (isRecord(te, recs))
+        return replyWriterFn(te.name) + "(w, " + expr + ");";
+    const QString n = QString::number(depth);
+    if (te.kind == TypeExpr::Array && te.elements.size() == 1)
+        return "w.beginArray(); for (const auto& e" + n + " : " + expr + ") { "
+             + replyWriteStmt(te.elements[0], "e" + n, recs, depth + 1) + " } w.endArray();";
+    if (te.kind == TypeExpr::Map && te.elements.size() == 2)
+        return "w.beginObject(); for (const auto& kv" + n + " : " + expr + ") { w.key(kv" + n
+             + ".first); " + replyWriteStmt(te.elements[1], "kv" + n + ".second", recs, depth + 1)
+             + " } w.endObject();";
+    if (te.kind == TypeExpr::Primitive && te.name == "bstr")
+        return "w.bytes(" + expr + ");";
+    return "w.value(" + expr + ");";
+}
+
+// The encode step of a method's reply, from the value in `var`: a body that
+// returns the malloc'd reply.
+QString replyEncodeBody(const MethodDecl& md, const QString& var,
+                        const std::set<std::string>& recs)
+{
+    if (!replyIsWritten(md, recs))
+        return "return logos::dumpToMalloc(" + stdReturnToJson(md, var, recs) + ");";
+    return "logos::ReplyWriter w; " + replyWriteStmt(md.returnType, var, recs)
+         + " return w.release();";
+}
+
+// The records a written reply reaches, directly or through another record's
+// fields. Only these get a writer: any other would be unused.
+void collectWrittenRecords(const TypeExpr& te, const ModuleDecl& module,
+                           const std::set<std::string>& recs, std::set<std::string>& out)
+{
+    const QString cpp = lidlTypeToStdCdylib(te, recs);
+    if (cpp == "LogosMap" || cpp == "LogosList") return;
+    if (te.kind == TypeExpr::Optional) {
+        collectWrittenRecords(optionalValueType(te), module, recs, out);
+        return;
+    }
+    if (isRecord(te, recs)) {
+        if (!out.insert(te.name).second) return;
+        for (const TypeDecl& t : module.types) {
+            if (t.name != te.name) continue;
+            for (const FieldDecl& f : t.fields)
+                collectWrittenRecords(fieldIsOptional(f) ? fieldValueType(f) : f.type,
+                                      module, recs, out);
+        }
+        return;
+    }
+    for (const TypeExpr& e : te.elements)
+        collectWrittenRecords(e, module, recs, out);
+}
+
+void emitReplyWriters(QTextStream& s, const ModuleDecl& module,
+                      const std::set<std::string>& recs)
+{
+    std::set<std::string> written;
+    for (const MethodDecl& md : module.methods)
+        if (replyIsWritten(md, recs)) collectWrittenRecords(md.returnType, module, recs, written);
+    if (written.empty()) return;
+    // Declared first, so a record may hold any other.
+    for (const TypeDecl& t : module.types)
+        if (written.count(t.name))
+            s << "void " << replyWriterFn(t.name) << "(logos::ReplyWriter& w, const "
+              << qs(t.name) << "& v);\n";
+    s << "\n";
+    for (const TypeDecl& t : module.types) {
+        if (!written.count(t.name)) continue;
+        std::vector<FieldDecl> fields = t.fields;
+        std::stable_sort(fields.begin(), fields.end(),
+                         [](const FieldDecl& a, const FieldDecl& b) { return a.name < b.name; });
+        s << "void " << replyWriterFn(t.name) << "(logos::ReplyWriter& w, const " << qs(t.name)
+          << "& v)\n{\n";
+        s << "    w.beginObject();\n";
+        for (const FieldDecl& f : fields) {
+            const QString fn = qs(f.name);
+            // As the codec's to(): an empty optional field omits its key.
+            if (lidlFieldTypeCdylib(f, recs).startsWith("std::optional<")) {
+                s << "    if (v." << fn << ".has_value()) { w.key(\"" << fn << "\"); "
+                  << replyWriteStmt(fieldValueType(f), "(*v." + fn + ")", recs) << " }\n";
+            } else {
+                s << "    w.key(\"" << fn << "\"); "
+                  << replyWriteStmt(fieldIsOptional(f) ? fieldValueType(f) : f.type, "v." + fn, recs)
+                  << "\n";
+            }
+        }
+        s << "    w.endObject();\n";
+        s << "}\n\n";
+    }
+}
+
 // The type name a method's PUBLISHED metadata carries — getMethods()'s
 // `returnType`, `parameters[].type` and `signature`.
 //
@@ -442,6 +578,91 @@ QString lidlTypeToPublishedName(const TypeExpr& te)
     return lidlTypeToLidlText(te);
 }
 
+// An event marked coalescible: a state snapshot where only the newest value
+// matters, so a pending payload is replaced rather than queued. The mark is a
+// line of the event's doc comment reading exactly `@coalesce`:
+//
+//     /// Sync progress, 0..1.
+//     /// @coalesce
+//     void progressChanged(double pct);
+//
+// A doc-comment tag rather than LIDL syntax because the grammar belongs to
+// logos-lidl, while descriptions already survive every path a contract takes
+// here: parsed from the impl header, written to the `.lidl` sidecar, read back
+// by a contract-first build.
+std::vector<std::string> descriptionLines(const std::string& description)
+{
+    std::vector<std::string> lines;
+    std::size_t start = 0;
+    for (;;) {
+        const std::size_t nl = description.find('\n', start);
+        lines.push_back(description.substr(start, nl == std::string::npos ? std::string::npos : nl - start));
+        if (nl == std::string::npos) return lines;
+        start = nl + 1;
+    }
+}
+
+bool isBlankLine(const std::string& line)
+{
+    return line.find_first_not_of(" \t\r") == std::string::npos;
+}
+
+bool isCoalesceTag(const std::string& line)
+{
+    const std::size_t b = line.find_first_not_of(" \t\r");
+    if (b == std::string::npos) return false;
+    const std::size_t e = line.find_last_not_of(" \t\r");
+    return line.compare(b, e - b + 1, "@coalesce") == 0;
+}
+
+bool eventCoalesces(const EventDecl& ed)
+{
+    for (const std::string& line : descriptionLines(ed.description))
+        if (isCoalesceTag(line)) return true;
+    return false;
+}
+
+bool moduleCoalescesEvents(const ModuleDecl& module)
+{
+    for (const EventDecl& ed : module.events)
+        if (eventCoalesces(ed)) return true;
+    return false;
+}
+
+// A method's `@cache <ttl_ms>` / `@invalidated-by <event>` / `@single-flight`
+// lines: a call policy for
+// the CONSUMER's generated wrapper, which reads them from the contract (see
+// cpp-generator/lidl_to_json.cpp). Nothing here acts on them.
+bool isMethodCacheTag(const std::string& line)
+{
+    const std::size_t b = line.find_first_not_of(" \t\r");
+    if (b == std::string::npos) return false;
+    for (const char* tag : {"@cache", "@invalidated-by", "@single-flight"}) {
+        const std::size_t n = std::char_traits<char>::length(tag);
+        if (line.compare(b, n, tag) == 0
+            && (b + n == line.size() || line[b + n] == ' ' || line[b + n] == '\t' || line[b + n] == '\r'))
+            return true;
+    }
+    return false;
+}
+
+// A description as published: the directives are policy, not documentation,
+// so they are left out of what inspectors show.
+std::string publishedDescription(const std::string& description)
+{
+    std::vector<std::string> kept;
+    for (const std::string& line : descriptionLines(description))
+        if (!isCoalesceTag(line) && !isMethodCacheTag(line)) kept.push_back(line);
+    while (!kept.empty() && isBlankLine(kept.front())) kept.erase(kept.begin());
+    while (!kept.empty() && isBlankLine(kept.back())) kept.pop_back();
+    std::string out;
+    for (std::size_t i = 0; i < kept.size(); ++i) {
+        if (i) out += '\n';
+        out += kept[i];
+    }
+    return out;
+}
+
 // True when any event parameter is spelled LogosMap / LogosList, so the sidecar
 // needs <logos_json.h> for those aliases.
 bool hasJsonEventParam(const ModuleDecl& module)
@@ -474,64 +695,284 @@ bool hasJsonEventParam(const ModuleDecl& module)
 // (`[bstr]`, `{tstr: bstr}`, records) has been doing through logos::Codec since
 // #117.
 
-void emitInterfaceJson(QTextStream& s, const ModuleDecl& module)
+// -- the published interface document ---------------------------------------
+//
+// logos_module_get_methods used to build the whole methods/events listing as an
+// nlohmann DOM on every call, dump it, and copy the dump — for an answer fixed
+// the moment this file was generated. Inspectors and `lm` poll it across every
+// loaded module, so that rebuild showed up in per-module CPU for no reason.
+//
+// The generator now writes the document ONCE, as the text the old code's
+// `.dump()` produced, and the export copies it out of a constexpr literal. The
+// bytes are the same by construction: keys in the order nlohmann's object map
+// sorted them (bytewise), compact separators, and strings escaped the way its
+// serializer escapes them with ensure_ascii off — `"`, `\`, the short control
+// escapes, `\u00xx` (lowercase) for the rest below 0x20, UTF-8 passed through.
+//
+// One deliberate difference: a description that is not valid UTF-8 used to make
+// `.dump()` throw inside an extern "C" export. Each offending byte is published
+// as U+FFFD instead, so the document is always valid JSON.
+
+// Appends `in` as a JSON string literal, quotes included.
+void appendJsonString(std::string& out, const std::string& in)
 {
-    s << "static nlohmann::json lidlInterfaceJson()\n{\n";
-    s << "    nlohmann::json methods = nlohmann::json::array();\n";
-    for (const MethodDecl& md : module.methods) {
-        s << "    {\n        nlohmann::json obj;\n";
-        s << "        obj[\"name\"] = \"" << md.name << "\";\n";
-        if (!md.description.empty()) {
-            QString esc = qs(md.description);
-            esc.replace('\\', "\\\\").replace('"', "\\\"").replace('\n', "\\n");
-            s << "        obj[\"description\"] = \"" << esc << "\";\n";
+    static const char hex[] = "0123456789abcdef";
+    out += '"';
+    for (std::size_t i = 0; i < in.size();) {
+        const unsigned char c = static_cast<unsigned char>(in[i]);
+        if (c < 0x80) {
+            switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    out += "\\u00";
+                    out += hex[c >> 4];
+                    out += hex[c & 0xf];
+                } else {
+                    out += static_cast<char>(c);
+                }
+            }
+            ++i;
+            continue;
         }
-        QString sig = qs(md.name) + "(";
-        for (int i = 0; i < md.params.size(); ++i) {
-            sig += lidlTypeToPublishedName(md.params[i].type);
-            if (i + 1 < md.params.size()) sig += ",";
+        // A well-formed multi-byte sequence passes through; anything else is
+        // one U+FFFD per byte.
+        std::size_t len = 0;
+        unsigned lo = 0x80, hi = 0xbf;
+        if (c >= 0xc2 && c <= 0xdf) len = 2;
+        else if (c >= 0xe0 && c <= 0xef) { len = 3; if (c == 0xe0) lo = 0xa0; if (c == 0xed) hi = 0x9f; }
+        else if (c >= 0xf0 && c <= 0xf4) { len = 4; if (c == 0xf0) lo = 0x90; if (c == 0xf4) hi = 0x8f; }
+        bool ok = len != 0 && i + len <= in.size();
+        for (std::size_t k = 1; ok && k < len; ++k) {
+            const unsigned char cc = static_cast<unsigned char>(in[i + k]);
+            ok = cc >= (k == 1 ? lo : 0x80) && cc <= (k == 1 ? hi : 0xbf);
         }
-        sig += ")";
-        s << "        obj[\"signature\"] = \"" << sig << "\";\n";
-        s << "        obj[\"returnType\"] = \"" << lidlTypeToPublishedName(md.returnType) << "\";\n";
-        s << "        obj[\"isInvokable\"] = true;\n";
-        if (!md.params.empty()) {
-            s << "        nlohmann::json params = nlohmann::json::array();\n";
-            for (const ParamDecl& pd : md.params) {
-                s << "        params.push_back({{\"type\", \"" << lidlTypeToPublishedName(pd.type)
-                  << "\"}, {\"name\", \"" << pd.name << "\"}});\n";
-            }
-            s << "        obj[\"parameters\"] = params;\n";
+        if (ok) {
+            out.append(in, i, len);
+            i += len;
+        } else {
+            out += "\xef\xbf\xbd";
+            ++i;
         }
-        s << "        methods.push_back(obj);\n    }\n";
     }
-    for (const EventDecl& ed : module.events) {
-        s << "    {\n        nlohmann::json obj;\n";
-        s << "        obj[\"type\"] = \"event\";\n";
-        s << "        obj[\"name\"] = \"" << ed.name << "\";\n";
-        if (!ed.description.empty()) {
-            QString esc = qs(ed.description);
-            esc.replace('\\', "\\\\").replace('"', "\\\"").replace('\n', "\\n");
-            s << "        obj[\"description\"] = \"" << esc << "\";\n";
+    out += '"';
+}
+
+std::string publishedSignature(const std::string& name, const std::vector<ParamDecl>& params)
+{
+    std::string sig = name + "(";
+    for (std::size_t i = 0; i < params.size(); ++i) {
+        sig += lidlTypeToPublishedName(params[i].type).toStdString();
+        if (i + 1 < params.size()) sig += ",";
+    }
+    return sig + ")";
+}
+
+std::string publishedParameters(const std::vector<ParamDecl>& params)
+{
+    std::string out = "[";
+    for (std::size_t i = 0; i < params.size(); ++i) {
+        if (i) out += ',';
+        out += "{\"name\":";
+        appendJsonString(out, params[i].name);
+        out += ",\"type\":";
+        appendJsonString(out, lidlTypeToPublishedName(params[i].type).toStdString());
+        out += '}';
+    }
+    return out + "]";
+}
+
+// One entry per method, then one per event — the listing's order — each the
+// compact JSON of that entry.
+std::vector<std::string> interfaceDocumentEntries(const ModuleDecl& module)
+{
+    std::vector<std::string> entries;
+    for (const MethodDecl& md : module.methods) {
+        std::string e = "{";
+        const std::string description = publishedDescription(md.description);
+        if (!description.empty()) {
+            e += "\"description\":";
+            appendJsonString(e, description);
+            e += ',';
         }
-        QString sig = qs(ed.name) + "(";
-        for (int i = 0; i < ed.params.size(); ++i) {
-            sig += lidlTypeToPublishedName(ed.params[i].type);
-            if (i + 1 < ed.params.size()) sig += ",";
+        e += "\"isInvokable\":true,\"name\":";
+        appendJsonString(e, md.name);
+        if (!md.params.empty())
+            e += ",\"parameters\":" + publishedParameters(md.params);
+        e += ",\"returnType\":";
+        appendJsonString(e, lidlTypeToPublishedName(md.returnType).toStdString());
+        e += ",\"signature\":";
+        appendJsonString(e, publishedSignature(md.name, md.params));
+        entries.push_back(e + "}");
+    }
+    for (const EventDecl& ed : module.events) {
+        std::string e = "{";
+        const std::string description = publishedDescription(ed.description);
+        if (!description.empty()) {
+            e += "\"description\":";
+            appendJsonString(e, description);
+            e += ',';
         }
-        sig += ")";
-        s << "        obj[\"signature\"] = \"" << sig << "\";\n";
-        if (!ed.params.empty()) {
-            s << "        nlohmann::json params = nlohmann::json::array();\n";
-            for (const ParamDecl& pd : ed.params) {
-                s << "        params.push_back({{\"type\", \"" << lidlTypeToPublishedName(pd.type)
-                  << "\"}, {\"name\", \"" << pd.name << "\"}});\n";
-            }
-            s << "        obj[\"parameters\"] = params;\n";
+        e += "\"name\":";
+        appendJsonString(e, ed.name);
+        if (!ed.params.empty())
+            e += ",\"parameters\":" + publishedParameters(ed.params);
+        e += ",\"signature\":";
+        appendJsonString(e, publishedSignature(ed.name, ed.params));
+        entries.push_back(e + ",\"type\":\"event\"}");
+    }
+    return entries;
+}
+
+// `text` as the body of a C++ string literal. Everything outside printable
+// ASCII is a three-digit octal escape, which can never swallow the character
+// after it, so the literal means the same bytes whatever the source charset.
+// A `?` next to another `?` is escaped too, so no description can spell a
+// trigraph for a pre-C++17 build.
+QString cStringLiteralBody(const std::string& text)
+{
+    std::string out;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        const char ch = text[i];
+        const unsigned char c = static_cast<unsigned char>(ch);
+        if (c == '"' || c == '\\' || (c == '?' && ((i + 1 < text.size() && text[i + 1] == '?') || (i > 0 && text[i - 1] == '?')))) {
+            out += '\\';
+            out += ch;
+        } else if (c < 0x20 || c >= 0x7f) {
+            out += '\\';
+            out += static_cast<char>('0' + (c >> 6));
+            out += static_cast<char>('0' + ((c >> 3) & 7));
+            out += static_cast<char>('0' + (c & 7));
+        } else {
+            out += ch;
         }
-        s << "        methods.push_back(obj);\n    }\n";
     }
-    s << "    return methods;\n}\n\n";
+    return QString::fromStdString(out);
+}
+
+void emitInterfaceDocument(QTextStream& s, const ModuleDecl& module)
+{
+    const std::vector<std::string> entries = interfaceDocumentEntries(module);
+    s << "// The published interface, serialized at generation time: what\n";
+    s << "// logos_module_get_methods answers, byte for byte, on every call.\n";
+    s << "static constexpr char lidlInterfaceDocument[] =\n";
+    if (entries.empty()) {
+        s << "    \"[]\";\n\n";
+        return;
+    }
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        s << "    \"" << (i == 0 ? "[" : ",") << cStringLiteralBody(entries[i])
+          << (i + 1 == entries.size() ? "]\";\n\n" : "\"\n");
+    }
+}
+
+// True for a method the scalar fast path can take: every parameter a required
+// LIDL scalar, and a body that is a call into the impl. A derived identity
+// method has no parameters to read and no impl member to call.
+bool scalarOnly(const MethodDecl& md)
+{
+    if (md.derived && lidl::isIdentityMethod(md.name)) return false;
+    for (const ParamDecl& pd : md.params) {
+        const TypeExpr& t = pd.type;
+        if (t.kind != TypeExpr::Primitive) return false;
+        if (!(t.name == "int" || t.name == "uint" || t.name == "float64"
+              || t.name == "bool" || t.name == "tstr"))
+            return false;
+    }
+    return true;
+}
+
+// -- method lookup -----------------------------------------------------------
+//
+// The dispatch used to be one `if (m == "<name>")` per method, after building a
+// std::string from the C name on every call. On a 60-method contract the last
+// method paid 60 compares and an allocation before its own body ran, and the
+// cost of a call depended on where the author happened to declare it.
+//
+// What replaces it is a decision tree the generator builds from the contract's
+// names: switch on the length, then on whichever byte position best separates
+// the names of that length, recursing until every leaf holds ONE name, and
+// confirm that one with a single memcmp. Every method therefore costs one
+// strlen, a switch per level (a jump table, in practice one or two levels) and
+// exactly one memcmp, wherever it sits in the contract — and nothing allocates.
+//
+// The tree is a pure function of the names, so regenerating an unchanged
+// contract emits byte-identical source.
+
+using LidlNamedIndex = std::pair<std::string, int>;
+
+// A byte as a `case` label. Method names are LIDL identifiers, but the label is
+// escaped anyway rather than trusting that upstream, since a stray quote would
+// be a syntax error in a TU the author never reads.
+QString lidlCaseLabel(char c)
+{
+    if (c == '\'' || c == '\\') return QString("'\\") + c + "'";
+    if (c >= 0x20 && c < 0x7f) return QString("'") + c + "'";
+    return QString::number(static_cast<int>(static_cast<unsigned char>(c)));
+}
+
+// The byte position among `[0, len)` that splits `names` into the most groups.
+// Ties go to the lowest position, which keeps the output deterministic. Names of
+// equal length that are distinct always differ somewhere, so the best split has
+// at least two groups whenever there are at least two names.
+size_t lidlBestSplit(const std::vector<LidlNamedIndex>& names, size_t len)
+{
+    size_t best = 0, bestGroups = 0;
+    for (size_t pos = 0; pos < len; ++pos) {
+        std::set<char> seen;
+        for (const LidlNamedIndex& n : names) seen.insert(n.first[pos]);
+        if (seen.size() > bestGroups) { best = pos; bestGroups = seen.size(); }
+    }
+    return best;
+}
+
+void emitLookupNode(QTextStream& s, const std::vector<LidlNamedIndex>& names,
+                    size_t len, const QString& indent)
+{
+    if (names.size() == 1) {
+        s << indent << "return std::memcmp(method, \"" << names[0].first << "\", "
+          << static_cast<unsigned long long>(len) << ") == 0 ? "
+          << names[0].second << " : -1;\n";
+        return;
+    }
+    const size_t pos = lidlBestSplit(names, len);
+    std::map<char, std::vector<LidlNamedIndex>> groups;
+    for (const LidlNamedIndex& n : names) groups[n.first[pos]].push_back(n);
+    s << indent << "switch (method[" << static_cast<unsigned long long>(pos) << "]) {\n";
+    for (const auto& g : groups) {
+        s << indent << "case " << lidlCaseLabel(g.first) << ":\n";
+        emitLookupNode(s, g.second, len, indent + "    ");
+    }
+    s << indent << "}\n";
+    s << indent << "return -1;\n";
+}
+
+// `lidlMethodIndex(name)` -> the method's position in the contract, or -1.
+// A name declared twice keeps its FIRST position, which is the method the old
+// if-chain reached.
+void emitMethodIndex(QTextStream& s, const ModuleDecl& module)
+{
+    std::map<size_t, std::vector<LidlNamedIndex>> byLength;
+    std::set<std::string> seen;
+    for (size_t i = 0; i < module.methods.size(); ++i) {
+        const std::string& name = module.methods[i].name;
+        if (!seen.insert(name).second) continue;
+        byLength[name.size()].push_back({name, static_cast<int>(i)});
+    }
+    s << "int lidlMethodIndex(const char* method)\n{\n";
+    s << "    switch (std::strlen(method)) {\n";
+    for (const auto& bucket : byLength) {
+        s << "    case " << static_cast<unsigned long long>(bucket.first) << ":\n";
+        emitLookupNode(s, bucket.second, bucket.first, "        ");
+    }
+    s << "    }\n";
+    s << "    return -1;\n}\n\n";
 }
 
 } // namespace
@@ -643,15 +1084,28 @@ QString lidlMakeModuleImplExports(const ModuleDecl& module,
     // header with no protocol dependency of its own, so it costs nothing on an
     // older protocol where the export below is not emitted.
     s << "#include \"logos_caller.h\"\n";
+    // The scalar fast path's in-place argument reader. Unconditional for the
+    // same reason: header-only, and free when no method takes the path.
+    s << "#include \"logos_scalar_args.h\"\n";
+    s << "#include \"logos_reply_buffer.h\"\n";
+    // logos::Deferred, which lidlReply() recognises in any method's return.
+    s << "#include \"logos_deferred.h\"\n";
     s << "#include <nlohmann/json.hpp>\n";
+    s << "#include <cstdint>\n";
     s << "#include <cstdlib>\n";
     s << "#include <cstring>\n";
     s << "#include <atomic>\n";
+    if (moduleCoalescesEvents(module))
+        s << "#include <chrono>\n";
+    s << "#include <condition_variable>\n";
     s << "#include <map>\n";
+    s << "#include <memory>\n";
     s << "#include <mutex>\n";
     if (moduleUsesOptional(module))
         s << "#include <optional>\n";
     s << "#include <string>\n";
+    s << "#include <thread>\n";
+    s << "#include <utility>\n";
     s << "#include <vector>\n";
     // The Qt-free typed dependency surface: LogosModules (behind modules())
     // built from this module's dependencies (metadata.json#dependencies),
@@ -664,9 +1118,123 @@ QString lidlMakeModuleImplExports(const ModuleDecl& module,
     // -- shared statics ------------------------------------------------------
     s << "namespace {\n\n";
     s << implClass << "& lidlImpl()\n{\n    static " << implClass << " impl;\n    return impl;\n}\n\n";
-    s << "logos_module_emit_cb g_emitCb = nullptr;\n";
-    s << "void* g_emitUd = nullptr;\n";
-    s << "std::mutex g_emitMutex;\n";
+    // The host's emit callbacks, each published as one immutable (cb, ud)
+    // snapshot behind an atomic pointer. The emit callback used to sit behind
+    // g_emitMutex, held across the payload dump AND the host's callback, so
+    // every thread emitting an event queued behind the slowest callback in
+    // flight. Emitters now load the snapshot and never block one another. That
+    // also means the host's callback can be entered from several emitting
+    // threads at once.
+    //
+    // `inflight` counts emitters inside a snapshot's callback. set() swaps the
+    // pointer, then sleeps until the old snapshot has drained. So once it
+    // returns the old (cb, ud) is never called again, the same guarantee the
+    // mutex gave a host that clears its callback before freeing user_data.
+    //
+    // A drained snapshot is retired, not freed at once: an emitter may still
+    // be about to bump the count of one it loaded just before the swap.
+    // `entering` counts emitters between loading a snapshot and counting
+    // themselves into the current one. A set() that finds it at zero knows no
+    // emitter can reach a retired snapshot any more, and frees them all; one
+    // that does not leaves them to the next set().
+    s << "template<class Cb>\n";
+    s << "class LidlCallbackSlot {\n";
+    s << "public:\n";
+    s << "    ~LidlCallbackSlot() { delete m_current.load(); }\n\n";
+    s << "    bool armed() const { return m_current.load(std::memory_order_acquire) != nullptr; }\n\n";
+    // Enter the CURRENT snapshot: bump its count, then re-check it is still
+    // published. A setter swaps before it drains, so either it sees this count
+    // or this emitter sees the swap and backs out.
+    s << "    // Calls f(cb, ud) on the current snapshot; false when none is set.\n";
+    s << "    template<class F>\n";
+    s << "    bool call(F&& f)\n    {\n";
+    s << "        m_entering.fetch_add(1);\n";
+    s << "        for (;;) {\n";
+    s << "            Target* t = m_current.load();\n";
+    s << "            if (!t) {\n";
+    s << "                m_entering.fetch_sub(1);\n";
+    s << "                return false;\n";
+    s << "            }\n";
+    s << "            t->inflight.fetch_add(1);\n";
+    s << "            if (m_current.load() != t) {\n";
+    s << "                leave(t);\n";
+    s << "                continue;\n";
+    s << "            }\n";
+    s << "            m_entering.fetch_sub(1);\n";
+    s << "            f(t->cb, t->ud);\n";
+    s << "            leave(t);\n";
+    s << "            return true;\n";
+    s << "        }\n";
+    s << "    }\n\n";
+    s << "    void set(Cb cb, void* ud)\n    {\n";
+    s << "        std::lock_guard<std::mutex> lock(m_setMutex);\n";
+    s << "        Target* prev = m_current.exchange(cb ? new Target(cb, ud) : nullptr);\n";
+    s << "        if (prev) {\n";
+    s << "            m_draining.store(prev);\n";
+    s << "            {\n";
+    s << "                std::unique_lock<std::mutex> wait(m_drainMutex);\n";
+    s << "                m_drained.wait(wait, [prev] { return prev->inflight.load() == 0; });\n";
+    s << "            }\n";
+    s << "            m_draining.store(nullptr);\n";
+    s << "            m_retired.emplace_back(prev);\n";
+    s << "        }\n";
+    s << "        if (m_entering.load() == 0) m_retired.clear();\n";
+    s << "    }\n\n";
+    s << "private:\n";
+    s << "    struct Target {\n";
+    s << "        Target(Cb c, void* u) : cb(c), ud(u) {}\n";
+    s << "        const Cb cb;\n";
+    s << "        void* const ud;\n";
+    s << "        std::atomic<int> inflight{0};\n";
+    s << "    };\n\n";
+    // Only the last one out of the snapshot a setter is waiting on takes the
+    // drain mutex; every other emitter leaves with the one decrement.
+    s << "    void leave(Target* t)\n    {\n";
+    s << "        if (t->inflight.fetch_sub(1) != 1 || m_draining.load() != t) return;\n";
+    s << "        std::lock_guard<std::mutex> lock(m_drainMutex);\n";
+    s << "        m_drained.notify_all();\n";
+    s << "    }\n\n";
+    s << "    std::atomic<Target*> m_current{nullptr};\n";
+    s << "    std::atomic<int> m_entering{0};\n";
+    s << "    std::mutex m_setMutex;  // serializes setters only; emitters never take it\n";
+    s << "    std::atomic<Target*> m_draining{nullptr};  // the snapshot set() is waiting on\n";
+    s << "    std::mutex m_drainMutex;\n";
+    s << "    std::condition_variable m_drained;\n";
+    s << "    std::vector<std::unique_ptr<Target>> m_retired;\n";
+    s << "};\n\n";
+    // The batch callback's type is spelled out rather than named through a
+    // protocol typedef, so the slot (and everything that buffers for it)
+    // compiles against any protocol; only the export that sets it is guarded.
+    s << "using LidlEmitBatchCb = void (*)(const char* events_json, void* user_data);\n";
+    s << "LidlCallbackSlot<logos_module_emit_cb> g_emit;\n";
+    s << "LidlCallbackSlot<LidlEmitBatchCb> g_emitBatch;\n\n";
+    // batchEvents() state, per thread: the impl opens a batch on the thread
+    // that emits, and only that thread's events are held back. Long batches
+    // are delivered in chunks so a batch around an unbounded loop cannot hold
+    // an unbounded buffer.
+    s << "struct LidlEventBatch {\n";
+    s << "    int depth = 0;\n";
+    s << "    std::vector<std::pair<std::string, std::string>> events;  // name, dumped args\n";
+    s << "};\n";
+    s << "thread_local LidlEventBatch t_eventBatch;\n";
+    s << "constexpr std::size_t kLidlMaxBatchedEvents = 4096;\n";
+    // Coalescible events: one slot per `@coalesce` event, holding only the
+    // newest payload not yet delivered. Posting REPLACES it (an older value
+    // nobody has seen yet is superseded, not queued), so a slot costs one
+    // exchange and the host sees at most one payload per event per flush.
+    if (moduleCoalescesEvents(module)) {
+        s << "\nstruct LidlCoalesceSlot {\n";
+        s << "    const char* name;\n";
+        s << "    std::atomic<std::string*> payload{nullptr};\n";
+        s << "};\n";
+        s << "LidlCoalesceSlot g_coalesceSlots[] = {\n";
+        for (const EventDecl& ed : module.events)
+            if (eventCoalesces(ed)) s << "    {\"" << ed.name << "\"},\n";
+        s << "};\n";
+        s << "std::atomic<bool> g_coalescePending{false};\n";
+        s << "std::mutex g_coalesceFlushMutex;  // orders flushes, so a newer value never overtakes an older one\n";
+        s << "constexpr std::chrono::milliseconds kLidlCoalesceInterval{50};\n";
+    }
     // Guarded on the protocol MINOR that introduced the teardown surface (0.5),
     // exactly like the trust-root surface below. The emitted module must still
     // COMPILE against an older logos-protocol, which has neither the callback
@@ -683,8 +1251,9 @@ QString lidlMakeModuleImplExports(const ModuleDecl& module,
     s << "std::mutex g_unloadMutex;\n";
     s << "#endif\n";
     s << "std::mutex g_ctxMutex;\n";
-    s << "bool g_ctxStored = false;\n";
+    s << "std::atomic<bool> g_ctxStored{false};\n";
     s << "std::string g_ctxPath, g_ctxId, g_ctxPersist;\n";
+    s << "std::atomic<bool> g_wired{false};\n";
     s << "std::atomic<bool> g_hookFired{false};\n\n";
 
     s << "char* lidlStrdup(const std::string& str)\n{\n";
@@ -699,10 +1268,188 @@ QString lidlMakeModuleImplExports(const ModuleDecl& module,
     s << "    obj[\"error\"] = r.error.empty() ? nlohmann::json() : nlohmann::json(r.error);\n";
     s << "    return obj;\n}\n\n";
 
-    emitInterfaceJson(s, module);
+    // -- replies that arrive later (logos_deferred.h) --------------------------
+    // A method may return logos::Deferred<T> for the T its contract publishes.
+    // The contract cannot say which methods do (it is the provider's business),
+    // so the choice is made by the compiler: every call goes through
+    // lidlReply(), and only the Deferred branch is ever instantiated for a
+    // method that returns one. For every other method it folds back into the
+    // direct call-and-serialize it replaces.
+    //
+    // `done` is the completion of a logos_module_dispatch_async call, and NULL
+    // on the synchronous path. With a completion, a Deferred's reply is handed
+    // to it once settled and lidlDispatchIndex answers lidlPendingReply();
+    // without one, the synchronous call waits for the value.
+    s << "using LidlCompleteCb = void (*)(const char* reply_json, void* user_data);\n";
+    s << "struct LidlCompletion {\n";
+    s << "    LidlCompleteCb cb;\n";
+    s << "    void* ud;\n";
+    s << "};\n\n";
+    s << "char* lidlPendingReply()\n{\n";
+    s << "    static char pending;\n";
+    s << "    return &pending;\n}\n\n";
+    s << "void lidlComplete(const LidlCompletion& done, char* reply)\n{\n";
+    s << "    done.cb(reply, done.ud);\n";
+    s << "    std::free(reply);\n}\n\n";
+    s << "char* lidlRejectedReply(const logos::DeferredRejected& e)\n{\n";
+    s << "    nlohmann::json err{{\"code\", e.code()}, {\"message\", e.what()},\n";
+    s << "                       {\"origin\", \"" << module.name << "\"}};\n";
+    s << "    return lidlStrdup(err.dump());\n}\n\n";
+    s << "template<class Call, class Encode>\n";
+    s << "char* lidlReply(const LidlCompletion* done, Call&& call, Encode&& encode)\n{\n";
+    s << "    using R = decltype(call());\n";
+    s << "    if constexpr (logos::isDeferred<R>::value) {\n";
+    s << "        using T = typename R::value_type;\n";
+    s << "        if (!done) {\n";
+    s << "            if constexpr (std::is_void_v<T>) {\n";
+    s << "                call()._logosCoreWait_();\n";
+    s << "                return lidlStrdup(\"true\");\n";
+    s << "            } else {\n";
+    s << "                return encode(call()._logosCoreWait_());\n";
+    s << "            }\n";
+    s << "        }\n";
+    s << "        call()._logosCoreOnSettled_(\n";
+    s << "            [to = *done, encode](const auto* value, const logos::DeferredRejected* error) {\n";
+    s << "                char* reply = nullptr;\n";
+    s << "                try {\n";
+    s << "                    if (error) reply = lidlRejectedReply(*error);\n";
+    s << "                    else if constexpr (std::is_void_v<T>) reply = lidlStrdup(\"true\");\n";
+    s << "                    else reply = encode(*value);\n";
+    s << "                } catch (const std::exception& e) {\n";
+    s << "                    nlohmann::json err{{\"code\", \"dispatch_failed\"}, {\"message\", e.what()},\n";
+    s << "                                       {\"origin\", \"" << module.name << "\"}};\n";
+    s << "                    reply = lidlStrdup(err.dump());\n";
+    s << "                }\n";
+    s << "                lidlComplete(to, reply);\n";
+    s << "            });\n";
+    s << "        return lidlPendingReply();\n";
+    s << "    } else if constexpr (std::is_void_v<R>) {\n";
+    s << "        call();\n";
+    s << "        return lidlStrdup(\"true\");\n";
+    s << "    } else {\n";
+    s << "        return encode(call());\n";
+    s << "    }\n}\n\n";
+
+    emitReplyWriters(s, module, recs);
+    emitInterfaceDocument(s, module);
+    emitMethodIndex(s, module);
     s << "} // namespace\n\n";
 
     // -- event wiring (install once, lazily) ---------------------------------
+    // Hands collected events to the host. A host that set a batch callback
+    // gets ONE call with
+    //     [{"args":[...],"name":"<event>"}, ...]
+    // (keys in nlohmann's order, like every other document this TU publishes);
+    // any other host gets its per-event callback once per event, in order.
+    s << "static void lidlDeliverEvents(std::vector<std::pair<std::string, std::string>>& events)\n{\n";
+    s << "    if (events.empty()) return;\n";
+    s << "    if (g_emitBatch.armed()) {\n";
+    s << "        std::string doc = \"[\";\n";
+    s << "        for (std::size_t i = 0; i < events.size(); ++i) {\n";
+    s << "            if (i) doc += ',';\n";
+    s << "            doc += \"{\\\"args\\\":\";\n";
+    s << "            doc += events[i].second;\n";
+    s << "            doc += \",\\\"name\\\":\";\n";
+    s << "            doc += nlohmann::json(events[i].first).dump();\n";
+    s << "            doc += '}';\n";
+    s << "        }\n";
+    s << "        doc += ']';\n";
+    s << "        if (g_emitBatch.call([&](LidlEmitBatchCb cb, void* ud) { cb(doc.c_str(), ud); })) {\n";
+    s << "            events.clear();\n";
+    s << "            return;\n";
+    s << "        }\n";
+    s << "    }\n";
+    s << "    for (const auto& e : events)\n";
+    s << "        g_emit.call([&](logos_module_emit_cb cb, void* ud) { cb(e.first.c_str(), e.second.c_str(), ud); });\n";
+    s << "    events.clear();\n";
+    s << "}\n\n";
+
+    // One serialized event, on its way out: held back if this thread has a
+    // batch open, otherwise handed to the host now.
+    s << "static void lidlEmitNow(const std::string& name, std::string dumped)\n{\n";
+    s << "    LidlEventBatch& batch = t_eventBatch;\n";
+    s << "    if (batch.depth > 0) {\n";
+    s << "        batch.events.emplace_back(name, std::move(dumped));\n";
+    s << "        if (batch.events.size() >= kLidlMaxBatchedEvents)\n";
+    s << "            lidlDeliverEvents(batch.events);\n";
+    s << "        return;\n";
+    s << "    }\n";
+    s << "    if (g_emit.call([&](logos_module_emit_cb cb, void* ud) { cb(name.c_str(), dumped.c_str(), ud); }))\n";
+    s << "        return;\n";
+    // A host that only takes batches gets a batch of one.
+    s << "    std::vector<std::pair<std::string, std::string>> one;\n";
+    s << "    one.emplace_back(name, std::move(dumped));\n";
+    s << "    lidlDeliverEvents(one);\n";
+    s << "}\n\n";
+
+    if (moduleCoalescesEvents(module)) {
+        // Delivers every pending coalesced payload. Called by the flusher
+        // thread at most once per kLidlCoalesceInterval, and when a dispatch
+        // returns with something pending. The flush mutex orders flushers
+        // against each other, never emitters: without it, two flushers could
+        // hand the host an event's newer value before its older one, and the
+        // subscriber would be left holding the stale one.
+        s << "static void lidlFlushCoalesced()\n{\n";
+        s << "    std::lock_guard<std::mutex> lock(g_coalesceFlushMutex);\n";
+        s << "    if (!g_coalescePending.exchange(false)) return;\n";
+        s << "    for (LidlCoalesceSlot& slot : g_coalesceSlots) {\n";
+        s << "        std::unique_ptr<std::string> pending(slot.payload.exchange(nullptr));\n";
+        s << "        if (pending) lidlEmitNow(slot.name, std::move(*pending));\n";
+        s << "    }\n";
+        s << "}\n\n";
+
+        // The bounded rate. Started on the first coalesced emit, idle (blocked
+        // on the condition variable, not polling) while nothing is pending.
+        // Woken only when the pending set goes from empty to non-empty, so an
+        // event emitted in a tight loop costs it nothing per emission. Stopped
+        // and joined when the module image is torn down; what is still pending
+        // then is dropped rather than delivered into a host that is unloading
+        // this module, and freed once the thread that could flush it is gone.
+        s << "class LidlCoalesceFlusher {\n";
+        s << "public:\n";
+        s << "    ~LidlCoalesceFlusher()\n    {\n";
+        s << "        {\n";
+        s << "            std::lock_guard<std::mutex> lock(m_mutex);\n";
+        s << "            m_stop = true;\n";
+        s << "        }\n";
+        s << "        m_cv.notify_one();\n";
+        s << "        if (m_thread.joinable()) m_thread.join();\n";
+        s << "        for (LidlCoalesceSlot& slot : g_coalesceSlots) delete slot.payload.exchange(nullptr);\n";
+        s << "    }\n\n";
+        s << "    void wake()\n    {\n";
+        s << "        {\n";
+        s << "            std::lock_guard<std::mutex> lock(m_mutex);\n";
+        s << "            if (m_stop) return;\n";
+        s << "            m_woken = true;\n";
+        s << "            if (!m_thread.joinable()) m_thread = std::thread([this] { run(); });\n";
+        s << "        }\n";
+        s << "        m_cv.notify_one();\n";
+        s << "    }\n\n";
+        s << "private:\n";
+        s << "    void run()\n    {\n";
+        s << "        std::unique_lock<std::mutex> lock(m_mutex);\n";
+        s << "        while (!m_stop) {\n";
+        s << "            m_cv.wait(lock, [this] { return m_stop || m_woken; });\n";
+        s << "            if (m_stop) break;\n";
+        s << "            m_woken = false;\n";
+        s << "            m_cv.wait_for(lock, kLidlCoalesceInterval, [this] { return m_stop; });\n";
+        s << "            if (m_stop) break;\n";
+        s << "            lock.unlock();\n";
+        s << "            lidlFlushCoalesced();\n";
+        s << "            lock.lock();\n";
+        s << "        }\n";
+        s << "    }\n\n";
+        s << "    std::mutex m_mutex;\n";
+        s << "    std::condition_variable m_cv;\n";
+        s << "    bool m_stop = false;\n";
+        s << "    bool m_woken = false;\n";
+        s << "    std::thread m_thread;\n";
+        s << "};\n";
+        // Defined after the callback slots, so it is destroyed — and its
+        // thread joined — before they are.
+        s << "static LidlCoalesceFlusher g_coalesceFlusher;\n\n";
+    }
+
     s << "static void lidlEnsureEmitWiring()\n{\n";
     s << "    static std::once_flag once;\n";
     s << "    std::call_once(once, []() {\n";
@@ -710,11 +1457,33 @@ QString lidlMakeModuleImplExports(const ModuleDecl& module,
     s << "            [](const std::string& name, void* args) {\n";
     s << "                // cdylib events sidecar marshals into nlohmann::json\n";
     s << "                const nlohmann::json* payload = static_cast<const nlohmann::json*>(args);\n";
-    s << "                std::lock_guard<std::mutex> lock(g_emitMutex);\n";
-    s << "                if (g_emitCb) {\n";
-    s << "                    const std::string dumped = payload ? payload->dump() : \"[]\";\n";
-    s << "                    g_emitCb(name.c_str(), dumped.c_str(), g_emitUd);\n";
-    s << "                }\n";
+    // Nobody listening: skip the dump, as the locked version did.
+    s << "                if (!g_emit.armed() && !g_emitBatch.armed()) return;\n";
+    s << "                lidlEmitNow(name, payload ? payload->dump() : \"[]\");\n";
+    s << "            });\n";
+    if (moduleCoalescesEvents(module)) {
+        s << "        _logos_codegen_::maybeSetCoalesceEvent(lidlImpl(),\n";
+        s << "            [](const std::string& name, void* args) {\n";
+        s << "                const nlohmann::json* payload = static_cast<const nlohmann::json*>(args);\n";
+        s << "                if (!g_emit.armed() && !g_emitBatch.armed()) return;\n";
+        s << "                std::string dumped = payload ? payload->dump() : \"[]\";\n";
+        s << "                for (LidlCoalesceSlot& slot : g_coalesceSlots) {\n";
+        s << "                    if (name != slot.name) continue;\n";
+        // The payload lands BEFORE the pending flag, so a flusher that sees
+        // the flag finds the value.
+        s << "                    delete slot.payload.exchange(new std::string(std::move(dumped)));\n";
+        s << "                    if (!g_coalescePending.exchange(true)) g_coalesceFlusher.wake();\n";
+        s << "                    return;\n";
+        s << "                }\n";
+        s << "                lidlEmitNow(name, std::move(dumped));\n";
+        s << "            });\n";
+    }
+    s << "        _logos_codegen_::maybeSetEventBatching(lidlImpl(),\n";
+    s << "            []() { ++t_eventBatch.depth; },\n";
+    s << "            []() {\n";
+    s << "                LidlEventBatch& batch = t_eventBatch;\n";
+    s << "                if (batch.depth > 0 && --batch.depth == 0)\n";
+    s << "                    lidlDeliverEvents(batch.events);\n";
     s << "            });\n";
     s << "    });\n}\n\n";
 
@@ -739,45 +1508,143 @@ QString lidlMakeModuleImplExports(const ModuleDecl& module,
     // callback delivered) — at module load, before publication. Hosts that
     // never wire an emit callback still get the hook before first dispatch
     // (requireEmit = false fallback).
-    s << "static void lidlTryFireContext(bool requireEmit)\n{\n";
-    s << "    lidlEnsureEmitWiring();\n";
-    s << "    lidlEnsureModulesWired();\n";
-    s << "    if (g_hookFired.load(std::memory_order_acquire)) return;\n";
+    //
+    // Split in two because every dispatch runs it. Once the hook has fired,
+    // which for a loaded module is before its first call, the latch is ONE
+    // acquire load and nothing else. Everything that happens at most once —
+    // the two call_once wirings, g_ctxMutex, the emit check — lives in the cold
+    // half. Under `concurrency: "multi"` the call_once flags and the mutex were
+    // cache lines every worker thread wrote or locked on every call. A module
+    // whose host never delivers a context still stops short of the mutex:
+    // g_wired and g_ctxStored answer it with two more loads.
+    //
+    // The hook fires through an exchange, so two first dispatches racing here
+    // fire it once between them rather than once each.
+    s << "static void lidlTryFireContextCold(bool requireEmit)\n{\n";
+    s << "    if (!g_wired.load(std::memory_order_acquire)) {\n";
+    s << "        lidlEnsureEmitWiring();\n";
+    s << "        lidlEnsureModulesWired();\n";
+    s << "        g_wired.store(true, std::memory_order_release);\n";
+    s << "    }\n";
+    s << "    if (!g_ctxStored.load(std::memory_order_acquire)) return;\n";
     s << "    std::string path, id, persist;\n";
     s << "    {\n";
     s << "        std::lock_guard<std::mutex> lock(g_ctxMutex);\n";
-    s << "        if (!g_ctxStored) return;\n";
     s << "        path = g_ctxPath; id = g_ctxId; persist = g_ctxPersist;\n";
     s << "    }\n";
-    s << "    if (requireEmit) {\n";
-    s << "        std::lock_guard<std::mutex> lock(g_emitMutex);\n";
-    s << "        if (!g_emitCb) return;\n";
-    s << "    }\n";
-    s << "    g_hookFired.store(true, std::memory_order_release);\n";
-    // modules() was already wired by lidlEnsureModulesWired() above (before this
-    // context-gated early return), so onContextReady can safely call
-    // modules().<dep>... / subscribe to dependency events from the hook.
+    s << "    if (requireEmit && !g_emit.armed() && !g_emitBatch.armed()) return;\n";
+    s << "    if (g_hookFired.exchange(true, std::memory_order_acq_rel)) return;\n";
+    // modules() was already wired above (before this context-gated early
+    // return), so onContextReady can safely call modules().<dep>... /
+    // subscribe to dependency events from the hook.
     // The module's own registry name, which the generator knows statically.
     // Set BEFORE the context so moduleName() is live inside onContextReady().
     s << "    _logos_codegen_::maybeSetModuleName(lidlImpl(), \"" << module.name << "\");\n";
     s << "    _logos_codegen_::maybeSetContext(lidlImpl(), path, id, persist);\n";
     s << "}\n\n";
+    s << "static inline void lidlTryFireContext(bool requireEmit)\n{\n";
+    s << "    if (g_hookFired.load(std::memory_order_acquire)) return;\n";
+    s << "    lidlTryFireContextCold(requireEmit);\n";
+    s << "}\n\n";
 
-    // -- exports -------------------------------------------------------------
-    s << "extern \"C\" {\n\n";
-
-    s << "char* logos_module_dispatch(const char* method, const char* args_json)\n{\n";
-    s << "    if (!method) return nullptr;\n";
-    s << "    lidlTryFireContext(false);\n";
-    s << "    nlohmann::json args = nlohmann::json::array();\n";
-    s << "    if (args_json && *args_json) {\n";
-    s << "        args = nlohmann::json::parse(args_json, nullptr, false);\n";
-    s << "        if (args.is_discarded() || !args.is_array()) return nullptr;\n";
-    s << "    }\n";
-    s << "    const std::string m(method);\n";
+    // -- the method bodies, by contract position ------------------------------
+    // Shared by the by-name and the by-id entry points, so the two cannot
+    // disagree about what a method does. The id IS the contract position
+    // lidlMethodIndex() answers; anything outside the table answers NULL,
+    // exactly like an unknown name.
+    s << "static char* lidlDispatchIndex(int index, const char* args_json,\n";
+    s << "                               [[maybe_unused]] const LidlCompletion* done)\n{\n";
+    // Checked BEFORE the arguments are parsed: an unknown method answers NULL
+    // either way, and it should not pay for a parse to find that out.
+    s << "    if (index < 0 || index >= " << static_cast<int>(module.methods.size())
+      << ") return nullptr;  // unknown method\n";
     s << "    try {\n";
 
-    for (const MethodDecl& md : module.methods) {
+    // The call and its reply, shared by the fast path and the DOM path below:
+    // `argExprs` are the already-decoded arguments, so the two paths differ
+    // only in how they got them.
+    auto emitInvoke = [&](const MethodDecl& md, const QStringList& argExprs,
+                          const QString& indent) {
+        QString call = "lidlImpl()." + qs(md.name) + "(";
+        for (int i = 0; i < argExprs.size(); ++i) {
+            call += argExprs[i];
+            if (i + 1 < argExprs.size()) call += ", ";
+        }
+        call += ")";
+        // `void` parses as a Named type "void" from a .lidl (it isn't a
+        // lidlBuiltinType); empty name is the header path's in-memory void.
+        const bool voidReturn =
+            md.returnType.name == "void"
+            || (md.returnType.kind == TypeExpr::Primitive && md.returnType.name.empty())
+            || lidlTypeToQt(md.returnType) == "void";
+        // Through lidlReply(), which knows whether the impl returned the value
+        // or a logos::Deferred of it; the contract type is the same either way.
+        s << indent << "return lidlReply(done, [&] { return " << call << "; },\n";
+        if (voidReturn) {
+            s << indent << "                 nullptr);\n";
+        } else {
+            // Written straight into the buffer the C ABI hands back
+            // (logos_reply_buffer.h): one allocation for the reply, and no
+            // DOM for a typed one.
+            s << indent << "                 [](const auto& result) { "
+              << replyEncodeBody(md, "result", recs) << " });\n";
+        }
+    };
+
+    // -- the scalar fast path -------------------------------------------------
+    // A method whose parameters are all LIDL scalars reads them in place with
+    // logos::ScalarArgs (logos_scalar_args.h), without building the DOM. It is
+    // a first attempt only: the reader declines anything the DOM path would
+    // not decode to the same value — wrong arity, a type the codec refuses,
+    // malformed JSON — and the call falls through to the DOM path below, which
+    // produces the reply it always did. So the fast path changes what a call
+    // COSTS and never what it ANSWERS.
+    std::set<std::string> dispatched;
+    bool anyFast = false;
+    for (size_t index = 0; index < module.methods.size(); ++index) {
+        const MethodDecl& md = module.methods[index];
+        if (!dispatched.insert(md.name).second) continue;
+        if (!scalarOnly(md)) continue;
+        if (!anyFast) {
+            s << "        switch (index) {\n";
+            anyFast = true;
+        }
+        s << "        case " << static_cast<int>(index) << ": {  // " << md.name << "\n";
+        s << "            logos::ScalarArgs in(args_json);\n";
+        QStringList reads, argExprs;
+        for (size_t i = 0; i < md.params.size(); ++i) {
+            const QString var = QString("arg%1").arg(i);
+            s << "            " << lidlTypeToStdCdylib(md.params[i].type, recs) << " " << var << "{};\n";
+            reads << "in.read(" + var + ")";
+            // A tstr is decoded into a local, so hand it over rather than copy
+            // it again; this binds to a by-value or a const& parameter alike.
+            argExprs << (md.params[i].type.name == "tstr" ? "std::move(" + var + ")" : var);
+        }
+        reads << "in.atEnd()";
+        s << "            if (" << reads.join(" && ") << ") {\n";
+        emitInvoke(md, argExprs, "                ");
+        s << "            }\n";
+        s << "            break;\n";
+        s << "        }\n";
+    }
+    if (anyFast) {
+        s << "        default:\n";
+        s << "            break;\n";
+        s << "        }\n\n";
+    }
+
+    s << "        nlohmann::json args = nlohmann::json::array();\n";
+    s << "        if (args_json && *args_json) {\n";
+    s << "            args = nlohmann::json::parse(args_json, nullptr, false);\n";
+    s << "            if (args.is_discarded() || !args.is_array()) return nullptr;\n";
+    s << "        }\n";
+    s << "        switch (index) {\n";
+
+    dispatched.clear();
+    for (size_t index = 0; index < module.methods.size(); ++index) {
+        const MethodDecl& md = module.methods[index];
+        // lidlMethodIndex never answers a duplicate's second position.
+        if (!dispatched.insert(md.name).second) continue;
         // The arity gate, and the one place the LIBERAL half of the decode rule
         // reaches a POSITIONAL slot.
         //
@@ -793,7 +1660,7 @@ QString lidlMakeModuleImplExports(const ModuleDecl& module,
         size_t minArgs = 0;
         for (size_t i = 0; i < md.params.size(); ++i)
             if (!paramIsOptional(md.params[i])) minArgs = i + 1;
-        s << "        if (m == \"" << md.name << "\") {\n";
+        s << "        case " << static_cast<int>(index) << ": {  // " << md.name << "\n";
         // A wrong argument COUNT is reported, not swallowed.
         //
         // This used to be `return nullptr`, and the Qt glue turns a NULL reply
@@ -829,47 +1696,115 @@ QString lidlMakeModuleImplExports(const ModuleDecl& module,
                 ? qs(module.name)
                 : (module.version.empty() ? QStringLiteral("1.0.0") : qs(module.version));
             s << "            auto result = std::string(\"" << literal << "\");\n";
-            s << "            return lidlStrdup(" << stdReturnToJson(md, "result", recs)
-              << ".dump());\n";
+            s << "            " << replyEncodeBody(md, "result", recs) << "\n";
             s << "        }\n";
             continue;
         }
-        QString call = "lidlImpl()." + qs(md.name) + "(";
+        QStringList argExprs;
         for (size_t i = 0; i < md.params.size(); ++i) {
             const QString expr = (i < minArgs)
                 ? QString("args.at(%1)").arg(i)
                 : QString("(args.size() > %1 ? args.at(%1) : nlohmann::json())").arg(i);
-            call += jsonArgToStd(md.params[i].type, expr,
-                                 QString("arg%1").arg(i), recs);
-            if (i + 1 < md.params.size()) call += ", ";
-        }
-        call += ")";
-        // `void` parses as a Named type "void" from a .lidl (it isn't a
-        // lidlBuiltinType); empty name is the header path's in-memory void.
-        const bool voidReturn =
-            md.returnType.name == "void"
-            || (md.returnType.kind == TypeExpr::Primitive && md.returnType.name.empty())
-            || lidlTypeToQt(md.returnType) == "void";
-        if (voidReturn) {
-            s << "            " << call << ";\n";
-            s << "            return lidlStrdup(\"true\");\n";
-        } else {
-            s << "            auto result = " << call << ";\n";
-            s << "            return lidlStrdup(" << stdReturnToJson(md, "result", recs) << ".dump());\n";
+            argExprs << jsonArgToStd(md.params[i].type, expr,
+                                     QString("arg%1").arg(i), recs);
         }
+        emitInvoke(md, argExprs, "            ");
         s << "        }\n";
     }
 
+    s << "        }\n";
+    // A Deferred the synchronous path waited on and the impl rejected: its own
+    // code, not dispatch_failed.
+    s << "    } catch (const logos::DeferredRejected& e) {\n";
+    s << "        return lidlRejectedReply(e);\n";
     s << "    } catch (const std::exception& e) {\n";
     s << "        nlohmann::json err{{\"code\", \"dispatch_failed\"}, {\"message\", e.what()},\n";
     s << "                           {\"origin\", \"" << module.name << "\"}};\n";
     s << "        return lidlStrdup(err.dump());\n";
     s << "    }\n";
+    // Reached only by the by-id path naming a duplicate's second position,
+    // which lidlMethodIndex never hands out.
     s << "    return nullptr;  // unknown method\n";
     s << "}\n\n";
 
+    // -- exports -------------------------------------------------------------
+    s << "extern \"C\" {\n\n";
+
+    s << "char* logos_module_dispatch(const char* method, const char* args_json)\n{\n";
+    s << "    if (!method) return nullptr;\n";
+    s << "    lidlTryFireContext(false);\n";
+    if (moduleCoalescesEvents(module)) {
+        // What a method left pending goes out as it returns, so a subscriber
+        // has the final state of a call without waiting for the flusher.
+        s << "    char* reply = lidlDispatchIndex(lidlMethodIndex(method), args_json, nullptr);\n";
+        s << "    if (g_coalescePending.load(std::memory_order_relaxed)) lidlFlushCoalesced();\n";
+        s << "    return reply;\n";
+    } else {
+        s << "    return lidlDispatchIndex(lidlMethodIndex(method), args_json, nullptr);\n";
+    }
+    s << "}\n\n";
+
+    // RESOLVE ONCE, CALL BY ID. A chatty caller sends the same few names
+    // thousands of times, and every one of them is looked up again; with the
+    // id it does the lookup once and the per-call path carries an int.
+    //
+    // The id is the method's position in the CONTRACT, so it is stable for
+    // exactly as long as the contract is: a caller that caches ids must
+    // re-resolve when the module it talks to is reloaded, because a rebuilt
+    // module may have reordered its methods. -1 is "no such method", and a
+    // by-id call with an id this table does not hold answers NULL, the same
+    // reply an unknown name gets.
+    //
+    // Guarded on the protocol MINOR that declares the pair (0.7) and written
+    // MAJOR-aware, like every other guard in this file. An older protocol has
+    // no declaration for either, and a host built against it would never look
+    // them up, so the module simply omits them.
+    s << "#if defined(LOGOS_PROTOCOL_VERSION_MINOR) && "
+         "(LOGOS_PROTOCOL_VERSION_MAJOR > 0 || "
+         "(LOGOS_PROTOCOL_VERSION_MAJOR == 0 && "
+         "LOGOS_PROTOCOL_VERSION_MINOR >= 7))\n";
+    s << "int32_t logos_module_resolve_method(const char* method)\n{\n";
+    s << "    if (!method) return -1;\n";
+    s << "    return lidlMethodIndex(method);\n";
+    s << "}\n\n";
+    s << "char* logos_module_dispatch_by_id(int32_t method_id, const char* args_json)\n{\n";
+    s << "    lidlTryFireContext(false);\n";
+    if (moduleCoalescesEvents(module)) {
+        s << "    char* reply = lidlDispatchIndex(method_id, args_json, nullptr);\n";
+        s << "    if (g_coalescePending.load(std::memory_order_relaxed)) lidlFlushCoalesced();\n";
+        s << "    return reply;\n";
+    } else {
+        s << "    return lidlDispatchIndex(method_id, args_json, nullptr);\n";
+    }
+    s << "}\n\n";
+
+    // DISPATCH WITHOUT A PARKED THREAD. The same method bodies, but the reply
+    // goes to `completion_cb` instead of the return value, so a method that
+    // returns logos::Deferred<T> lets this call return at once and completes
+    // on whichever thread settles it. Every other reply (an ordinary method,
+    // an argument error, an unknown method's NULL) completes inline, before
+    // this returns. The reply is borrowed for the duration of the callback and
+    // freed by the module afterwards, like an emitted event's payload.
+    //
+    // Same 0.7 guard as the by-id pair it was added alongside.
+    s << "void logos_module_dispatch_async(const char* method, const char* args_json,\n";
+    s << "                                 LidlCompleteCb completion_cb, void* user_data)\n{\n";
+    s << "    if (!completion_cb) return;\n";
+    s << "    lidlTryFireContext(false);\n";
+    s << "    const LidlCompletion done{completion_cb, user_data};\n";
+    s << "    char* reply = method\n";
+    s << "        ? lidlDispatchIndex(lidlMethodIndex(method), args_json, &done)\n";
+    s << "        : nullptr;\n";
+    if (moduleCoalescesEvents(module))
+        s << "    if (g_coalescePending.load(std::memory_order_relaxed)) lidlFlushCoalesced();\n";
+    s << "    if (reply != lidlPendingReply()) lidlComplete(done, reply);\n";
+    s << "}\n";
+    s << "#endif\n\n";
+
     s << "char* logos_module_get_methods(void)\n{\n";
-    s << "    return lidlStrdup(lidlInterfaceJson().dump());\n}\n\n";
+    s << "    char* out = static_cast<char*>(std::malloc(sizeof lidlInterfaceDocument));\n";
+    s << "    if (out) std::memcpy(out, lidlInterfaceDocument, sizeof lidlInterfaceDocument);\n";
+    s << "    return out;\n}\n\n";
 
     s << "void logos_module_set_context(const char* module_path,\n";
     s << "                              const char* instance_id,\n";
@@ -879,20 +1814,32 @@ QString lidlMakeModuleImplExports(const ModuleDecl& module,
     s << "        g_ctxPath = module_path ? module_path : \"\";\n";
     s << "        g_ctxId = instance_id ? instance_id : \"\";\n";
     s << "        g_ctxPersist = instance_persistence_path ? instance_persistence_path : \"\";\n";
-    s << "        g_ctxStored = true;\n";
+    s << "        g_ctxStored.store(true, std::memory_order_release);\n";
     s << "    }\n";
     s << "    lidlTryFireContext(true);\n";
     s << "}\n\n";
 
     s << "void logos_module_set_emit_callback(logos_module_emit_cb cb, void* user_data)\n{\n";
-    s << "    {\n";
-    s << "        std::lock_guard<std::mutex> lock(g_emitMutex);\n";
-    s << "        g_emitCb = cb;\n";
-    s << "        g_emitUd = user_data;\n";
-    s << "    }\n";
+    s << "    g_emit.set(cb, user_data);\n";
     s << "    lidlTryFireContext(true);\n";
     s << "}\n\n";
 
+    // The batch counterpart: a host that sets it receives every batchEvents()
+    // flush as ONE call carrying a JSON array (see lidlDeliverEvents), instead
+    // of one logos_module_emit_cb crossing per event. Optional — a host that
+    // never sets it keeps getting events one by one. Guarded on 0.7 like the
+    // by-id pair, and for the same reason.
+    s << "#if defined(LOGOS_PROTOCOL_VERSION_MINOR) && "
+         "(LOGOS_PROTOCOL_VERSION_MAJOR > 0 || "
+         "(LOGOS_PROTOCOL_VERSION_MAJOR == 0 && "
+         "LOGOS_PROTOCOL_VERSION_MINOR >= 7))\n";
+    s << "void logos_module_set_emit_batch_callback(void (*cb)(const char* events_json, void* user_data),\n";
+    s << "                                          void* user_data)\n{\n";
+    s << "    g_emitBatch.set(cb, user_data);\n";
+    s << "    lidlTryFireContext(true);\n";
+    s << "}\n";
+    s << "#endif\n\n";
+
     s << "int logos_module_accept_token(const char* module_name, const char* token)\n{\n";
     s << "    if (!module_name || !token) return -1;\n";
     s << "    // Seed the protocol's shared TokenManager so this module's OUTBOUND\n";
@@ -1101,7 +2048,10 @@ QString lidlMakeEventsSourceCdylib(const ModuleDecl& module,
             else
                 s << "    args.push_back(" << pd.name << ");\n";
         }
-        s << "    emitEventImpl_(\"" << ed.name << "\", &args);\n";
+        if (eventCoalesces(ed))
+            s << "    coalesceEventImpl_(\"" << ed.name << "\", &args);\n";
+        else
+            s << "    emitEventImpl_(\"" << ed.name << "\", &args);\n";
         s << "}\n\n";
     }
     return c;
@@ -363,6 +363,8 @@ static QString recordCppType(const RecordSet& rs, const QString& t, ApiStyle sty
 // wire type (QVariant / nlohmann::json) the conversion is written in.
 static QString recToWireFn(const QString& record)   { return "recToWire_" + record; }
 static QString recFromWireFn(const QString& record) { return "recFromWire_" + record; }
+static QString recWriteFn(const QString& record)    { return "recWrite_" + record; }
+static QString recReadFn(const QString& record)     { return "recRead_" + record; }
 
 // Record value -> wire value, and back. Empty when `t` names no record.
 static QString recordToWireExpr(const RecordSet& rs, const QString& t, ApiStyle style, const QString& expr)
@@ -676,6 +678,216 @@ static void emitRecordConversions(QTextStream& s, const RecordSet& rs, ApiStyle
     }
 }
 
+// ─── Lp arguments, written as text ───────────────────────────────────────
+//
+// An Lp call's arguments go straight into a logos::ArgsWriter, never through
+// an nlohmann::json array that LpClient would then dump: for a large `bstr`
+// or `[Record]` argument, that DOM cost as much again as the text itself.
+// The text is the one the array would have dumped to, except that a record's
+// keys come out in declaration order rather than sorted — the same object to
+// any JSON reader.
+
+// The statement writing `expr` (of contract type `qtType`) to writer `w`.
+static QString lpWriteStmt(const QString& qtType, const RecordSet& rs, const QString& w,
+                           const QString& expr)
+{
+    QString elem;
+    switch (recordShape(rs, qtType, &elem)) {
+    case RecordShape::Scalar:
+        return recWriteFn(elem) + "(" + w + ", " + expr + ");";
+    case RecordShape::List:
+        return w + ".beginArray(); for (const auto& __e : " + expr + ") " + recWriteFn(elem)
+             + "(" + w + ", __e); " + w + ".endArray();";
+    case RecordShape::Map:
+        return w + ".beginObject(); for (const auto& __kv : " + expr + ") { " + w
+             + ".key(__kv.first); " + recWriteFn(elem) + "(" + w + ", __kv.second); } " + w
+             + ".endObject();";
+    case RecordShape::None:
+        break;
+    }
+    if (mapParamTypeStd(qtType) == "std::vector<uint8_t>")
+        return w + ".bytes(" + expr + ");";
+    return w + ".value(" + lpPushExpr(qtType, expr) + ");";
+}
+
+// `pending` and every record reachable from them through record fields.
+static QSet<QString> recordClosure(QStringList pending, const RecordSet& rs)
+{
+    QSet<QString> seen;
+    while (!pending.isEmpty()) {
+        const QString name = pending.takeLast();
+        if (seen.contains(name)) continue;
+        seen.insert(name);
+        for (const RecordDef& d : rs) {
+            if (d.name != name) continue;
+            for (const RecordField& f : d.fields) {
+                QString elem;
+                if (recordShape(rs, f.type, &elem) != RecordShape::None) pending << elem;
+            }
+        }
+    }
+    return seen;
+}
+
+// The records an invokable method's arguments can carry, directly or through
+// another record's field. Only these get a writer: any other would be an
+// unused static.
+static QSet<QString> lpWrittenRecords(const QJsonArray& methods, const RecordSet& rs)
+{
+    QStringList pending;
+    for (const QJsonValue& v : methods) {
+        const QJsonObject o = v.toObject();
+        if (!o.value("isInvokable").toBool()) continue;
+        for (const QJsonValue& pv : o.value("parameters").toArray()) {
+            QString elem;
+            if (recordShape(rs, pv.toObject().value("type").toString(), &elem) != RecordShape::None)
+                pending << elem;
+        }
+    }
+    return recordClosure(pending, rs);
+}
+
+// `static void recWrite_X(logos::ArgsWriter& w, const Class::X& v)` per
+// record in `written`: recToWire_X's encoding, straight to text. An empty
+// optional omits its key, exactly as there.
+static void emitRecordWriters(QTextStream& s, const RecordSet& rs, const QSet<QString>& written,
+                              const QString& className)
+{
+    if (written.isEmpty()) return;
+    const QString qual = className + "::";
+    for (const RecordDef& d : rs)
+        if (written.contains(d.name))
+            s << "static void " << recWriteFn(d.name) << "(logos::ArgsWriter& w, const "
+              << qual << d.name << "& v);\n";
+    s << "\n";
+    for (const RecordDef& d : rs) {
+        if (!written.contains(d.name)) continue;
+        s << "static void " << recWriteFn(d.name) << "(logos::ArgsWriter& w, const "
+          << qual << d.name << "& v) {\n";
+        s << "    w.beginObject();\n";
+        for (const RecordField& f : d.fields) {
+            if (fieldIsWrappedOptional(f, ApiStyle::Lp, rs)) {
+                s << "    if (v." << f.name << ".has_value()) { w.key(\"" << f.name << "\"); "
+                  << lpWriteStmt(f.type, rs, "w", "(*v." + f.name + ")") << " }\n";
+                continue;
+            }
+            s << "    w.key(\"" << f.name << "\"); " << lpWriteStmt(f.type, rs, "w", "v." + f.name) << "\n";
+        }
+        s << "    w.endObject();\n";
+        s << "}\n\n";
+    }
+}
+
+// ─── Lp replies, read from text ──────────────────────────────────────────
+//
+// The blocking wrapper's reply stays text (logos::LpReply) and is read
+// straight into the return type: a std::string, a list of strings or of
+// records never passes through an nlohmann::json tree first. Each read below
+// yields what fromWireFor's decode of the parsed reply would have, mismatch
+// defaults included; a shape that is json anyway (LogosMap, LogosList, `any`,
+// LogosResult) is still decoded from LpReply::json().
+
+// Std types logos::readLenient reads.
+static bool lpReadsLeniently(const QString& qtType)
+{
+    if (mapReturnType(qtType) == "QVariant") return false;  // `any`: raw json
+    const QString t = mapReturnTypeStd(qtType);
+    return t == "std::string" || t == "int64_t" || t == "uint64_t" || t == "double"
+        || t == "bool" || t == "std::vector<std::string>" || t == "std::vector<uint8_t>";
+}
+
+// The statement reading one value of contract type `qtType` from reader `r`
+// into `lvalue`, which it always assigns.
+static QString lpReadStmt(const QString& qtType, const RecordSet& rs, const QString& r,
+                          const QString& lvalue)
+{
+    const QString kind = "logos::JsonReader::Kind::";
+    QString elem;
+    switch (recordShape(rs, qtType, &elem)) {
+    case RecordShape::Scalar:
+        return lvalue + " = {}; " + recReadFn(elem) + "(" + r + ", " + lvalue + ");";
+    case RecordShape::List:
+        return lvalue + ".clear(); if (" + r + ".peek() == " + kind + "Array) { " + r
+             + ".beginArray(); while (" + r + ".nextElement()) { " + lvalue + ".emplace_back(); "
+             + recReadFn(elem) + "(" + r + ", " + lvalue + ".back()); } } else { " + r + ".skip(); }";
+    case RecordShape::Map:
+        return lvalue + ".clear(); if (" + r + ".peek() == " + kind + "Object) { " + r
+             + ".beginObject(); std::string __mk; while (" + r + ".nextKey(__mk)) { auto& __v = "
+             + lvalue + "[__mk]; __v = {}; " + recReadFn(elem) + "(" + r + ", __v); } } else { "
+             + r + ".skip(); }";
+    case RecordShape::None:
+        break;
+    }
+    if (lpReadsLeniently(qtType)) return "logos::readLenient(" + r + ", " + lvalue + ");";
+    return "{ nlohmann::json __j; " + r + ".readJson(__j); " + lvalue + " = "
+         + lpFromJsonExpr(qtType, "__j") + "; }";
+}
+
+// The records a blocking method's return can carry. Only these get a reader.
+static QSet<QString> lpReadRecords(const QJsonArray& methods, const RecordSet& rs)
+{
+    QStringList pending;
+    for (const QJsonValue& v : methods) {
+        const QJsonObject o = v.toObject();
+        if (!o.value("isInvokable").toBool()) continue;
+        QString elem;
+        if (recordShape(rs, o.value("returnType").toString(), &elem) != RecordShape::None)
+            pending << elem;
+    }
+    return recordClosure(pending, rs);
+}
+
+// `static void recRead_X(logos::JsonReader& r, Class::X& out)` per record in
+// `read`: recFromWire_X's decode, off the text. A repeated key is decided by
+// its last value, as the json parser decides it, so an optional read as null
+// is reset rather than left alone.
+static void emitRecordReaders(QTextStream& s, const RecordSet& rs, const QSet<QString>& read,
+                              const QString& className)
+{
+    if (read.isEmpty()) return;
+    const QString qual = className + "::";
+    for (const RecordDef& d : rs)
+        if (read.contains(d.name))
+            s << "static void " << recReadFn(d.name) << "(logos::JsonReader& r, "
+              << qual << d.name << "& out);\n";
+    s << "\n";
+    for (const RecordDef& d : rs) {
+        if (!read.contains(d.name)) continue;
+        s << "static void " << recReadFn(d.name) << "(logos::JsonReader& r, "
+          << qual << d.name << "& out) {\n";
+        s << "    if (r.peek() != logos::JsonReader::Kind::Object) { r.skip(); return; }\n";
+        s << "    r.beginObject();\n";
+        s << "    std::string __key;\n";
+        s << "    while (r.nextKey(__key)) {\n";
+        QString branch = "if";
+        for (const RecordField& f : d.fields) {
+            s << "        " << branch << " (__key == \"" << f.name << "\") ";
+            if (fieldIsWrappedOptional(f, ApiStyle::Lp, rs))
+                s << "{ if (r.peek() == logos::JsonReader::Kind::Null) { r.skip(); out." << f.name
+                  << ".reset(); } else { out." << f.name << ".emplace(); "
+                  << lpReadStmt(f.type, rs, "r", "(*out." + f.name + ")") << " } }\n";
+            else
+                s << "{ " << lpReadStmt(f.type, rs, "r", "out." + f.name) << " }\n";
+            branch = "else if";
+        }
+        if (d.fields.isEmpty()) s << "        r.skip();\n";
+        else                    s << "        else r.skip();\n";
+        s << "    }\n";
+        s << "}\n\n";
+    }
+}
+
+// The blocking wrapper's return value, from reply `reply`.
+static QString lpReplyReturnExpr(const QString& qtRet, const RecordSet& rs, const QString& reply,
+                                 const QString& retQual)
+{
+    if (recordShape(rs, qtRet, nullptr) != RecordShape::None)
+        return reply + ".read<" + retQual + ">([](logos::JsonReader& r, " + retQual + "& out) { "
+             + lpReadStmt(qtRet, rs, "r", "out") + " })";
+    if (lpReadsLeniently(qtRet)) return reply + ".as<" + mapReturnTypeStd(qtRet) + ">()";
+    return lpFromJsonExpr(qtRet, reply + ".json()");
+}
+
 QString makeHeader(const QString& moduleName, const QString& className, const QJsonArray& methods, ApiStyle apiStyle, const QJsonArray& events, BindMode bindMode, const QJsonArray& records)
 {
     if (apiStyle == ApiStyle::Lp)
@@ -1441,6 +1653,87 @@ static QString lpEventAccessorName(const QString& evName)
     return QString("on") + cap;
 }
 
+// The typed batch builder (`<Class>::Batch`, reached through `batch()`) is
+// emitted only when the contract leaves room for it. Its names live in the
+// same scopes as the contract's: a method called `batch` would collide with
+// the accessor, a record called `Batch` with the class, and a method called
+// `send` or `size` with the builder's own members. Such a wrapper simply has
+// no builder; LpClient::invokeBatch is still there underneath.
+static bool lpBatchBuilderFits(const QJsonArray& methods, const RecordSet& rs)
+{
+    bool anyInvokable = false;
+    for (const QJsonValue& v : methods) {
+        const QJsonObject o = v.toObject();
+        if (!o.value("isInvokable").toBool()) continue;
+        anyInvokable = true;
+        const QString name = o.value("name").toString();
+        if (name == "batch" || name == "Batch" || name == "send" || name == "size")
+            return false;
+    }
+    for (const RecordDef& r : rs)
+        if (r.name == "Batch") return false;
+    return anyInvokable;
+}
+
+// The result-cache policy moduleMethodsToJson attaches to a method whose doc
+// comment says `@cache <ttl_ms>`. The wrapper only registers it with its
+// LpClient, which does the caching on every single-call path; an untagged
+// contract emits none of this and stays byte-identical.
+static bool lpMethodCached(const QJsonObject& o)
+{
+    return o.value("isInvokable").toBool()
+        && o.value("cache").toObject().value("ttlMs").toInt() > 0;
+}
+
+// One `cacheMethod(...)` statement per cached method and one `singleFlight(...)`
+// per method tagged `@single-flight`, each on its own line.
+static QString lpCallPolicyRegistrations(const QJsonArray& methods, const QString& clientExpr,
+                                         const QString& indent)
+{
+    QString out;
+    for (const QJsonValue& v : methods) {
+        const QJsonObject o = v.toObject();
+        if (o.value("isInvokable").toBool() && o.value("singleFlight").toBool())
+            out += indent + clientExpr + ".singleFlight(\"" + o.value("name").toString() + "\");\n";
+        if (!lpMethodCached(o)) continue;
+        const QJsonObject cache = o.value("cache").toObject();
+        out += indent + clientExpr + ".cacheMethod(\"" + o.value("name").toString() + "\", "
+             + QString::number(cache.value("ttlMs").toInt());
+        const QJsonArray events = cache.value("invalidatedBy").toArray();
+        if (!events.isEmpty()) {
+            QStringList quoted;
+            for (const QJsonValue& ev : events) quoted << QString("\"") + ev.toString() + "\"";
+            out += ", {" + quoted.join(", ") + "}";
+        }
+        out += ");\n";
+    }
+    return out;
+}
+
+// `invalidateCache()` on the wrapper, for a caller that knows the target
+// changed without announcing it. Only where there is a cache to drop, and not
+// when the contract already has a method of that name.
+static bool lpEmitsInvalidateCache(const QJsonArray& methods)
+{
+    bool anyCached = false;
+    for (const QJsonValue& v : methods) {
+        const QJsonObject o = v.toObject();
+        if (o.value("name").toString() == "invalidateCache") return false;
+        anyCached = anyCached || lpMethodCached(o);
+    }
+    return anyCached;
+}
+
+// `limitConcurrency()` on the wrapper, so a caller can cap its calls in
+// flight to the target without reaching for the client. On every wrapper,
+// unless the contract already has a method of that name.
+static bool lpEmitsLimitConcurrency(const QJsonArray& methods)
+{
+    for (const QJsonValue& v : methods)
+        if (v.toObject().value("name").toString() == "limitConcurrency") return false;
+    return true;
+}
+
 QString makeHeaderLp(const QString& moduleName, const QString& className, const QJsonArray& methods, const QJsonArray& events, BindMode bindMode, const QJsonArray& records)
 {
     (void)moduleName;
@@ -1460,6 +1753,7 @@ QString makeHeaderLp(const QString& moduleName, const QString& className, const
     s << "#include \"logos_result.h\"\n";
     s << "#include \"logos_call_error.h\"\n";
     s << "#include \"logos_async_result.h\"\n";
+    s << "#include \"logos_task.h\"\n";
     s << "#include \"logos_lp_client.h\"\n";
     // Record maps are std::map on the Qt-free surface.
     if (!rs.isEmpty()) s << "#include <map>\n";
@@ -1480,20 +1774,27 @@ QString makeHeaderLp(const QString& moduleName, const QString& className, const
         s << "    struct State {\n";
         s << "        logos::LpClient client;\n";
         s << "        std::vector<logos::LpSubscription> subs;\n";
-        s << "        State(const std::string& target, const std::string& origin) : client(target, origin) {}\n";
+        const QString policySetup = lpCallPolicyRegistrations(methods, "client", "            ");
+        s << "        State(const std::string& target, const std::string& origin) : client(target, origin) {";
+        if (policySetup.isEmpty()) s << "}\n";
+        else                      s << "\n" << policySetup << "        }\n";
         s << "    };\n";
         s << "    explicit " << className << "(State* state) : m_state(state) {}\n\n";
     } else {
         s << "    explicit " << className << "(const std::string& origin);\n\n";
     }
 
-    // Typed event subscribers — one per declared event.
+    // Typed event subscribers — one per declared event. `queue` puts a slow
+    // callback behind a bounded queue on a thread of its own (see
+    // logos_event_queue.h), and `executor` runs it on a pool instead; the
+    // defaults call it on the delivering thread.
     for (const QJsonValue& ev : events) {
         const QJsonObject eo = ev.toObject();
         const QString evName = eo.value("name").toString();
         if (evName.isEmpty()) continue;
         s << "    bool " << lpEventAccessorName(evName)
-          << "(std::function<void(" << lpEventCbParams(eo.value("params").toArray(), rs) << ")> callback);\n";
+          << "(std::function<void(" << lpEventCbParams(eo.value("params").toArray(), rs) << ")> callback,\n"
+          << "        const logos::EventQueueOptions& queue = {}, logos::Executor* executor = nullptr);\n";
     }
     if (!events.isEmpty()) s << "\n";
 
@@ -1566,6 +1867,74 @@ QString makeHeaderLp(const QString& moduleName, const QString& className, const
         emitDeclParams();
         s << "std::function<void(logos::AsyncResult<" << ret << ">)> callback, "
           << "int timeout_ms = 0);\n";
+        // The same call under a logos::CancellationToken in place of the
+        // timeout: not issued once the token is cancelled, its callback
+        // released by cancel() while the call is in flight, and what is left
+        // of the token's deadline forwarded as the call's timeout. The one
+        // outcome that breaks "called back exactly once" is said where the
+        // caller reads the declaration.
+        s << "    // Under `token`: not issued if it is already cancelled, and the\n";
+        s << "    // callback is released unrun if it is cancelled in flight. Either\n";
+        s << "    // way `callback` is never called.\n";
+        s << "    void " << name << "AsyncResult(";
+        emitDeclParams();
+        s << "std::function<void(logos::AsyncResult<" << ret << ">)> callback, "
+          << "const logos::CancellationToken& token);\n";
+
+        // The same outcome as `<name>AsyncResult`, for `co_await`. Only a
+        // C++20 translation unit sees it; logos_task.h defines the guard, and
+        // a C++17 module's view of this header is exactly what it was.
+        s << "#if LOGOS_HAS_COROUTINES\n";
+        s << "    logos::Task<logos::AsyncResult<" << ret << ">> " << name << "Co(";
+        emitDeclParams();
+        s << "int timeout_ms = 0);\n";
+        s << "#endif\n";
+    }
+
+    if (lpEmitsInvalidateCache(methods)) {
+        s << "\n    // Forgets the cached answers of `method` (one tagged @cache), or of all.\n";
+        s << "    void invalidateCache(const std::string& method = std::string());\n";
+    }
+    if (lpEmitsLimitConcurrency(methods)) {
+        s << "\n    // Caps this wrapper's calls in flight (see logos::ConcurrencyLimiter).\n";
+        s << "    // Call it before the first call.\n";
+        s << "    void limitConcurrency(const logos::ConcurrencyLimitOptions& options = logos::ConcurrencyLimitOptions());\n";
+    }
+
+    // Typed batch builder over LpClient::invokeBatch. Each method queues a
+    // call with the callback `<name>AsyncResult` would take; send() puts every
+    // queued call on the wire at once, so N calls cost one round trip instead
+    // of N. The builder borrows the wrapper's client and must not outlive it.
+    if (lpBatchBuilderFits(methods, rs)) {
+        s << "\n    class Batch {\n";
+        s << "    public:\n";
+        for (const QJsonValue& v : methods) {
+            const QJsonObject o = v.toObject();
+            if (!o.value("isInvokable").toBool()) continue;
+            const QString ret = returnTypeFor(o.value("returnType").toString(), ApiStyle::Lp, rs);
+            const QJsonArray params = o.value("parameters").toArray();
+            s << "        void " << o.value("name").toString() << "(";
+            for (int i = 0; i < params.size(); ++i) {
+                const QJsonObject p = params.at(i).toObject();
+                const QString qtPt = p.value("type").toString();
+                const QString pt = paramTypeFor(qtPt, ApiStyle::Lp, rs);
+                if (byRefFor(qtPt, pt, ApiStyle::Lp, rs)) s << "const " << pt << "& " << p.value("name").toString();
+                else                                     s << pt << " " << p.value("name").toString();
+                s << ", ";
+            }
+            s << "std::function<void(logos::AsyncResult<" << ret << ">)> callback = nullptr);\n";
+        }
+        s << "        std::size_t size() const { return m_calls.size(); }\n";
+        // `done` fires once every queued call has been answered, after each
+        // call's own callback. The builder is empty again afterwards.
+        s << "        void send(std::function<void()> done = nullptr, int timeout_ms = 0);\n";
+        s << "    private:\n";
+        s << "        friend class " << className << ";\n";
+        s << "        explicit Batch(logos::LpClient& client) : m_client(&client) {}\n";
+        s << "        logos::LpClient* m_client;\n";
+        s << "        std::vector<logos::LpCall> m_calls;\n";
+        s << "    };\n";
+        s << "    Batch batch();\n";
     }
 
     s << "\nprivate:\n";
@@ -1585,7 +1954,9 @@ QString makeSourceLp(const QString& moduleName, const QString& className, const
     QString c;
     QTextStream s(&c);
     s << "#include \"" << headerBaseName << "\"\n";
-    s << "#include <nlohmann/json.hpp>\n\n";
+    s << "#include <nlohmann/json.hpp>\n";
+    if (!events.isEmpty()) s << "#include <tuple>\n";  // event payloads
+    s << "\n";
     // Only reachable from a method body, so a contract with no invokable method
     // must not emit it: an unused function in an anonymous namespace is a
     // -Wunused-function warning, and such a wrapper stays byte-identical to
@@ -1596,6 +1967,8 @@ QString makeSourceLp(const QString& moduleName, const QString& className, const
     }
     if (anyInvokable) emitDispatchRejectionDetectorJson(s);
     emitRecordConversions(s, rs, ApiStyle::Lp, className);
+    emitRecordWriters(s, rs, lpWrittenRecords(methods, rs), className);
+    emitRecordReaders(s, rs, lpReadRecords(methods, rs), className);
 
     // How the wrapper reaches its persistent LpClient + subscription store.
     // Static (concrete dep): owns them by value — the wrapper itself is a
@@ -1607,23 +1980,52 @@ QString makeSourceLp(const QString& moduleName, const QString& className, const
 
     // Constructor: LpClient(target, origin). Static bakes the dep name in the
     // .cpp ctor; Bound's ctor is inline (takes the umbrella-owned State*).
-    if (bindMode != BindMode::Bound)
+    // Methods tagged @cache / @single-flight are registered with the client
+    // here (Bound: in State's inline ctor), before anything can call them.
+    if (bindMode != BindMode::Bound) {
+        const QString policySetup = lpCallPolicyRegistrations(methods, "m_client", "    ");
         s << className << "::" << className << "(const std::string& origin)"
-          << " : m_client(\"" << moduleName << "\", origin) {}\n\n";
+          << " : m_client(\"" << moduleName << "\", origin) {";
+        if (policySetup.isEmpty()) s << "}\n\n";
+        else                      s << "\n" << policySetup << "}\n\n";
+    }
+    if (lpEmitsInvalidateCache(methods)) {
+        s << "void " << className << "::invalidateCache(const std::string& method) {\n";
+        s << "    " << clientExpr << ".invalidateCache(method);\n";
+        s << "}\n\n";
+    }
+    if (lpEmitsLimitConcurrency(methods)) {
+        s << "void " << className << "::limitConcurrency(const logos::ConcurrencyLimitOptions& options) {\n";
+        s << "    " << clientExpr << ".limitConcurrency(options);\n";
+        s << "}\n\n";
+    }
 
-    // Typed event adapters: subscribe via lp_subscribe (JSON array payload),
-    // decode into typed args, keep the RAII subscription alive in m_subs.
+    // Typed event adapters. Each event gets a decoder from its JSON array
+    // payload to a std::tuple of its typed args, and every accessor listener
+    // subscribes through it (LpClient::subscribeDecoded): the client decodes
+    // each arrival ONCE for all of them and hands each the same tuple, which
+    // std::apply spreads over the callback. The RAII subscription is kept
+    // alive in m_subs.
     for (const QJsonValue& ev : events) {
         const QJsonObject eo = ev.toObject();
         const QString evName = eo.value("name").toString();
         if (evName.isEmpty()) continue;
         const QJsonArray evParams = eo.value("params").toArray();
-        s << "bool " << className << "::" << lpEventAccessorName(evName)
-          << "(std::function<void(" << lpEventCbParams(evParams, rs) << ")> callback) {\n";
-        s << "    if (!callback) return false;\n";
-        s << "    auto _sub = " << clientExpr << ".subscribe(\"" << evName << "\", [callback](nlohmann::json _a) {\n";
-        s << "        if (!_a.is_array() || _a.size() < " << evParams.size() << ") return;\n";
-        s << "        callback(";
+        QStringList types, qualifiedTypes;
+        for (const QJsonValue& pv : evParams) {
+            const QString qtPt = pv.toObject().value("type").toString();
+            types << paramTypeFor(qtPt, ApiStyle::Lp, rs);
+            qualifiedTypes << paramTypeFor(qtPt, ApiStyle::Lp, rs, className + "::");
+        }
+        const QString tuple = "std::tuple<" + types.join(", ") + ">";
+        const QString qualifiedTuple = "std::tuple<" + qualifiedTypes.join(", ") + ">";
+        const QString decoder = "lpDecodeEvent_" + evName;
+
+        s << "static bool " << decoder << "(const nlohmann::json& _a, " << qualifiedTuple << "& _e) {\n";
+        s << "    if (!_a.is_array()";
+        if (!evParams.isEmpty()) s << " || _a.size() < " << evParams.size();
+        s << ") return false;\n";
+        s << "    _e = " << qualifiedTuple << "(";
         for (int i = 0; i < evParams.size(); ++i) {
             const QJsonObject p = evParams.at(i).toObject();
             s << fromWireFor(p.value("type").toString(), ApiStyle::Lp, rs,
@@ -1631,13 +2033,45 @@ QString makeSourceLp(const QString& moduleName, const QString& className, const
             if (i + 1 < evParams.size()) s << ", ";
         }
         s << ");\n";
-        s << "    });\n";
+        s << "    return true;\n";
+        s << "}\n\n";
+
+        s << "bool " << className << "::" << lpEventAccessorName(evName)
+          << "(std::function<void(" << lpEventCbParams(evParams, rs) << ")> callback,\n"
+          << "        const logos::EventQueueOptions& queue, logos::Executor* executor) {\n";
+        s << "    if (!callback) return false;\n";
+        s << "    auto _sub = " << clientExpr << ".subscribeDecoded<" << tuple << ">(\"" << evName
+          << "\", &" << decoder << ",\n";
+        s << "        [callback = std::move(callback)](const " << tuple
+          << "& _e) { std::apply(callback, _e); },\n";
+        s << "        queue, executor);\n";
         s << "    if (!_sub.valid()) return false;\n";
         s << "    " << subsExpr << ".push_back(std::move(_sub));\n";
         s << "    return true;\n";
         s << "}\n\n";
     }
 
+    // The (value, error) -> logos::AsyncResult<T> adapter handed to the client
+    // on the result-carrying paths, up to its closing brace.
+    auto emitAsyncResultAdapter = [&](const QJsonObject& o) {
+        const QString qtRet = o.value("returnType").toString();
+        const QString ret = returnTypeFor(qtRet, ApiStyle::Lp, rs);
+        // Moved, not copied, into the adapter: a copy of a std::function
+        // whose target did not fit its small buffer is one more allocation
+        // per call. The adapter itself fits LpClient's pooled slot.
+        s << "        [callback = std::move(callback)](nlohmann::json _r, const logos::CallError& _err) {\n";
+        s << "            logos::AsyncResult<" << ret << "> _res;\n";
+        s << "            _res.error = _err;\n";
+        // Same fold as the sync path, and for the same reason.
+        s << "            if (_res.error.ok()) logosDispatchRejectionJson(_r, _res.error);\n";
+        if (ret != "void")
+            s << "            _res.value = " << fromWireFor(qtRet, ApiStyle::Lp, rs, "_r", className + "::") << ";\n";
+        else
+            s << "            (void)_r;\n";
+        s << "            callback(_res);\n";
+        s << "        }";
+    };
+
     // Methods.
     for (const QJsonValue& v : methods) {
         const QJsonObject o = v.toObject();
@@ -1659,10 +2093,10 @@ QString makeSourceLp(const QString& moduleName, const QString& className, const
             }
         };
         auto emitArgsArray = [&]() {
-            s << "    nlohmann::json _args = nlohmann::json::array();\n";
+            s << "    logos::ArgsWriter _args;\n";
             for (const QJsonValue& pv : params) {
                 const QJsonObject p = pv.toObject();
-                s << "    _args.push_back(" << toWireFor(p.value("type").toString(), ApiStyle::Lp, rs, p.value("name").toString()) << ");\n";
+                s << "    " << lpWriteStmt(p.value("type").toString(), rs, "_args", p.value("name").toString()) << "\n";
             }
         };
 
@@ -1680,7 +2114,7 @@ QString makeSourceLp(const QString& moduleName, const QString& className, const
         // a void method can be rejected too, and the rejection object is the
         // only place that says so.
         s << "    logos::CallError _err;\n";
-        s << "    nlohmann::json _r = " << clientExpr << ".invoke(\"" << name << "\", _args, &_err, timeout_ms);\n";
+        s << "    logos::LpReply _r = " << clientExpr << ".invokeReply(\"" << name << "\", _args, &_err, timeout_ms);\n";
         // A provider that RAN and refused answers the canonical
         // {"code":"dispatch_failed", …} object as its RESULT, not as a
         // transport error, so LpClient::invoke reports ok() and the decode
@@ -1694,10 +2128,13 @@ QString makeSourceLp(const QString& moduleName, const QString& className, const
         // to say so would cost every generated TU for a diagnostic nobody
         // reads). A caller that wants to know passes `&err` — which is the same
         // deal this surface already offers for transport errors.
-        s << "    if (_err.ok()) logosDispatchRejectionJson(_r, _err);\n";
+        //
+        // mayBeRejection() rules out nearly every reply from its first bytes,
+        // so the reply is parsed to json only when it could be one.
+        s << "    if (_err.ok() && _r.mayBeRejection()) logosDispatchRejectionJson(_r.json(), _err);\n";
         s << "    if (err) *err = _err;\n";
         if (ret != "void")
-            s << "    return " << fromWireFor(qtRet, ApiStyle::Lp, rs, "_r", className + "::") << ";\n";
+            s << "    return " << lpReplyReturnExpr(qtRet, rs, "_r", retQual) << ";\n";
         s << "}\n\n";
 
         // Async
@@ -1710,7 +2147,7 @@ QString makeSourceLp(const QString& moduleName, const QString& className, const
         s << asyncCb << " callback) {\n";
         s << "    if (!callback) return;\n";
         emitArgsArray();
-        s << "    " << clientExpr << ".invokeAsync(\"" << name << "\", _args, [callback](nlohmann::json _r) {\n";
+        s << "    " << clientExpr << ".invokeAsync(\"" << name << "\", _args, [callback = std::move(callback)](nlohmann::json _r) {\n";
         if (ret == "void") {
             s << "        (void)_r; callback();\n";
         } else {
@@ -1722,25 +2159,96 @@ QString makeSourceLp(const QString& moduleName, const QString& className, const
         // Result-carrying async. Same arg marshalling and the SAME value
         // decode as `<name>Async` above, so a failed call delivers exactly the
         // value that one would have delivered — plus the error that explains it.
-        s << "void " << className << "::" << name << "AsyncResult(";
+        //
+        // Twice: once with a timeout, once with a CancellationToken, which
+        // LpClient::invokeAsyncResult takes in the timeout's place.
+        auto emitAsyncResultDef = [&](const QString& lastParam, const QString& lastArg) {
+            s << "void " << className << "::" << name << "AsyncResult(";
+            emitParams();
+            if (!params.isEmpty()) s << ", ";
+            s << "std::function<void(logos::AsyncResult<" << ret << ">)> callback, "
+              << lastParam << ") {\n";
+            s << "    if (!callback) return;\n";
+            emitArgsArray();
+            s << "    " << clientExpr << ".invokeAsyncResult(\"" << name << "\", _args,\n";
+            emitAsyncResultAdapter(o);
+            s << ", " << lastArg << ");\n";
+            s << "}\n\n";
+        };
+        emitAsyncResultDef("int timeout_ms", "timeout_ms");
+        emitAsyncResultDef("const logos::CancellationToken& token", "token");
+
+        // Coroutine twin of `<name>AsyncResult`: the same marshalling, fold and
+        // decode, with LpClient::invokeCo's awaiter (in this coroutine's frame)
+        // standing in for the heap callback box. logos::Task is eager, so the
+        // arguments — references included — and the client are read before
+        // the first suspension, while the caller's values are still alive.
+        s << "#if LOGOS_HAS_COROUTINES\n";
+        s << "logos::Task<logos::AsyncResult<" << retQual << ">> " << className << "::" << name << "Co(";
         emitParams();
         if (!params.isEmpty()) s << ", ";
-        s << "std::function<void(logos::AsyncResult<" << ret << ">)> callback, "
-          << "int timeout_ms) {\n";
-        s << "    if (!callback) return;\n";
+        s << "int timeout_ms) {\n";
         emitArgsArray();
-        s << "    " << clientExpr << ".invokeAsyncResult(\"" << name << "\", _args,\n";
-        s << "        [callback](nlohmann::json _r, const logos::CallError& _err) {\n";
-        s << "            logos::AsyncResult<" << ret << "> _res;\n";
-        s << "            _res.error = _err;\n";
-        // Same fold as the sync path above, and for the same reason.
-        s << "            if (_res.error.ok()) logosDispatchRejectionJson(_r, _res.error);\n";
+        s << "    logos::AsyncResult<nlohmann::json> _reply = co_await " << clientExpr
+          << ".invokeCo(\"" << name << "\", std::move(_args), timeout_ms);\n";
+        s << "    nlohmann::json& _r = _reply.value;\n";
+        s << "    logos::AsyncResult<" << ret << "> _res;\n";
+        s << "    _res.error = _reply.error;\n";
+        s << "    if (_res.error.ok()) logosDispatchRejectionJson(_r, _res.error);\n";
         if (ret != "void")
-            s << "            _res.value = " << fromWireFor(qtRet, ApiStyle::Lp, rs, "_r", className + "::") << ";\n";
-        else
-            s << "            (void)_r;\n";
-        s << "            callback(_res);\n";
-        s << "        }, timeout_ms);\n";
+            s << "    _res.value = " << fromWireFor(qtRet, ApiStyle::Lp, rs, "_r", className + "::") << ";\n";
+        s << "    co_return _res;\n";
+        s << "}\n";
+        s << "#endif\n\n";
+    }
+
+    // The batch builder: each method queues its call with the very adapter
+    // `<name>AsyncResult` uses, so a batched call decodes and folds a
+    // rejection exactly as a lone one does. Its arguments go out as text
+    // (LpCall::argsText), written as the lone call writes them.
+    if (lpBatchBuilderFits(methods, rs)) {
+        s << className << "::Batch " << className << "::batch() {\n";
+        s << "    return Batch(" << clientExpr << ");\n";
+        s << "}\n\n";
+        for (const QJsonValue& v : methods) {
+            const QJsonObject o = v.toObject();
+            if (!o.value("isInvokable").toBool()) continue;
+            const QString name = o.value("name").toString();
+            const QString ret = returnTypeFor(o.value("returnType").toString(), ApiStyle::Lp, rs);
+            const QJsonArray params = o.value("parameters").toArray();
+            s << "void " << className << "::Batch::" << name << "(";
+            for (int i = 0; i < params.size(); ++i) {
+                const QJsonObject p = params.at(i).toObject();
+                const QString qtPt = p.value("type").toString();
+                const QString pt = paramTypeFor(qtPt, ApiStyle::Lp, rs);
+                if (byRefFor(qtPt, pt, ApiStyle::Lp, rs)) s << "const " << pt << "& " << p.value("name").toString();
+                else                                     s << pt << " " << p.value("name").toString();
+                s << ", ";
+            }
+            s << "std::function<void(logos::AsyncResult<" << ret << ">)> callback) {\n";
+            s << "    logos::LpCall _call;\n";
+            s << "    _call.method = \"" << name << "\";\n";
+            s << "    logos::ArgsWriter _args;\n";
+            for (const QJsonValue& pv : params) {
+                const QJsonObject p = pv.toObject();
+                s << "    " << lpWriteStmt(p.value("type").toString(), rs, "_args", p.value("name").toString()) << "\n";
+            }
+            s << "    _call.argsText = _args.take();\n";
+            s << "    if (callback) _call.onResult =\n";
+            emitAsyncResultAdapter(o);
+            s << ";\n";
+            s << "    m_calls.push_back(std::move(_call));\n";
+            s << "}\n\n";
+        }
+        s << "void " << className << "::Batch::send(std::function<void()> done, int timeout_ms) {\n";
+        s << "    std::vector<logos::LpCall> _calls;\n";
+        s << "    _calls.swap(m_calls);\n";
+        s << "    if (!done) {\n";
+        s << "        m_client->invokeBatch(std::move(_calls), nullptr, timeout_ms);\n";
+        s << "        return;\n";
+        s << "    }\n";
+        s << "    m_client->invokeBatch(std::move(_calls),\n";
+        s << "        [done](std::vector<logos::AsyncResult<nlohmann::json>>) { done(); }, timeout_ms);\n";
         s << "}\n\n";
     }
     return c;
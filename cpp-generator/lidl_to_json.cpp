@@ -67,8 +67,85 @@ void noteOptionalPositionalSlots(const ModuleDecl& mod, const QString& where,
            "they carry optionality through.\n";
 }
 
+// A method's result-cache policy, read from its doc comment. Two directive
+// lines, in the register of an event's `@coalesce`:
+//
+//     /// Current configuration.
+//     /// @cache 5000
+//     /// @invalidated-by configChanged
+//     Config getConfig();
+//
+// `@cache <ttl_ms>` marks the method's result cacheable for that long;
+// `@invalidated-by <event>...` (repeatable) names events of the same module
+// that end every cached answer early. A third, `@single-flight`, lets
+// identical calls in flight at once share one request. It stands on its own,
+// but pairs naturally with `@cache`, covering the cold start.
+//
+// Doc-comment tags, because the LIDL grammar belongs to logos-lidl, and
+// descriptions already travel every path a contract takes to this emitter.
+namespace {
+
+struct CacheTags {
+    bool tagged = false;       // an `@cache` line is present, well-formed or not
+    int ttlMs = 0;             // > 0 only when it is well-formed
+    QStringList invalidatedBy;
+    bool singleFlight = false;
+};
+
+CacheTags methodCacheTags(const MethodDecl& md)
+{
+    CacheTags t;
+    for (const QString& line : qs(md.description).split('\n')) {
+        const QString simplified = line.simplified();
+        if (simplified.isEmpty()) continue;
+        const QStringList words = simplified.split(' ');
+        if (words.front() == "@cache") {
+            t.tagged = true;
+            bool ok = false;
+            const int ms = words.size() == 2 ? words.at(1).toInt(&ok) : 0;
+            t.ttlMs = (ok && ms > 0) ? ms : 0;
+        } else if (words.front() == "@invalidated-by") {
+            t.invalidatedBy << words.mid(1);
+        } else if (words.front() == "@single-flight") {
+            t.singleFlight = true;
+        }
+    }
+    return t;
+}
+
+} // namespace
+
+// A tag that does not do what its author meant is reported rather than
+// silently dropped: without it, the method is simply never cached, which no
+// test of the module would notice.
+void noteMethodCacheTags(const ModuleDecl& mod, const QString& where, QTextStream& err)
+{
+    QStringList events;
+    for (const EventDecl& ed : mod.events) events << qs(ed.name);
+    for (const MethodDecl& md : mod.methods) {
+        const CacheTags t = methodCacheTags(md);
+        const QString name = qs(md.name);
+        if (t.tagged && t.ttlMs == 0)
+            err << "Warning: " << where << ": " << name << ": `@cache` needs a positive TTL in "
+                   "milliseconds (`@cache 5000`); the method is generated uncached.\n";
+        if (!t.tagged && !t.invalidatedBy.isEmpty())
+            err << "Warning: " << where << ": " << name << ": `@invalidated-by` without "
+                   "`@cache` has no effect.\n";
+        for (const QString& ev : t.invalidatedBy)
+            if (!events.contains(ev))
+                err << "Warning: " << where << ": " << name << ": `@invalidated-by " << ev
+                    << "` names no event of this module; the TTL alone bounds staleness.\n";
+    }
+}
+
 // Build a getMethods()-shaped QJsonArray (the surface makeHeader/makeSource
 // consume) from a parsed ModuleDecl. Every interface method is invokable.
+//
+// A method tagged `@cache` also carries `cache: {ttlMs, invalidatedBy}`; the
+// key is absent otherwise, so an untagged contract's JSON is unchanged; the
+// same holds for `singleFlight: true` and `@single-flight`. An
+// invalidating event the module does not declare is dropped here: it could
+// never fire, and subscribing to it would only fail.
 QJsonArray moduleMethodsToJson(const ModuleDecl& mod)
 {
     QJsonArray arr;
@@ -85,6 +162,20 @@ QJsonArray moduleMethodsToJson(const ModuleDecl& mod)
             params.append(po);
         }
         o["parameters"] = params;
+        const CacheTags t = methodCacheTags(m);
+        if (t.ttlMs > 0) {
+            QJsonArray invalidatedBy;
+            for (const QString& ev : t.invalidatedBy) {
+                bool declared = false;
+                for (const EventDecl& ed : mod.events) declared = declared || qs(ed.name) == ev;
+                if (declared && !invalidatedBy.contains(ev)) invalidatedBy.append(ev);
+            }
+            QJsonObject cache;
+            cache["ttlMs"] = t.ttlMs;
+            cache["invalidatedBy"] = invalidatedBy;
+            o["cache"] = cache;
+        }
+        if (t.singleFlight) o["singleFlight"] = true;
         arr.append(o);
     }
     return arr;
@@ -26,7 +26,9 @@
 // than keeping a second table.
 QString lidlTypeExprToQtTypeName(const TypeExpr& te);
 
-// getMethods()-shaped: [ { name, returnType, isInvokable, parameters:[{name,type}] } ]
+// getMethods()-shaped: [ { name, returnType, isInvokable, parameters:[{name,type}] } ],
+// plus `cache: { ttlMs, invalidatedBy:[event] }` on a method tagged `@cache`
+// and `singleFlight: true` on one tagged `@single-flight`.
 QJsonArray moduleMethodsToJson(const ModuleDecl& mod);
 
 // [ { name, fields: [ { name, type, optional } ] } ]
@@ -46,4 +48,8 @@ QJsonArray moduleEventsToJson(const ModuleDecl& mod);
 void noteOptionalPositionalSlots(const ModuleDecl& mod, const QString& where,
                                  QTextStream& err);
 
+// Warn about `@cache` / `@invalidated-by` doc-comment tags that will not take
+// effect as written (see moduleMethodsToJson).
+void noteMethodCacheTags(const ModuleDecl& mod, const QString& where, QTextStream& err);
+
 #endif // LIDL_TO_JSON_H
@@ -181,6 +181,7 @@ static bool generateInterfaceWrappers(const QVector<InterfaceSpec>& ifaces,
         }
 
         noteOptionalPositionalSlots(mod, spec.path, err);
+        noteMethodCacheTags(mod, spec.path, err);
 
         const QString className = toPascalCase(spec.name);
         const QJsonArray methods = moduleMethodsToJson(mod);
@@ -0,0 +1,90 @@
+#ifndef LOGOS_ARGS_WRITER_H
+#define LOGOS_ARGS_WRITER_H
+
+// ---------------------------------------------------------------------------
+// logos::ArgsWriter — a call's argument array, written straight as JSON text.
+//
+// A call used to marshal its arguments twice. The generated wrapper built an
+// nlohmann::json array and pushed each argument into it. LpClient then
+// dump()ed that array into a fresh string for the transport. For a large
+// `bstr` or `[Record]` argument, the DOM build alone costs as much as the
+// text. ArgsWriter skips the DOM: each value is appended to the text as it is
+// written, and LpClient takes the writer in place of the json array (see
+// LpClient::invoke).
+//
+// The text is what `json.dump()` would have produced for the same values, so
+// the target reads back exactly what the DOM held; the writing itself, shared
+// with the cdylib dispatch's replies, is logos::detail::JsonWriter
+// (logos_json_writer.h).
+//
+// The buffer is REUSED. Each thread keeps one string. A writer borrows it on
+// construction and hands it back, cleared, on destruction, so a thread making
+// call after call stops allocating once the buffer has grown to its largest
+// call. A writer made while another is alive on the same thread (a call from
+// inside a callback) simply starts with a fresh string. A buffer grown past
+// kRetainLimit is freed instead of being kept, so one huge upload does not
+// pin its memory for the thread's lifetime.
+//
+// Not thread-safe: a writer belongs to the call being marshalled.
+//
+// Qt-FREE, std + nlohmann only.
+// ---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include "logos_json_writer.h"
+
+namespace logos {
+
+class ArgsWriter : public detail::JsonWriter<ArgsWriter, std::string> {
+public:
+    static constexpr std::size_t kRetainLimit = std::size_t(1) << 20;
+
+    ArgsWriter()
+    {
+        m_buf.swap(pooled());
+        m_buf.push_back('[');
+    }
+
+    ~ArgsWriter()
+    {
+        if (m_buf.capacity() > kRetainLimit) return;
+        m_buf.clear();
+        std::string& pool = pooled();
+        if (m_buf.capacity() > pool.capacity()) pool.swap(m_buf);
+    }
+
+    // The finished array. Closes it on the first call; writing after that is
+    // a caller error.
+    const std::string& text()
+    {
+        if (!m_closed) {
+            m_buf.push_back(']');
+            m_closed = true;
+        }
+        return m_buf;
+    }
+
+    // The finished array, moved out — for a call that must keep its text past
+    // this writer's lifetime. The thread's buffer goes with it.
+    std::string take()
+    {
+        text();
+        return std::move(m_buf);
+    }
+
+private:
+    static std::string& pooled()
+    {
+        thread_local std::string buf;
+        return buf;
+    }
+
+    bool m_closed = false;
+};
+
+} // namespace logos
+
+#endif // LOGOS_ARGS_WRITER_H
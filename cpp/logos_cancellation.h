@@ -0,0 +1,175 @@
+#ifndef LOGOS_CANCELLATION_H
+#define LOGOS_CANCELLATION_H
+
+// ---------------------------------------------------------------------------
+// logos::CancellationToken — "stop caring about this call", plus a deadline.
+//
+// Once an async call is issued it runs to its end. A handler that gave up
+// (its own caller timed out, the request was abandoned) used to have no way
+// to say so: its reply still arrived, its callback still ran, and the work
+// hanging off that callback (decoding, the next call in the chain) was done
+// for nobody. A call made with a token (LpClient::invokeAsyncResult and the
+// generated `<name>AsyncResult` overloads) checks it twice:
+//   - before it is issued: a cancelled call is not issued at all, and one
+//     whose deadline has passed completes at once with a `timeout` error;
+//   - while it is in flight: cancel() releases its callback there and then,
+//     through onCancel(), rather than leaving it (and all it captured) held
+//     until a reply nobody wants lands.
+// Either way a cancelled call's callback is never called. One that is
+// already running when cancel() is called runs to its end; cancel() does
+// not wait for it.
+//
+// The deadline is ABSOLUTE. A call forwards the time remaining as its
+// timeout_ms, so a chain of calls made with one token shares one budget,
+// however many hops it takes. child() narrows it for one part of the chain:
+// the child is cancelled with its parent and never outlives its deadline.
+//
+// Copies share their state: cancel() through any copy cancels them all.
+// Thread-safe.
+//
+// Qt-FREE, std only.
+// ---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace logos {
+
+class CancellationToken {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // A token with no deadline, cancelled only by cancel().
+    CancellationToken() : m_state(std::make_shared<State>()) {}
+
+    static CancellationToken withDeadline(Clock::time_point deadline)
+    {
+        CancellationToken token;
+        token.m_state->deadline = deadline;
+        token.m_state->hasDeadline = true;
+        return token;
+    }
+
+    static CancellationToken withTimeout(std::chrono::milliseconds timeout)
+    {
+        return withDeadline(Clock::now() + timeout);
+    }
+
+    // A token cancelled whenever this one is, whose deadline is the earlier
+    // of this one's and `timeout` from now. Cancelling the child leaves this
+    // one alone.
+    CancellationToken child(std::chrono::milliseconds timeout) const
+    {
+        CancellationToken token = child();
+        const Clock::time_point mine = Clock::now() + timeout;
+        token.m_state->deadline = m_state->hasDeadline ? std::min(m_state->deadline, mine) : mine;
+        token.m_state->hasDeadline = true;
+        return token;
+    }
+
+    CancellationToken child() const
+    {
+        CancellationToken token;
+        token.m_state->parent = m_state;
+        token.m_state->deadline = m_state->deadline;
+        token.m_state->hasDeadline = m_state->hasDeadline;
+        return token;
+    }
+
+    // Cancels this token and every child of it, and runs the onCancel()
+    // hooks of all of them, on this thread.
+    void cancel() const
+    {
+        m_state->cancelled.store(true, std::memory_order_release);
+        std::vector<std::weak_ptr<Hook>> hooks;
+        {
+            std::lock_guard<std::mutex> lock(m_state->hooksMutex);
+            hooks.swap(m_state->hooks);
+        }
+        for (const std::weak_ptr<Hook>& weak : hooks)
+            if (std::shared_ptr<Hook> hook = weak.lock()) hook->fire();
+    }
+
+    // Runs `fn` once when this token is cancelled, through cancel() on it or
+    // on any parent, on the cancelling thread; at once, here, if it already
+    // is. `fn` stays registered while the returned handle is held. Dropping
+    // the handle unregisters it, though a cancel() already under way may
+    // still run it.
+    std::shared_ptr<void> onCancel(std::function<void()> fn) const
+    {
+        auto hook = std::make_shared<Hook>(std::move(fn));
+        for (const State* s = m_state.get(); s; s = s->parent.get()) {
+            std::lock_guard<std::mutex> lock(s->hooksMutex);
+            s->hooks.erase(std::remove_if(s->hooks.begin(), s->hooks.end(),
+                                          [](const std::weak_ptr<Hook>& h) { return h.expired(); }),
+                           s->hooks.end());
+            s->hooks.push_back(hook);
+        }
+        // After the registration, so a cancel() racing it either finds the
+        // hook or is seen here.
+        if (cancelled()) hook->fire();
+        return hook;
+    }
+
+    bool cancelled() const
+    {
+        for (const State* s = m_state.get(); s; s = s->parent.get())
+            if (s->cancelled.load(std::memory_order_acquire)) return true;
+        return false;
+    }
+
+    bool hasDeadline() const { return m_state->hasDeadline; }
+    Clock::time_point deadline() const { return m_state->deadline; }
+    bool expired() const { return m_state->hasDeadline && Clock::now() >= m_state->deadline; }
+
+    // What is left of the deadline, as a call's timeout_ms: rounded up, at
+    // least 1 while the deadline is ahead, and 0 (the protocol default) when
+    // there is no deadline. An expired token answers 1; a call checks
+    // expired() before it gets this far.
+    int remainingMs() const
+    {
+        if (!m_state->hasDeadline) return 0;
+        const auto left = std::chrono::ceil<std::chrono::milliseconds>(m_state->deadline - Clock::now());
+        if (left.count() <= 0) return 1;
+        return static_cast<int>(std::min<std::chrono::milliseconds::rep>(left.count(), INT_MAX));
+    }
+
+private:
+    // One onCancel() registration, held on every state in the chain so that
+    // cancelling any of them finds it. Runs at most once however many do.
+    struct Hook {
+        explicit Hook(std::function<void()> f) : fn(std::move(f)) {}
+        void fire()
+        {
+            if (!fired.exchange(true)) fn();
+        }
+        std::function<void()> fn;
+        std::atomic<bool> fired{false};
+    };
+
+    struct State {
+        std::atomic<bool> cancelled{false};
+        bool hasDeadline = false;
+        Clock::time_point deadline{};
+        // Cancelled with this. Held strongly: a child keeps its chain alive,
+        // and nothing points back down, so there is no cycle.
+        std::shared_ptr<const State> parent;
+        // Weak: a registration lives as long as its handle. Expired entries
+        // are swept on the next registration.
+        mutable std::mutex hooksMutex;
+        mutable std::vector<std::weak_ptr<Hook>> hooks;
+    };
+
+    std::shared_ptr<State> m_state;
+};
+
+} // namespace logos
+
+#endif // LOGOS_CANCELLATION_H
@@ -0,0 +1,218 @@
+#ifndef LOGOS_CONCURRENCY_LIMIT_H
+#define LOGOS_CONCURRENCY_LIMIT_H
+
+// ---------------------------------------------------------------------------
+// logos::ConcurrencyLimiter — how many calls one client has out at a time.
+//
+// Nothing used to stop a module from having a thousand calls out to a target
+// that can serve ten. The target's queue grows, every call's latency grows
+// with it, calls start timing out after the target has already done their
+// work, and the retries that follow make it worse. With a limiter in place
+// (LpClient::limitConcurrency) a call first asks it for a PERMIT:
+//   - while fewer than limit() calls are out, it gets one and is issued;
+//   - otherwise it waits in a FIFO queue, and is issued by the completion
+//     that frees a permit;
+//   - and when that queue is full it is refused at once, with CallError code
+//     `overloaded`, so the caller can shed the work instead of piling on.
+//
+// The limit is ADAPTIVE by default (additive increase, multiplicative
+// decrease, the same rule TCP uses for its window). Every reply is a latency
+// sample, measured from the moment the call was issued, not queued. The
+// limiter keeps a baseline — the fastest recent reply — and reads a reply
+// slower than `tolerance` times the baseline as the target queueing work:
+// the limit is cut by `backoff`. A reply within it, while the limit was
+// actually in use, raises the limit by 1/limit, about one per round trip's
+// worth of replies. So the limit settles near the concurrency the target can
+// serve without queueing, and follows it as that changes. A timed-out call
+// is a slow reply like any other.
+//
+// One cut per episode: replies to calls issued before the last cut were
+// already out when it was made, and do not cut again — otherwise a single
+// stall, seen by every call in flight, would drive the limit to its floor.
+//
+// Thread-safe. A queued call is started on the thread of the completion that
+// freed its permit, outside the lock.
+//
+// Qt-FREE, std only.
+// ---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace logos {
+
+// Declared outside the class so that it can be a default argument inside it.
+struct ConcurrencyLimitOptions {
+    int limit = 64;          // where the limit starts; the fixed limit when !adaptive
+    int minLimit = 1;
+    int maxLimit = 1024;
+    // Calls waiting for a permit before further ones are refused. 0
+    // refuses every call that finds the limit reached.
+    std::size_t maxQueued = 1024;
+    bool adaptive = true;
+    double tolerance = 2.0;  // a reply slower than this × baseline is congestion
+    double backoff = 0.9;    // the limit's factor on congestion
+};
+
+class ConcurrencyLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Options = ConcurrencyLimitOptions;
+
+    // A call waiting for a permit, as a plain function and its argument, so
+    // the caller decides how a call is stored. `run(ud, true)` hands it the
+    // permit; `run(ud, false)` turns it away (see abandon()). Exactly once.
+    struct Waiter {
+        void (*run)(void* ud, bool admitted) = nullptr;
+        void* ud = nullptr;
+    };
+
+    enum class Admission {
+        Admitted,  // the caller holds a permit: issue now, release() later
+        Queued,    // the waiter was taken and will be run
+        Rejected,  // over the limit with a full queue: fail the call
+    };
+
+    explicit ConcurrencyLimiter(Options options = Options())
+        : m_options(sanitized(options)), m_limit(m_options.limit) {}
+
+    ConcurrencyLimiter(const ConcurrencyLimiter&) = delete;
+    ConcurrencyLimiter& operator=(const ConcurrencyLimiter&) = delete;
+
+    // A permit now, if one is free and nobody is waiting for it; false
+    // otherwise, with nothing queued. The fast path: a caller that has to
+    // wait only then builds the Waiter it hands to admit().
+    bool tryAcquire()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_closed || m_inFlight >= effectiveLimit() || !m_queue.empty()) return false;
+        ++m_inFlight;
+        return true;
+    }
+
+    // Admission and queueing are one step under one lock: a permit freed
+    // between "the limit is reached" and "wait in line" would otherwise be
+    // missed, and the waiter left in a queue nothing drains.
+    Admission admit(Waiter waiter)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_closed) return Admission::Rejected;
+        if (m_inFlight < effectiveLimit() && m_queue.empty()) {
+            ++m_inFlight;
+            return Admission::Admitted;
+        }
+        if (m_queue.size() >= m_options.maxQueued) return Admission::Rejected;
+        m_queue.push_back(waiter);
+        return Admission::Queued;
+    }
+
+    // Gives back the permit of a call issued at `issued`, whose reply (or
+    // failure) has just landed, and starts whichever queued calls now fit.
+    void release(Clock::time_point issued) { handBack(true, issued); }
+
+    // Gives back a permit whose call never reached the transport, without a
+    // latency sample.
+    void cancel() { handBack(false, Clock::time_point()); }
+
+    // Turns every queued call away and refuses new ones: the client is going
+    // away, and nothing is left to issue them on.
+    void abandon()
+    {
+        std::deque<Waiter> dropped;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+            dropped.swap(m_queue);
+        }
+        for (const Waiter& w : dropped) w.run(w.ud, false);
+    }
+
+    int limit() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return effectiveLimit();
+    }
+    int inFlight() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_inFlight;
+    }
+    std::size_t queued() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_queue.size();
+    }
+
+private:
+    // How far the baseline moves toward a slower sample. A baseline that
+    // only ever fell would hold a target that got slower for good to a limit
+    // it can no longer have back.
+    static constexpr double kBaselineDrift = 1.0 / 256;
+    // Below a millisecond, latency is scheduling noise: an in-process target
+    // answering in 50us and then in 200us is not congested.
+    static constexpr double kNoiseFloorMs = 1.0;
+
+    static Options sanitized(Options o)
+    {
+        o.minLimit = std::max(1, o.minLimit);
+        o.maxLimit = std::max(o.minLimit, o.maxLimit);
+        o.limit = std::clamp(o.limit, o.minLimit, o.maxLimit);
+        o.tolerance = std::max(1.0, o.tolerance);
+        o.backoff = std::clamp(o.backoff, 0.1, 1.0);
+        return o;
+    }
+
+    int effectiveLimit() const { return static_cast<int>(m_limit); }
+
+    void handBack(bool sampled, Clock::time_point issued)
+    {
+        std::vector<Waiter> start;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (sampled && m_options.adaptive) adapt(issued, Clock::now());
+            if (m_inFlight > 0) --m_inFlight;
+            while (!m_queue.empty() && m_inFlight < effectiveLimit()) {
+                start.push_back(m_queue.front());
+                m_queue.pop_front();
+                ++m_inFlight;
+            }
+        }
+        for (const Waiter& w : start) w.run(w.ud, true);
+    }
+
+    void adapt(Clock::time_point issued, Clock::time_point now)
+    {
+        const double sample = std::chrono::duration<double, std::milli>(now - issued).count();
+        if (!m_sampled || sample < m_baseline) m_baseline = sample;
+        else m_baseline += (sample - m_baseline) * kBaselineDrift;
+        m_sampled = true;
+
+        if (sample > m_options.tolerance * std::max(m_baseline, kNoiseFloorMs)) {
+            if (issued < m_lastCut) return;
+            m_limit = std::max<double>(m_options.minLimit, m_limit * m_options.backoff);
+            m_lastCut = now;
+        } else if (2 * m_inFlight >= effectiveLimit()) {
+            // Only a limit in use earns more: an idle client would otherwise
+            // grow it without ever having tested it.
+            m_limit = std::min<double>(m_options.maxLimit, m_limit + 1.0 / m_limit);
+        }
+    }
+
+    const Options m_options;
+    mutable std::mutex m_mutex;
+    double m_limit;
+    double m_baseline = 0.0;  // ms
+    bool m_sampled = false;
+    Clock::time_point m_lastCut{};
+    int m_inFlight = 0;
+    std::deque<Waiter> m_queue;
+    bool m_closed = false;
+};
+
+} // namespace logos
+
+#endif // LOGOS_CONCURRENCY_LIMIT_H
@@ -0,0 +1,232 @@
+#ifndef LOGOS_DEFERRED_H
+#define LOGOS_DEFERRED_H
+
+// ---------------------------------------------------------------------------
+// logos::Deferred<T> — a method result that arrives LATER.
+//
+// A universal impl method answers by returning its value, and the generated
+// dispatch holds the calling thread until it does. For a handler that waits on
+// something else — a peer, a disk, a dependency's own async call — that is one
+// host thread parked per call in flight, doing nothing. Returning
+// `logos::Deferred<T>` instead hands the generated provider a completion handle:
+// the method returns at once, keeps a copy, and calls resolve() (or reject())
+// whenever the answer exists, from whatever thread produced it.
+//
+//     logos::Deferred<std::string> fetch(const std::string& key) {
+//         logos::Deferred<std::string> reply;
+//         m_store.getAsync(key, [reply](std::string v) { reply.resolve(std::move(v)); });
+//         return reply;
+//     }
+//
+// The impl_header_parser publishes `Deferred<T>` as plain `T`: when the answer
+// arrives is the provider's business, not the contract's, so a consumer in any
+// language sees an ordinary method. How it is driven depends on the host:
+//
+//   - logos_module_dispatch_async (protocol 0.7) attaches a continuation and
+//     returns; the host's completion callback runs on the thread that settles
+//     the Deferred — inline, if the method settled it before returning.
+//   - logos_module_dispatch (every host) has to answer on the calling thread,
+//     so it waits for the value. A synchronous host keeps working unchanged; it
+//     just gets none of the benefit. Never settle a Deferred from work queued
+//     behind the very call that waits for it.
+//
+// A Deferred is a HANDLE: copies share one result, and only the first resolve()
+// or reject() counts (the rest return false). If every handle is dropped before
+// either is called, the call is rejected with `deferred_abandoned` rather than
+// left hanging forever.
+//
+// Qt-FREE, std-only.
+// ---------------------------------------------------------------------------
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace logos {
+
+// What reject() carries. The dispatch answers it as the usual error object:
+// {"code": code(), "message": what(), "origin": <module>}.
+class DeferredRejected : public std::runtime_error {
+public:
+    DeferredRejected(std::string code, const std::string& message)
+        : std::runtime_error(message), m_code(std::move(code)) {}
+
+    const std::string& code() const noexcept { return m_code; }
+
+private:
+    std::string m_code;
+};
+
+namespace detail {
+
+// The value slot of a Deferred<void>.
+struct DeferredUnit {};
+
+template <typename V>
+class DeferredState {
+public:
+    using Continuation = std::function<void(const V* value, const DeferredRejected* error)>;
+
+    bool settle(std::optional<V> value, std::optional<DeferredRejected> error)
+    {
+        Continuation then;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_settled) return false;
+            m_value = std::move(value);
+            m_error = std::move(error);
+            m_settled = true;
+            then = std::move(m_then);
+        }
+        m_cv.notify_all();
+        if (then) then(m_value ? &*m_value : nullptr, m_error ? &*m_error : nullptr);
+        return true;
+    }
+
+    bool settled() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_settled;
+    }
+
+    // Runs `then` once the state settles: right here if it already has.
+    void onSettled(Continuation then)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_settled) {
+                m_then = std::move(then);
+                return;
+            }
+        }
+        then(m_value ? &*m_value : nullptr, m_error ? &*m_error : nullptr);
+    }
+
+    V wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_settled; });
+        if (m_error) throw *m_error;
+        return std::move(*m_value);
+    }
+
+    // Live handles; the last one to go rejects an unsettled call.
+    std::atomic<std::size_t> handles{1};
+
+private:
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_settled = false;
+    std::optional<V> m_value;
+    std::optional<DeferredRejected> m_error;
+    Continuation m_then;
+};
+
+template <typename V>
+class DeferredHandle {
+public:
+    using State = DeferredState<V>;
+
+    DeferredHandle() : m_state(std::make_shared<State>()) {}
+    DeferredHandle(const DeferredHandle& other) : m_state(other.m_state) { retain(); }
+    DeferredHandle(DeferredHandle&& other) noexcept : m_state(std::move(other.m_state)) {}
+    DeferredHandle& operator=(DeferredHandle other) noexcept
+    {
+        std::swap(m_state, other.m_state);
+        return *this;
+    }
+    ~DeferredHandle() { release(); }
+
+    bool reject(std::string code, std::string message) const
+    {
+        return m_state && m_state->settle(std::nullopt, DeferredRejected(std::move(code), message));
+    }
+
+    bool settled() const { return m_state && m_state->settled(); }
+
+    // -- framework side: called by the generated dispatch, never by an impl --
+    //
+    // Both consume the handle that was returned, so a method that kept no copy
+    // and did not settle before returning is abandoned at once rather than
+    // waited on forever.
+    void _logosCoreOnSettled_(typename State::Continuation then) &&
+    {
+        std::shared_ptr<State> state = m_state;
+        release();
+        state->onSettled(std::move(then));
+    }
+
+    V _logosCoreWait_() &&
+    {
+        std::shared_ptr<State> state = m_state;
+        release();
+        return state->wait();
+    }
+
+protected:
+    bool settleValue(V value) const
+    {
+        return m_state && m_state->settle(std::move(value), std::nullopt);
+    }
+
+private:
+    void retain()
+    {
+        if (m_state) m_state->handles.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void release()
+    {
+        if (!m_state) return;
+        std::shared_ptr<State> state = std::move(m_state);
+        if (state->handles.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            state->settle(std::nullopt, DeferredRejected(
+                "deferred_abandoned", "the method dropped its Deferred without settling it"));
+    }
+
+    std::shared_ptr<State> m_state;
+};
+
+} // namespace detail
+
+/**
+ * @brief A completion handle for a method whose result arrives later.
+ *
+ * Default-constructed pending. resolve() / reject() settle it once and return
+ * whether this call was the one that did.
+ */
+template <typename T>
+class Deferred : public detail::DeferredHandle<T> {
+public:
+    using value_type = T;
+
+    bool resolve(T value) const { return this->settleValue(std::move(value)); }
+};
+
+/**
+ * @brief The void form: completion with no value, published as a `void` method.
+ */
+template <>
+class Deferred<void> : public detail::DeferredHandle<detail::DeferredUnit> {
+public:
+    using value_type = void;
+
+    bool resolve() const { return this->settleValue(detail::DeferredUnit{}); }
+};
+
+template <typename R>
+struct isDeferred : std::false_type {};
+
+template <typename T>
+struct isDeferred<Deferred<T>> : std::true_type {};
+
+} // namespace logos
+
+#endif // LOGOS_DEFERRED_H
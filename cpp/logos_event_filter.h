@@ -0,0 +1,202 @@
+#ifndef LOGOS_EVENT_FILTER_H
+#define LOGOS_EVENT_FILTER_H
+
+// ---------------------------------------------------------------------------
+// logos::EventFilter — which arrivals of an event a listener wants.
+//
+// A listener that wants one account's slice of a firehose event used to take
+// every arrival, have it parsed, and throw away all but a handful in its own
+// callback. A filter states the slice up front, as a conjunction of simple
+// conditions on the payload:
+//
+//     logos::EventFilter f;
+//     f.equal({0}, "acct-42").greaterOrEqual({1, "amount"}, 1000);
+//     auto sub = client.subscribe("transferred", f, onTransfer);
+//
+// A PATH picks a value out of the payload, one step at a time: a number
+// indexes an array (the event's positional arguments are the top-level one),
+// and a string names an object member (a record field). A condition compares
+// that value with a constant:
+//   - numbers compare numerically, whatever their JSON representation, and
+//     strings compare byte by byte;
+//   - equal/notEqual compare any two values, containers included;
+//   - the ordering conditions hold only between two numbers or two strings,
+//     so a value of another type fails them;
+//   - a path that leads nowhere fails every condition except notEqual.
+//
+// matches(text) reads the payload's TEXT (logos::JsonReader), not a DOM, and
+// stops at the first failed condition, each condition reading only as far
+// into the text as its path reaches. An arrival nobody wants is therefore
+// never parsed. It does not check the text after that point, so a text that
+// is not well-formed JSON can pass it; LpClient's delivery parses what
+// passed, and a filtered listener is never given a payload that did not
+// parse.
+//
+// Qt-FREE, std + nlohmann only.
+// ---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "logos_json_reader.h"
+
+namespace logos {
+
+class EventFilter {
+public:
+    // One step of a path: an array index or an object key.
+    struct Step {
+        Step(int i) : index(i < 0 ? kNowhere : static_cast<std::size_t>(i)) {}
+        Step(std::size_t i) : index(i) {}
+        Step(const char* k) : isKey(true), key(k) {}
+        Step(std::string k) : isKey(true), key(std::move(k)) {}
+
+        bool isKey = false;
+        std::size_t index = 0;
+        std::string key;
+    };
+    using Path = std::vector<Step>;
+
+    enum class Op { Equal, NotEqual, Less, LessOrEqual, Greater, GreaterOrEqual, Between };
+
+    struct Condition {
+        Path path;
+        Op op;
+        nlohmann::json value;
+        nlohmann::json upper;  // Between's inclusive upper bound; `value` is its lower
+    };
+
+    EventFilter& equal(Path path, nlohmann::json value) { return add(std::move(path), Op::Equal, std::move(value)); }
+    EventFilter& notEqual(Path path, nlohmann::json value) { return add(std::move(path), Op::NotEqual, std::move(value)); }
+    EventFilter& less(Path path, nlohmann::json value) { return add(std::move(path), Op::Less, std::move(value)); }
+    EventFilter& lessOrEqual(Path path, nlohmann::json value) { return add(std::move(path), Op::LessOrEqual, std::move(value)); }
+    EventFilter& greater(Path path, nlohmann::json value) { return add(std::move(path), Op::Greater, std::move(value)); }
+    EventFilter& greaterOrEqual(Path path, nlohmann::json value) { return add(std::move(path), Op::GreaterOrEqual, std::move(value)); }
+    // lower <= value <= upper.
+    EventFilter& between(Path path, nlohmann::json lower, nlohmann::json upper)
+    {
+        return add(std::move(path), Op::Between, std::move(lower), std::move(upper));
+    }
+
+    // No conditions: every arrival matches.
+    bool empty() const { return m_conditions.empty(); }
+    const std::vector<Condition>& conditions() const { return m_conditions; }
+
+    // Whether the payload in [begin, end) passes every condition.
+    bool matches(const char* begin, const char* end) const
+    {
+        for (const Condition& c : m_conditions) {
+            JsonReader r(begin, end);
+            nlohmann::json value;
+            if (!test(c, find(r, c.path, value) ? &value : nullptr)) return false;
+        }
+        return true;
+    }
+    bool matches(const std::string& text) const { return matches(text.data(), text.data() + text.size()); }
+
+    // The same, for a payload already parsed.
+    bool matches(const nlohmann::json& payload) const
+    {
+        for (const Condition& c : m_conditions)
+            if (!test(c, find(payload, c.path, 0))) return false;
+        return true;
+    }
+
+private:
+    static constexpr std::size_t kNowhere = static_cast<std::size_t>(-1);
+
+    EventFilter& add(Path path, Op op, nlohmann::json value, nlohmann::json upper = nullptr)
+    {
+        m_conditions.push_back({std::move(path), op, std::move(value), std::move(upper)});
+        return *this;
+    }
+
+    // The value at `path` in the reader's next value, into `out`. Elements
+    // before an index are skipped, not read. A key reads its member, and the
+    // rest of the path goes on in that member's DOM: a member can be repeated,
+    // the parser keeps the last, and that is only known once the object ends.
+    static bool find(JsonReader& r, const Path& path, nlohmann::json& out)
+    {
+        for (std::size_t s = 0; s < path.size(); ++s) {
+            const Step& step = path[s];
+            if (step.isKey) {
+                if (r.peek() != JsonReader::Kind::Object || !r.beginObject()) return false;
+                std::string key;
+                nlohmann::json member;
+                bool found = false;
+                while (r.nextKey(key)) {
+                    if (key != step.key) {
+                        if (!r.skip()) return false;
+                    } else if (r.readJson(member)) {
+                        found = true;
+                    } else {
+                        return false;
+                    }
+                }
+                if (!found || r.failed()) return false;
+                const nlohmann::json* rest = find(member, path, s + 1);
+                if (!rest) return false;
+                out = *rest;
+                return true;
+            }
+            if (r.peek() != JsonReader::Kind::Array || !r.beginArray()) return false;
+            std::size_t i = 0;
+            for (;; ++i) {
+                if (!r.nextElement()) return false;
+                if (i == step.index) break;
+                if (!r.skip()) return false;
+            }
+        }
+        return r.readJson(out);
+    }
+
+    static const nlohmann::json* find(const nlohmann::json& value, const Path& path, std::size_t from)
+    {
+        const nlohmann::json* at = &value;
+        for (std::size_t s = from; s < path.size(); ++s) {
+            const Step& step = path[s];
+            if (step.isKey) {
+                if (!at->is_object()) return nullptr;
+                auto it = at->find(step.key);
+                if (it == at->end()) return nullptr;
+                at = &*it;
+            } else {
+                if (!at->is_array() || step.index >= at->size()) return nullptr;
+                at = &(*at)[step.index];
+            }
+        }
+        return at;
+    }
+
+    static bool ordered(const nlohmann::json& a, const nlohmann::json& b)
+    {
+        return (a.is_number() && b.is_number()) || (a.is_string() && b.is_string());
+    }
+
+    static bool test(const Condition& c, const nlohmann::json* v)
+    {
+        if (!v) return c.op == Op::NotEqual;
+        const nlohmann::json& a = *v;
+        switch (c.op) {
+        case Op::Equal: return a == c.value;
+        case Op::NotEqual: return a != c.value;
+        case Op::Less: return ordered(a, c.value) && a < c.value;
+        case Op::LessOrEqual: return ordered(a, c.value) && a <= c.value;
+        case Op::Greater: return ordered(a, c.value) && a > c.value;
+        case Op::GreaterOrEqual: return ordered(a, c.value) && a >= c.value;
+        case Op::Between:
+            return ordered(a, c.value) && ordered(a, c.upper) && c.value <= a && a <= c.upper;
+        }
+        return false;
+    }
+
+    std::vector<Condition> m_conditions;
+};
+
+} // namespace logos
+
+#endif // LOGOS_EVENT_FILTER_H
@@ -0,0 +1,250 @@
+#ifndef LOGOS_EVENT_QUEUE_H
+#define LOGOS_EVENT_QUEUE_H
+
+// ---------------------------------------------------------------------------
+// logos::EventQueue — a bounded queue between an event's arrival and a slow
+// listener.
+//
+// An event listener is called on the thread that delivers the event, so a
+// slow one used to hold that thread, and whatever the transport buffered
+// behind it grew without bound. A listener subscribed with a queue is
+// instead handed its arrivals on a delivery thread of its own: an arrival is
+// queued and the delivering thread moves on. The queue holds at most
+// `capacity` arrivals. What happens to one that finds it full is the
+// listener's choice:
+//   - DropOldest: the oldest waiting arrival goes to make room, so the
+//     listener stays as close to live as it can;
+//   - DropNewest: the arrival itself goes, so the listener sees an unbroken
+//     prefix of the stream;
+//   - Coalesce: only the latest arrival is kept at all. A newer one replaces
+//     the one still waiting, so a listener that only needs the current state
+//     never works through a stale backlog. Capacity plays no part. (To keep
+//     the latest per key, give each key its own filtered subscription.)
+//   - Block: the delivering thread waits for room. Nothing is lost, and the
+//     transport is slowed to the listener's pace — and with it every other
+//     listener it delivers to. An arrival the listener causes itself, on its
+//     own delivery thread, cannot wait for itself: it drops the oldest.
+// EventQueueCounters says how it is going: what is waiting now, and what was
+// delivered, dropped, coalesced, and made to wait.
+//
+// Arrivals are delivered in order, one at a time. Closing the queue drops
+// what is still waiting and waits for the listener call in progress, unless
+// it is the caller's own, so nothing is delivered after close() returns.
+//
+// With an Executor (logos_executor.h) there is no thread of the queue's own:
+// the queue is drained by a task on the executor, submitted when the first
+// arrival finds it idle. Only one drain task exists at a time, which is what
+// keeps a listener's calls ordered and never concurrent while many
+// listeners share a few workers. A drain hands the worker back after a batch
+// of arrivals and queues itself again, so one busy listener cannot keep a
+// worker from the rest. Without a capacity such a queue is unbounded.
+//
+// Qt-FREE, std only.
+// ---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "logos_executor.h"
+
+namespace logos {
+
+struct EventQueueOptions {
+    enum class Overflow { DropOldest, DropNewest, Coalesce, Block };
+
+    // Arrivals that may wait. 0, the default, is no queue at all: the
+    // listener is called on the delivering thread. (With an executor, 0 is
+    // a queue without a bound.)
+    std::size_t capacity = 0;
+    Overflow overflow = Overflow::DropOldest;
+};
+
+struct EventQueueCounters {
+    std::atomic<std::size_t> depth{0};        // waiting now
+    std::atomic<std::uint64_t> delivered{0};
+    std::atomic<std::uint64_t> dropped{0};    // DropOldest / DropNewest, at capacity
+    std::atomic<std::uint64_t> coalesced{0};  // replaced by a newer arrival
+    std::atomic<std::uint64_t> blocked{0};    // arrivals that waited for room
+};
+
+template <typename T>
+class EventQueue : public std::enable_shared_from_this<EventQueue<T>> {
+public:
+    using Overflow = EventQueueOptions::Overflow;
+
+    // A null `executor` gives the queue a delivery thread of its own.
+    EventQueue(EventQueueOptions options, std::function<void(const T&)> fn, Executor* executor = nullptr)
+        : m_options(options), m_fn(std::move(fn)), m_executor(executor),
+          m_counters(std::make_shared<EventQueueCounters>())
+    {
+        if (m_options.capacity == 0) m_options.capacity = executor ? static_cast<std::size_t>(-1) : 1;
+    }
+
+    EventQueue(const EventQueue&) = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+
+    // Starts the delivery thread, if the queue has one. Not in the
+    // constructor: the thread holds the queue, and there is no shared_ptr to
+    // hold until it is owned.
+    void start()
+    {
+        if (!m_executor) m_thread = std::thread([self = this->shared_from_this()] { self->run(); });
+    }
+
+    std::shared_ptr<const EventQueueCounters> counters() const { return m_counters; }
+
+    void push(const T& value)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_closed) return;
+        if (m_options.overflow == Overflow::Coalesce && !m_queue.empty()) {
+            m_queue.back() = value;
+            m_counters->coalesced.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (m_queue.size() >= m_options.capacity) {
+            Overflow overflow = m_options.overflow;
+            if (overflow == Overflow::Block && delivering()) overflow = Overflow::DropOldest;
+            switch (overflow) {
+            case Overflow::DropNewest:
+                m_counters->dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            case Overflow::Block:
+                m_counters->blocked.fetch_add(1, std::memory_order_relaxed);
+                m_room.wait(lock, [this] { return m_closed || m_queue.size() < m_options.capacity; });
+                if (m_closed) return;
+                break;
+            default:
+                m_queue.pop_front();
+                m_counters->dropped.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+        }
+        m_queue.push_back(value);
+        m_counters->depth.store(m_queue.size(), std::memory_order_relaxed);
+        if (!m_executor) {
+            m_ready.notify_one();
+        } else if (!m_scheduled) {
+            m_scheduled = true;
+            lock.unlock();
+            schedule();
+        }
+    }
+
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_closed) return;
+            m_closed = true;
+            m_queue.clear();
+            m_counters->depth.store(0, std::memory_order_relaxed);
+        }
+        m_ready.notify_all();
+        m_room.notify_all();
+        if (m_executor) {
+            // A drain still waiting for a worker finds the queue closed; one
+            // running is waited for, unless this is its listener.
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_idle.wait(lock, [this] { return !m_draining || delivering(); });
+            return;
+        }
+        if (!m_thread.joinable()) return;
+        // From the listener's own callback the call in progress is the
+        // caller's: the thread finishes it and ends on its own, holding the
+        // queue until it has.
+        if (std::this_thread::get_id() == m_thread.get_id()) m_thread.detach();
+        else m_thread.join();
+    }
+
+private:
+    // Arrivals one drain task delivers before it queues itself again.
+    static constexpr int kDrainBatch = 16;
+
+    // Whether the caller is the listener's own call. Under m_mutex.
+    bool delivering() const
+    {
+        const std::thread::id self = std::this_thread::get_id();
+        return m_executor ? m_draining && m_drainThread == self : m_deliveryThread == self;
+    }
+
+    void schedule()
+    {
+        m_executor->execute([self = this->shared_from_this()] { self->drain(); });
+    }
+
+    void drain()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_draining = true;
+        m_drainThread = std::this_thread::get_id();
+        for (int n = 0; n < kDrainBatch && !m_closed && !m_queue.empty(); ++n) {
+            T value = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_counters->depth.store(m_queue.size(), std::memory_order_relaxed);
+            m_room.notify_one();
+            lock.unlock();
+            m_fn(value);
+            m_counters->delivered.fetch_add(1, std::memory_order_relaxed);
+            lock.lock();
+        }
+        m_draining = false;
+        m_drainThread = std::thread::id();
+        m_idle.notify_all();
+        if (m_closed || m_queue.empty()) {
+            m_scheduled = false;
+            return;
+        }
+        lock.unlock();
+        schedule();
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_deliveryThread = std::this_thread::get_id();
+        for (;;) {
+            m_ready.wait(lock, [this] { return m_closed || !m_queue.empty(); });
+            if (m_closed) return;
+            T value = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_counters->depth.store(m_queue.size(), std::memory_order_relaxed);
+            m_room.notify_one();
+            lock.unlock();
+            m_fn(value);
+            m_counters->delivered.fetch_add(1, std::memory_order_relaxed);
+            lock.lock();
+        }
+    }
+
+    EventQueueOptions m_options;
+    const std::function<void(const T&)> m_fn;
+    Executor* const m_executor;
+    const std::shared_ptr<EventQueueCounters> m_counters;
+    std::mutex m_mutex;
+    std::condition_variable m_ready;  // an arrival is waiting, or closed
+    std::condition_variable m_room;   // the queue has room, or closed
+    std::deque<T> m_queue;
+    bool m_closed = false;
+    // Own thread.
+    std::thread::id m_deliveryThread;  // written once, under m_mutex
+    std::thread m_thread;
+    // Executor: a drain task is submitted or running / is running, and where.
+    bool m_scheduled = false;
+    bool m_draining = false;
+    std::thread::id m_drainThread;
+    std::condition_variable m_idle;  // a drain task finished its batch
+};
+
+} // namespace logos
+
+#endif // LOGOS_EVENT_QUEUE_H
@@ -0,0 +1,173 @@
+#ifndef LOGOS_EXECUTOR_H
+#define LOGOS_EXECUTOR_H
+
+// ---------------------------------------------------------------------------
+// logos::Executor — somewhere to run work off the calling thread — and
+// logos::ThreadPool, the one the SDK bundles.
+//
+// An event listener is called on the thread the transport delivers on, so a
+// listener that does real work holds up every other event behind it. Handing
+// the subscription an Executor moves its calls there (see
+// logos_event_queue.h): the transport only queues the arrival, and the
+// listener runs on a worker, its arrivals still one at a time and in order.
+//
+// Executor is the whole contract: execute(task) runs the task, once, some
+// time later, on some thread. A module with its own pool or event loop adapts
+// it in a few lines. ThreadPool is a fixed set of workers, and
+// ThreadPool::shared() one of them for the process.
+//
+// The pool is WORK-STEALING. Each worker has its own task deque. A task
+// submitted from a worker goes on that worker's deque, where it is likely to
+// find what the submitting task left in cache; one submitted from outside
+// goes round-robin. A worker takes the oldest task of its own deque, and one
+// with nothing left takes the newest of another's — the end its owner is not
+// working on — so a burst landing on one worker is spread over all of them
+// without a single queue every worker contends for.
+//
+// A task must not wait for another task of the same pool to run: with every
+// worker waiting, nothing would.
+//
+// Qt-FREE, std only.
+// ---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace logos {
+
+class Executor {
+public:
+    virtual ~Executor() = default;
+    virtual void execute(std::function<void()> task) = 0;
+};
+
+class ThreadPool : public Executor {
+public:
+    // 0 threads: one per hardware thread, and at least two.
+    explicit ThreadPool(unsigned threads = 0)
+    {
+        if (threads == 0) threads = std::max(2u, std::thread::hardware_concurrency());
+        for (unsigned i = 0; i < threads; ++i) m_workers.push_back(std::make_unique<Worker>());
+        for (unsigned i = 0; i < threads; ++i) m_threads.emplace_back([this, i] { run(i); });
+    }
+
+    // Runs every task already submitted, then joins the workers.
+    ~ThreadPool() override
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        for (std::thread& t : m_threads) t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // The process's pool. Never destroyed, like the client registry: a
+    // subscription let go during static destruction still finds it.
+    static ThreadPool& shared()
+    {
+        static ThreadPool* pool = new ThreadPool();
+        return *pool;
+    }
+
+    void execute(std::function<void()> task) override
+    {
+        const Current& current = currentWorker();
+        const std::size_t home = current.pool == this
+            ? current.index
+            : m_next.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+        // Counted before it is visible, so that a worker can never take a
+        // task the count does not include.
+        m_pending.fetch_add(1);
+        {
+            Worker& w = *m_workers[home];
+            std::lock_guard<std::mutex> lock(w.mutex);
+            w.tasks.push_back(std::move(task));
+        }
+        // Taking the lock orders this after a sleeping worker's check of the
+        // count, so the notification cannot fall between check and wait.
+        { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+        m_wake.notify_one();
+    }
+
+    std::size_t size() const { return m_workers.size(); }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+    struct Current {
+        const ThreadPool* pool = nullptr;
+        std::size_t index = 0;
+    };
+
+    static Current& currentWorker()
+    {
+        thread_local Current current;
+        return current;
+    }
+
+    bool take(std::size_t self, std::function<void()>& task)
+    {
+        {
+            Worker& own = *m_workers[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.front());
+                own.tasks.pop_front();
+                return true;
+            }
+        }
+        for (std::size_t i = 1; i < m_workers.size(); ++i) {
+            Worker& victim = *m_workers[(self + i) % m_workers.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.back());
+                victim.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(std::size_t self)
+    {
+        currentWorker() = Current{this, self};
+        for (;;) {
+            std::function<void()> task;
+            if (take(self, task)) {
+                m_pending.fetch_sub(1);
+                task();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_wake.wait(lock, [this] { return m_stopping || m_pending.load() > 0; });
+            if (m_stopping && m_pending.load() == 0) return;
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::thread> m_threads;
+    std::atomic<std::size_t> m_next{0};
+    std::atomic<std::int64_t> m_pending{0};  // submitted and not yet taken
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    bool m_stopping = false;
+};
+
+} // namespace logos
+
+#endif // LOGOS_EXECUTOR_H
@@ -0,0 +1,381 @@
+#ifndef LOGOS_JSON_READER_H
+#define LOGOS_JSON_READER_H
+
+// ---------------------------------------------------------------------------
+// logos::JsonReader — pull-style reading of a JSON text, without a DOM.
+//
+// The read-side counterpart of logos::ArgsWriter. A reply whose caller wants a
+// std::string, a list of strings or a record does not need an nlohmann::json
+// tree built first and then picked apart. The reader walks the text once and
+// the caller takes each value straight into its destination. Values the caller
+// does not want are skip()ped: checked, but not stored.
+//
+// It accepts exactly what nlohmann::json::parse accepts, so a reply decoded
+// here and one decoded from the DOM cannot disagree about whether it was
+// well-formed:
+//   - RFC 8259 JSON with no comments and no trailing commas;
+//   - strings must be valid UTF-8, and \u escapes must pair their
+//     surrogates;
+//   - an integer without a fraction or exponent is signed when negative and
+//     unsigned otherwise, and becomes a double only when it does not fit;
+//   - a number that overflows a double is an error.
+// The first error latches. Every later call then returns false, so a caller
+// can read optimistically and check failed() (or finish()) once at the end.
+//
+// Walking a container:
+//
+//     if (r.beginObject())
+//         while (r.nextKey(key)) { if (key == "port") r.readNumber(n); else r.skip(); }
+//
+// Every element or member must be read or skipped before the next
+// nextElement() / nextKey().
+//
+// Qt-FREE, std + nlohmann only. nlohmann is needed only by readJson().
+// ---------------------------------------------------------------------------
+
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+namespace logos {
+
+class JsonReader {
+public:
+    enum class Kind { Null, Bool, Number, String, Array, Object, Invalid };
+
+    // A number as nlohmann would store it.
+    struct Number {
+        enum { Int, UInt, Float } kind = Int;
+        std::int64_t i = 0;
+        std::uint64_t u = 0;
+        double d = 0.0;
+    };
+
+    JsonReader(const char* begin, const char* end) : m_p(begin), m_end(end) {}
+    explicit JsonReader(const std::string& text) : JsonReader(text.data(), text.data() + text.size()) {}
+    // The reader does not copy the text, so it must outlive the reader.
+    explicit JsonReader(std::string&&) = delete;
+
+    bool failed() const { return m_failed; }
+
+    // What the next value is, without consuming it. Invalid on an error or
+    // at the end of the text.
+    Kind peek()
+    {
+        if (m_failed || !skipSpace()) return Kind::Invalid;
+        switch (*m_p) {
+        case 'n': return Kind::Null;
+        case 't': case 'f': return Kind::Bool;
+        case '"': return Kind::String;
+        case '[': return Kind::Array;
+        case '{': return Kind::Object;
+        default:
+            return (*m_p == '-' || (*m_p >= '0' && *m_p <= '9')) ? Kind::Number : Kind::Invalid;
+        }
+    }
+
+    bool readNull()
+    {
+        if (peek() != Kind::Null) return fail();
+        return literal("null");
+    }
+
+    bool readBool(bool& out)
+    {
+        if (peek() != Kind::Bool) return fail();
+        out = (*m_p == 't');
+        return literal(out ? "true" : "false");
+    }
+
+    bool readNumber(Number& out)
+    {
+        if (peek() != Kind::Number) return fail();
+        const char* start = m_p;
+        bool integral = true;
+        if (*m_p == '-') ++m_p;
+        if (m_p == m_end) return fail();
+        if (*m_p == '0') {
+            ++m_p;
+        } else if (*m_p >= '1' && *m_p <= '9') {
+            while (m_p != m_end && isDigit(*m_p)) ++m_p;
+        } else {
+            return fail();
+        }
+        if (m_p != m_end && *m_p == '.') {
+            integral = false;
+            ++m_p;
+            if (m_p == m_end || !isDigit(*m_p)) return fail();
+            while (m_p != m_end && isDigit(*m_p)) ++m_p;
+        }
+        if (m_p != m_end && (*m_p == 'e' || *m_p == 'E')) {
+            integral = false;
+            ++m_p;
+            if (m_p != m_end && (*m_p == '+' || *m_p == '-')) ++m_p;
+            if (m_p == m_end || !isDigit(*m_p)) return fail();
+            while (m_p != m_end && isDigit(*m_p)) ++m_p;
+        }
+        m_opened = false;
+        if (integral) {
+            if (*start == '-') {
+                const auto r = std::from_chars(start, m_p, out.i);
+                if (r.ec == std::errc() && r.ptr == m_p) { out.kind = Number::Int; return true; }
+            } else {
+                const auto r = std::from_chars(start, m_p, out.u);
+                if (r.ec == std::errc() && r.ptr == m_p) { out.kind = Number::UInt; return true; }
+            }
+        }
+        // strtod needs a terminated string; a number is short, so copy it.
+        const std::string digits(start, m_p);
+        char* parsedEnd = nullptr;
+        errno = 0;
+        out.d = std::strtod(digits.c_str(), &parsedEnd);
+        if (parsedEnd != digits.c_str() + digits.size() || !std::isfinite(out.d)) return fail();
+        out.kind = Number::Float;
+        return true;
+    }
+
+    bool readString(std::string& out)
+    {
+        if (peek() != Kind::String) return fail();
+        out.clear();
+        ++m_p;
+        const char* run = m_p;
+        while (true) {
+            if (m_p == m_end) return fail();
+            const unsigned char c = static_cast<unsigned char>(*m_p);
+            if (c == '"') break;
+            if (c < 0x20) return fail();
+            if (c == '\\') {
+                out.append(run, m_p);
+                if (!unescape(out)) return fail();
+                run = m_p;
+                continue;
+            }
+            if (c < 0x80) { ++m_p; continue; }
+            if (!skipUtf8()) return fail();
+        }
+        out.append(run, m_p);
+        ++m_p;
+        m_opened = false;
+        return true;
+    }
+
+    // ── Containers ─────────────────────────────────────────────────────────
+
+    bool beginArray()
+    {
+        if (peek() != Kind::Array) return fail();
+        ++m_p;
+        m_opened = true;
+        return true;
+    }
+
+    // True when another element follows; false at the closing `]`, which it
+    // consumes, and on an error.
+    bool nextElement() { return next(']'); }
+
+    bool beginObject()
+    {
+        if (peek() != Kind::Object) return fail();
+        ++m_p;
+        m_opened = true;
+        return true;
+    }
+
+    // Reads the next member's key, and its colon, into `key`. False at the
+    // closing `}`, which it consumes, and on an error.
+    bool nextKey(std::string& key)
+    {
+        if (!next('}')) return false;
+        if (!readString(key) || !skipSpace() || *m_p != ':') return fail();
+        ++m_p;
+        return true;
+    }
+
+    // ── Skipping ───────────────────────────────────────────────────────────
+
+    // Consumes the next value, checking it as strictly as reading it would.
+    bool skip()
+    {
+        switch (peek()) {
+        case Kind::Null: return readNull();
+        case Kind::Bool: { bool b; return readBool(b); }
+        case Kind::Number: { Number n; return readNumber(n); }
+        case Kind::String: { std::string s; return readString(s); }
+        case Kind::Array:
+            if (!beginArray()) return false;
+            while (nextElement())
+                if (!skip()) return false;
+            return !m_failed;
+        case Kind::Object: {
+            if (!beginObject()) return false;
+            std::string key;
+            while (nextKey(key))
+                if (!skip()) return false;
+            return !m_failed;
+        }
+        case Kind::Invalid: break;
+        }
+        return fail();
+    }
+
+    // The next value as a DOM, for a caller that does want one: an `any`
+    // member of an otherwise typed record.
+    bool readJson(nlohmann::json& out)
+    {
+        if (!skipSpace()) return fail();
+        const char* start = m_p;
+        if (!skip()) return false;
+        out = nlohmann::json::parse(start, m_p, nullptr, /*allow_exceptions=*/false);
+        return !out.is_discarded() || fail();
+    }
+
+    // True when the text held exactly one well-formed value and all of it was
+    // consumed, with only whitespace after it.
+    bool finish()
+    {
+        if (m_failed) return false;
+        skipSpace();
+        return m_p == m_end || fail();
+    }
+
+private:
+    static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+    bool fail()
+    {
+        m_failed = true;
+        return false;
+    }
+
+    // False at the end of the text.
+    bool skipSpace()
+    {
+        while (m_p != m_end && (*m_p == ' ' || *m_p == '\t' || *m_p == '\n' || *m_p == '\r')) ++m_p;
+        return m_p != m_end;
+    }
+
+    bool literal(const char* word)
+    {
+        for (; *word; ++word, ++m_p)
+            if (m_p == m_end || *m_p != *word) return fail();
+        m_opened = false;
+        return true;
+    }
+
+    // One flag is enough to tell "just after the bracket" from "after an
+    // element": opening a nested container sets it, and reading anything
+    // clears it, so it is only ever set for the innermost open container.
+    bool next(char close)
+    {
+        if (m_failed || !skipSpace()) return fail();
+        if (*m_p == close) {
+            ++m_p;
+            m_opened = false;
+            return false;
+        }
+        if (m_opened) {
+            m_opened = false;
+            return true;
+        }
+        if (*m_p != ',') return fail();
+        ++m_p;
+        return true;
+    }
+
+    // At a backslash inside a string: appends what it stands for.
+    bool unescape(std::string& out)
+    {
+        if (++m_p == m_end) return false;
+        const char c = *m_p++;
+        switch (c) {
+        case '"': out.push_back('"'); return true;
+        case '\\': out.push_back('\\'); return true;
+        case '/': out.push_back('/'); return true;
+        case 'b': out.push_back('\b'); return true;
+        case 'f': out.push_back('\f'); return true;
+        case 'n': out.push_back('\n'); return true;
+        case 'r': out.push_back('\r'); return true;
+        case 't': out.push_back('\t'); return true;
+        case 'u': break;
+        default: return false;
+        }
+        std::uint32_t cp = 0;
+        if (!hex4(cp)) return false;
+        if (cp >= 0xDC00 && cp <= 0xDFFF) return false;
+        if (cp >= 0xD800 && cp <= 0xDBFF) {
+            std::uint32_t low = 0;
+            if (m_end - m_p < 2 || m_p[0] != '\\' || m_p[1] != 'u') return false;
+            m_p += 2;
+            if (!hex4(low) || low < 0xDC00 || low > 0xDFFF) return false;
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+        }
+        if (cp < 0x80) {
+            out.push_back(static_cast<char>(cp));
+        } else if (cp < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+        return true;
+    }
+
+    bool hex4(std::uint32_t& out)
+    {
+        if (m_end - m_p < 4) return false;
+        for (int i = 0; i < 4; ++i, ++m_p) {
+            const char c = *m_p;
+            out <<= 4;
+            if (c >= '0' && c <= '9') out |= std::uint32_t(c - '0');
+            else if (c >= 'a' && c <= 'f') out |= std::uint32_t(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') out |= std::uint32_t(c - 'A' + 10);
+            else return false;
+        }
+        return true;
+    }
+
+    // One multi-byte UTF-8 sequence, by the table in RFC 3629 §4: no
+    // overlong forms, no surrogates, nothing past U+10FFFF.
+    bool skipUtf8()
+    {
+        const auto byte = [this](std::ptrdiff_t i) {
+            return static_cast<unsigned char>(m_p[i]);
+        };
+        const auto cont = [&](std::ptrdiff_t i, unsigned char lo = 0x80, unsigned char hi = 0xBF) {
+            return m_end - m_p > i && byte(i) >= lo && byte(i) <= hi;
+        };
+        const unsigned char c = byte(0);
+        int len = 0;
+        if (c >= 0xC2 && c <= 0xDF)      len = cont(1) ? 2 : 0;
+        else if (c == 0xE0)              len = cont(1, 0xA0) && cont(2) ? 3 : 0;
+        else if (c == 0xED)              len = cont(1, 0x80, 0x9F) && cont(2) ? 3 : 0;
+        else if (c >= 0xE1 && c <= 0xEF) len = cont(1) && cont(2) ? 3 : 0;
+        else if (c == 0xF0)              len = cont(1, 0x90) && cont(2) && cont(3) ? 4 : 0;
+        else if (c >= 0xF1 && c <= 0xF3) len = cont(1) && cont(2) && cont(3) ? 4 : 0;
+        else if (c == 0xF4)              len = cont(1, 0x80, 0x8F) && cont(2) && cont(3) ? 4 : 0;
+        m_p += len;
+        return len != 0;
+    }
+
+    const char* m_p;
+    const char* m_end;
+    bool m_failed = false;
+    bool m_opened = false;
+};
+
+} // namespace logos
+
+#endif // LOGOS_JSON_READER_H
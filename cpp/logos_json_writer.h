@@ -0,0 +1,329 @@
+#ifndef LOGOS_JSON_WRITER_H
+#define LOGOS_JSON_WRITER_H
+
+// ---------------------------------------------------------------------------
+// logos::detail::JsonWriter — JSON written straight as text, without a DOM.
+//
+// The shared half of logos::ArgsWriter (a call's arguments, logos_args_writer.h)
+// and logos::ReplyWriter (a cdylib dispatch's reply, logos_reply_buffer.h).
+// Both exist because building an nlohmann::json only to dump() it costs as much
+// again as the text: each value is appended to the text as it is written.
+//
+// The text is what `json.dump()` would have produced for the same values:
+//   - strings are escaped as nlohmann escapes them (UTF-8 passes through);
+//   - a string that is not valid UTF-8 (RFC 3629, as logos::JsonReader
+//     checks it) throws the nlohmann::json::type_error 316 that dump()
+//     throws, rather than becoming text no reader could parse;
+//   - doubles are laid out as nlohmann lays them out, so 1.0 stays `1.0`,
+//     1e300 is `1e+300`, and NaN and infinity are `null`. The digits are the
+//     shortest that round-trip (std::to_chars). On the odd value nlohmann's
+//     Grisu2 spells with other digits the text differs, but never the double
+//     it reads back as;
+//   - bytes take the canonical `{"_bytes":"<base64url, unpadded>"}` form.
+// The writer does not order an object's keys; its caller writes them in the
+// order it wants them.
+//
+// Records and maps are written with beginObject()/key()/endObject(), and
+// lists with beginArray()/endArray(); commas are the writer's job.
+//
+// `Derived` is the concrete writer, which every method returns for chaining.
+// `Text` is where the bytes go: anything with std::string's push_back,
+// append(const char*, size_t), reserve and size.
+//
+// Qt-FREE, std + nlohmann only.
+// ---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace logos {
+namespace detail {
+
+template <typename Derived, typename Text>
+class JsonWriter {
+public:
+    // ── Values ─────────────────────────────────────────────────────────────
+
+    Derived& value(bool v)
+    {
+        separate();
+        put(v ? "true" : "false");
+        return self();
+    }
+
+    template <typename T,
+              std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+    Derived& value(T v)
+    {
+        separate();
+        char digits[24];
+        const auto res = std::to_chars(digits, digits + sizeof digits, v);
+        m_buf.append(digits, static_cast<std::size_t>(res.ptr - digits));
+        return self();
+    }
+
+    Derived& value(double v)
+    {
+        separate();
+        appendDouble(v);
+        return self();
+    }
+
+    Derived& value(const std::string& v)
+    {
+        separate();
+        appendString(v.data(), v.size());
+        return self();
+    }
+
+    Derived& value(const char* v)
+    {
+        separate();
+        appendString(v, std::char_traits<char>::length(v));
+        return self();
+    }
+
+    Derived& value(const std::vector<std::string>& v)
+    {
+        beginArray();
+        for (const std::string& s : v) value(s);
+        return endArray();
+    }
+
+    // Anything already held as JSON — `any`, LogosMap, LogosList. Walked
+    // value by value into the text, in the DOM's own (sorted) key order, so no
+    // dump() string is built on the way.
+    Derived& value(const nlohmann::json& v)
+    {
+        switch (v.type()) {
+        case nlohmann::json::value_t::object:
+            beginObject();
+            for (auto it = v.begin(); it != v.end(); ++it) {
+                key(it.key());
+                value(it.value());
+            }
+            return endObject();
+        case nlohmann::json::value_t::array:
+            beginArray();
+            for (const nlohmann::json& element : v) value(element);
+            return endArray();
+        case nlohmann::json::value_t::string:
+            return value(v.get_ref<const std::string&>());
+        case nlohmann::json::value_t::boolean:
+            return value(v.get<bool>());
+        case nlohmann::json::value_t::number_integer:
+            return value(v.get<std::int64_t>());
+        case nlohmann::json::value_t::number_unsigned:
+            return value(v.get<std::uint64_t>());
+        case nlohmann::json::value_t::number_float:
+            return value(v.get<double>());
+        case nlohmann::json::value_t::null:
+            return null();
+        default:
+            // binary and discarded: nothing a contract carries, so dump()
+            // keeps their spelling.
+            separate();
+            put(v.dump());
+            return self();
+        }
+    }
+
+    // An empty optional. Not value(nullptr), which would pick the const char*
+    // overload.
+    Derived& null()
+    {
+        separate();
+        put("null");
+        return self();
+    }
+
+    // The canonical tagged form, as logos::bytesToJson writes it. Not value():
+    // a std::vector<uint8_t> is also a list of numbers, and which one the
+    // caller means is the contract's call, not an overload's.
+    Derived& bytes(const std::vector<std::uint8_t>& v)
+    {
+        static const char kAlphabet[] =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+        separate();
+        put("{\"_bytes\":\"");
+        m_buf.reserve(m_buf.size() + (v.size() + 2) / 3 * 4 + 2);
+        std::size_t i = 0;
+        for (; i + 3 <= v.size(); i += 3) {
+            const std::uint32_t n = (std::uint32_t(v[i]) << 16) | (std::uint32_t(v[i + 1]) << 8) | v[i + 2];
+            m_buf.push_back(kAlphabet[(n >> 18) & 63]);
+            m_buf.push_back(kAlphabet[(n >> 12) & 63]);
+            m_buf.push_back(kAlphabet[(n >> 6) & 63]);
+            m_buf.push_back(kAlphabet[n & 63]);
+        }
+        if (i < v.size()) {
+            std::uint32_t n = std::uint32_t(v[i]) << 16;
+            if (i + 1 < v.size()) n |= std::uint32_t(v[i + 1]) << 8;
+            m_buf.push_back(kAlphabet[(n >> 18) & 63]);
+            m_buf.push_back(kAlphabet[(n >> 12) & 63]);
+            if (i + 1 < v.size()) m_buf.push_back(kAlphabet[(n >> 6) & 63]);
+        }
+        put("\"}");
+        return self();
+    }
+
+    // ── Structure ──────────────────────────────────────────────────────────
+
+    Derived& beginArray()  { separate(); m_buf.push_back('['); m_first = true; return self(); }
+    Derived& endArray()    { m_buf.push_back(']'); m_first = false; return self(); }
+    Derived& beginObject() { separate(); m_buf.push_back('{'); m_first = true; return self(); }
+    Derived& endObject()   { m_buf.push_back('}'); m_first = false; return self(); }
+
+    // The next value is this member's.
+    Derived& key(const std::string& k) { return writeKey(k.data(), k.size()); }
+    Derived& key(const char* k) { return writeKey(k, std::char_traits<char>::length(k)); }
+
+protected:
+    JsonWriter() = default;
+    ~JsonWriter() = default;
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    Text m_buf;
+    bool m_first = true;
+
+private:
+    Derived& self() { return static_cast<Derived&>(*this); }
+
+    void put(const char* s) { m_buf.append(s, std::char_traits<char>::length(s)); }
+    void put(const std::string& s) { m_buf.append(s.data(), s.size()); }
+
+    void separate()
+    {
+        if (!m_first) m_buf.push_back(',');
+        m_first = false;
+    }
+
+    Derived& writeKey(const char* k, std::size_t n)
+    {
+        separate();
+        appendString(k, n);
+        m_buf.push_back(':');
+        m_first = true;
+        return self();
+    }
+
+    // nlohmann's layout for a double: plain decimal while the point falls
+    // within 15 digits of the first one, with `.0` on an integral value, and
+    // `d.ddde±XX` beyond that; NaN and infinity are `null`. The digits are the
+    // shortest that read back as the same double.
+    void appendDouble(double v)
+    {
+        if (!std::isfinite(v)) {
+            put("null");
+            return;
+        }
+        if (std::signbit(v)) {
+            m_buf.push_back('-');
+            v = -v;
+        }
+        if (v == 0) {
+            put("0.0");
+            return;
+        }
+        char sci[32];
+        char* const end = std::to_chars(sci, sci + sizeof sci, v, std::chars_format::scientific).ptr;
+        const char* const e = std::find(sci, end, 'e');
+        char digits[20];
+        int count = 0;
+        for (const char* p = sci; p < e; ++p)
+            if (*p != '.') digits[count++] = *p;
+        int exponent = 0;
+        std::from_chars(e + (e[1] == '+' ? 2 : 1), end, exponent);
+        const int point = exponent + 1;  // digits before the decimal point
+        if (count <= point && point <= 15) {
+            m_buf.append(digits, static_cast<std::size_t>(count));
+            for (int i = count; i < point; ++i) m_buf.push_back('0');
+            put(".0");
+        } else if (0 < point && point <= 15) {
+            m_buf.append(digits, static_cast<std::size_t>(point));
+            m_buf.push_back('.');
+            m_buf.append(digits + point, static_cast<std::size_t>(count - point));
+        } else if (-4 < point && point <= 0) {
+            put("0.");
+            for (int i = point; i < 0; ++i) m_buf.push_back('0');
+            m_buf.append(digits, static_cast<std::size_t>(count));
+        } else {
+            m_buf.append(sci, static_cast<std::size_t>(end - sci));
+        }
+    }
+
+    // The length of the UTF-8 sequence at `p`, of at most `left` bytes; 0
+    // when it is not one. The same table as JsonReader's: no overlongs, no
+    // surrogates, nothing past U+10FFFF.
+    static std::size_t utf8Length(const unsigned char* p, std::size_t left)
+    {
+        const auto cont = [&](std::size_t i, unsigned char lo = 0x80, unsigned char hi = 0xBF) {
+            return left > i && p[i] >= lo && p[i] <= hi;
+        };
+        const unsigned char c = p[0];
+        if (c >= 0xC2 && c <= 0xDF) return cont(1) ? 2 : 0;
+        if (c == 0xE0)              return cont(1, 0xA0) && cont(2) ? 3 : 0;
+        if (c == 0xED)              return cont(1, 0x80, 0x9F) && cont(2) ? 3 : 0;
+        if (c >= 0xE1 && c <= 0xEF) return cont(1) && cont(2) ? 3 : 0;
+        if (c == 0xF0)              return cont(1, 0x90) && cont(2) && cont(3) ? 4 : 0;
+        if (c >= 0xF1 && c <= 0xF3) return cont(1) && cont(2) && cont(3) ? 4 : 0;
+        if (c == 0xF4)              return cont(1, 0x80, 0x8F) && cont(2) && cont(3) ? 4 : 0;
+        return 0;
+    }
+
+    // nlohmann's escaping with ensure_ascii off: the quote, the backslash and
+    // the C0 controls, with the short forms where JSON has them.
+    void appendString(const char* s, std::size_t n)
+    {
+        static const char kHex[] = "0123456789abcdef";
+        m_buf.reserve(m_buf.size() + n + 2);
+        m_buf.push_back('"');
+        std::size_t run = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const unsigned char c = static_cast<unsigned char>(s[i]);
+            if (c >= 0x80) {
+                const std::size_t len = utf8Length(reinterpret_cast<const unsigned char*>(s) + i, n - i);
+                // dump() itself raises the error, so its type, id and message
+                // are exactly what a caller of dump() would have caught.
+                if (len == 0) {
+                    (void)nlohmann::json(std::string(s, n)).dump();
+                    continue;  // not reached: the two tables agree
+                }
+                i += len - 1;
+                continue;
+            }
+            if (c >= 0x20 && c != '"' && c != '\\') continue;
+            m_buf.append(s + run, i - run);
+            run = i + 1;
+            m_buf.push_back('\\');
+            switch (c) {
+            case '"':  m_buf.push_back('"'); break;
+            case '\\': m_buf.push_back('\\'); break;
+            case '\b': m_buf.push_back('b'); break;
+            case '\f': m_buf.push_back('f'); break;
+            case '\n': m_buf.push_back('n'); break;
+            case '\r': m_buf.push_back('r'); break;
+            case '\t': m_buf.push_back('t'); break;
+            default:
+                put("u00");
+                m_buf.push_back(kHex[c >> 4]);
+                m_buf.push_back(kHex[c & 15]);
+            }
+        }
+        m_buf.append(s + run, n - run);
+        m_buf.push_back('"');
+    }
+};
+
+}  // namespace detail
+}  // namespace logos
+
+#endif // LOGOS_JSON_WRITER_H
@@ -10,15 +10,28 @@
 // translation units.
 //
 // The generated `<Dep>` wrappers (ApiStyle::Lp) hold a `logos::LpClient` and
-// marshal std args -> nlohmann JSON -> lp_invoke -> JSON -> std return. Event
+// marshal std args -> JSON text (logos::ArgsWriter) -> lp_invoke -> JSON text
+// read straight into the std return (logos::LpReply). Event
 // subscriptions go through lp_subscribe and are owned by an RAII
 // `LpSubscription` (mirrors rust-sdk's EventSubscription: unsubscribes on
 // destruction so the callback never fires after the owner is gone).
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <cstring>
 #include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <set>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <utility>
 
 #include <nlohmann/json.hpp>
@@ -27,9 +40,20 @@
 
 #include "logos_protocol.h"     // lp_* C ABI
 #include "logos_call_error.h"   // logos::CallError
+#include "logos_async_result.h" // logos::AsyncResult
+#include "logos_task.h"         // LOGOS_HAS_COROUTINES, logos::Task
 #include "logos_json.h"         // LogosMap / LogosList aliases
 #include "logos_codec.h"        // logos::bytesToJson, b64UrlDecode, isTaggedBytes
 #include "logos_result.h"       // StdLogosResult
+#include "logos_result_cache.h" // logos::ResultCache
+#include "logos_single_flight.h" // logos::SingleFlight
+#include "logos_args_writer.h"   // logos::ArgsWriter
+#include "logos_json_reader.h"   // logos::JsonReader
+#include "logos_cancellation.h"  // logos::CancellationToken
+#include "logos_concurrency_limit.h" // logos::ConcurrencyLimiter
+#include "logos_event_filter.h"  // logos::EventFilter
+#include "logos_event_queue.h"   // logos::EventQueue
+#include "logos_executor.h"      // logos::Executor, logos::ThreadPool
 
 namespace logos {
 
@@ -67,14 +91,209 @@ inline StdLogosResult jsonToStdResult(const nlohmann::json& j) {
     return r;
 }
 
+// The same decoders, read straight off the reply text (see LpReply). Each one
+// consumes exactly one value and always assigns: what the json decoder above,
+// or the generated wrapper's inline one, would have produced from that value,
+// mismatch defaults included. A number is narrowed exactly as
+// nlohmann::json::get narrows it.
+inline void readLenient(JsonReader& r, std::string& out) {
+    out.clear();
+    if (r.peek() == JsonReader::Kind::String) r.readString(out);
+    else r.skip();
+}
+
+inline void readLenient(JsonReader& r, int64_t& out) {
+    out = 0;
+    JsonReader::Number n;
+    if (r.peek() != JsonReader::Kind::Number) { r.skip(); return; }
+    if (!r.readNumber(n)) return;
+    if (n.kind == JsonReader::Number::Int)       out = n.i;
+    else if (n.kind == JsonReader::Number::UInt) out = static_cast<int64_t>(n.u);
+    else                                         out = static_cast<int64_t>(n.d);
+}
+
+inline void readLenient(JsonReader& r, uint64_t& out) {
+    out = 0;
+    JsonReader::Number n;
+    if (r.peek() != JsonReader::Kind::Number) { r.skip(); return; }
+    if (!r.readNumber(n)) return;
+    if (n.kind == JsonReader::Number::Int)       out = static_cast<uint64_t>(n.i);
+    else if (n.kind == JsonReader::Number::UInt) out = n.u;
+    else                                         out = static_cast<uint64_t>(n.d);
+}
+
+inline void readLenient(JsonReader& r, double& out) {
+    out = 0.0;
+    JsonReader::Number n;
+    if (r.peek() != JsonReader::Kind::Number) { r.skip(); return; }
+    if (!r.readNumber(n)) return;
+    if (n.kind == JsonReader::Number::Int)       out = static_cast<double>(n.i);
+    else if (n.kind == JsonReader::Number::UInt) out = static_cast<double>(n.u);
+    else                                         out = n.d;
+}
+
+inline void readLenient(JsonReader& r, bool& out) {
+    out = false;
+    if (r.peek() == JsonReader::Kind::Bool) r.readBool(out);
+    else r.skip();
+}
+
+inline void readLenient(JsonReader& r, std::vector<std::string>& out) {
+    out.clear();
+    if (r.peek() != JsonReader::Kind::Array) { r.skip(); return; }
+    r.beginArray();
+    while (r.nextElement()) {
+        if (r.peek() != JsonReader::Kind::String) { r.skip(); continue; }
+        out.emplace_back();
+        r.readString(out.back());
+    }
+}
+
+// jsonToBytes: an object whose only key is "_bytes", holding a string. A
+// repeated key is decided by its last value, as the json parser decides it.
+inline void readLenient(JsonReader& r, std::vector<uint8_t>& out) {
+    out.clear();
+    if (r.peek() != JsonReader::Kind::Object) { r.skip(); return; }
+    r.beginObject();
+    std::string key, encoded;
+    bool tagged = false, other = false;
+    while (r.nextKey(key)) {
+        if (key != "_bytes") { other = true; r.skip(); continue; }
+        tagged = (r.peek() == JsonReader::Kind::String);
+        if (tagged) r.readString(encoded);
+        else r.skip();
+    }
+    if (tagged && !other && !r.failed()) out = b64UrlDecode(encoded);
+}
+
+// A blocking call's reply, still as the text the transport returned.
+//
+// LpClient::invoke parses every reply into an nlohmann::json, and the
+// generated wrapper then copies what it wants out of that tree: a
+// std::vector<std::string> or a list of records is built twice, once as
+// json nodes and once as the value the caller asked for. LpReply holds the
+// text instead. as<T>() and read<T>() decode it with a JsonReader straight
+// into the destination, and json() is there, parsed on first use, for the
+// shapes that are json anyway (LogosMap, `any`) and for the rejection check.
+//
+// The decoders match the json ones exactly, malformed text included: text
+// that would not have parsed yields the default value, whole, never a value
+// decoded up to the point where the text went wrong.
+//
+// A reply that came out of the result cache or a joined flight was already
+// a json value. It is held as one, and dumped to text if it is read.
+//
+// Move-only, and not thread-safe: it belongs to the call that made it.
+class LpReply {
+public:
+    LpReply() = default;
+    explicit LpReply(nlohmann::json value) : m_json(std::move(value)), m_parsed(true) {}
+
+    // Takes ownership of an lp_invoke result string (null for "no result").
+    static LpReply adopt(char* text) {
+        LpReply reply;
+        reply.m_raw.reset(text);
+        return reply;
+    }
+
+    LpReply(LpReply&&) = default;
+    LpReply& operator=(LpReply&&) = default;
+
+    // The reply as json: null when there was none or it did not parse.
+    const nlohmann::json& json() const {
+        if (!m_parsed) {
+            m_parsed = true;
+            if (m_raw) {
+                auto parsed = nlohmann::json::parse(m_raw.get(), nullptr, /*allow_exceptions=*/false);
+                if (!parsed.is_discarded()) m_json = std::move(parsed);
+            }
+        }
+        return m_json;
+    }
+
+    nlohmann::json takeJson() && {
+        json();
+        return std::move(m_json);
+    }
+
+    // One of the types readLenient decodes: as<std::string>(), as<bool>() …
+    template <typename T>
+    T as() const {
+        return read<T>([](JsonReader& r, T& out) { readLenient(r, out); });
+    }
+
+    // Anything else: `fn(JsonReader&, T&)` reads one value into a T that
+    // starts value-initialized. A T{} comes back if the text is not exactly
+    // one well-formed value.
+    template <typename T, typename Read>
+    T read(Read&& fn) const {
+        T out{};
+        JsonReader r = reader();
+        fn(r, out);
+        if (!r.finish()) return T{};
+        return out;
+    }
+
+    // False for anything that cannot be the {code, message, origin}
+    // rejection object, without parsing the reply: most replies are ruled
+    // out by their first character or their first key. True does not mean
+    // it is one, only that json() has to be asked.
+    bool mayBeRejection() const {
+        if (m_parsed && !m_raw) {
+            if (!m_json.is_object() || m_json.size() != 3) return false;
+            for (const char* key : {"code", "message", "origin"}) {
+                auto it = m_json.find(key);
+                if (it == m_json.end() || !it->is_string()) return false;
+            }
+            return true;
+        }
+        JsonReader r = reader();
+        if (!r.beginObject()) return false;
+        std::string key;
+        bool code = false, message = false, origin = false;
+        while (r.nextKey(key)) {
+            bool* slot = key == "code" ? &code : key == "message" ? &message
+                       : key == "origin" ? &origin : nullptr;
+            if (!slot) return false;
+            *slot = (r.peek() == JsonReader::Kind::String);
+            r.skip();
+        }
+        return !r.failed() && code && message && origin;
+    }
+
+private:
+    struct Free {
+        void operator()(char* p) const { lp_string_free(p); }
+    };
+
+    JsonReader reader() const {
+        if (m_raw) return JsonReader(m_raw.get(), m_raw.get() + std::char_traits<char>::length(m_raw.get()));
+        if (m_dumped.empty() && !m_json.is_null()) m_dumped = m_json.dump();
+        // A null json: empty text, which reads as malformed, which decodes to
+        // the default — what decoding a null does too.
+        return JsonReader(m_dumped);
+    }
+
+    std::unique_ptr<char, Free> m_raw;
+    mutable nlohmann::json m_json;
+    mutable bool m_parsed = false;
+    mutable std::string m_dumped;
+};
+
 // RAII handle for an lp_subscription. Owns the subscription and the heap
 // callback box; unsubscribes (after which no further callbacks fire) and
 // frees the box on destruction. Move-only.
+//
+// What LpClient::subscribe returns is one LISTENER on a subscription it
+// shares with the client's other listeners for the event: `sub` is then null
+// and the deleter takes the listener off, with the same guarantee. A listener
+// subscribed with a queue (logos_event_queue.h) also carries its counters.
 class LpSubscription {
 public:
     LpSubscription() = default;
-    LpSubscription(lp_subscription* sub, void* cbBox, void (*deleter)(void*))
-        : m_sub(sub), m_cbBox(cbBox), m_deleter(deleter) {}
+    LpSubscription(lp_subscription* sub, void* cbBox, void (*deleter)(void*),
+                   std::shared_ptr<const EventQueueCounters> counters = nullptr)
+        : m_sub(sub), m_cbBox(cbBox), m_deleter(deleter), m_counters(std::move(counters)) {}
 
     LpSubscription(LpSubscription&& o) noexcept { moveFrom(o); }
     LpSubscription& operator=(LpSubscription&& o) noexcept {
@@ -85,11 +304,16 @@ public:
     LpSubscription& operator=(const LpSubscription&) = delete;
     ~LpSubscription() { reset(); }
 
-    bool valid() const { return m_sub != nullptr; }
+    bool valid() const { return m_sub != nullptr || m_cbBox != nullptr; }
+
+    // The listener's queue counters; null when it has no queue. They stay
+    // readable for as long as this handle is held.
+    const EventQueueCounters* queueCounters() const { return m_counters.get(); }
 
 private:
     void moveFrom(LpSubscription& o) {
         m_sub = o.m_sub; m_cbBox = o.m_cbBox; m_deleter = o.m_deleter;
+        m_counters = std::move(o.m_counters);
         o.m_sub = nullptr; o.m_cbBox = nullptr; o.m_deleter = nullptr;
     }
     void reset() {
@@ -99,19 +323,717 @@ private:
     lp_subscription* m_sub = nullptr;
     void* m_cbBox = nullptr;
     void (*m_deleter)(void*) = nullptr;
+    std::shared_ptr<const EventQueueCounters> m_counters;
+};
+
+namespace detail {
+
+// The per-call completion state of an lp_invoke_async, without the allocator.
+//
+// Each async call used to cost a `new std::function` box, plus whatever that
+// std::function allocated for a capture too big for its own small buffer (the
+// generated wrappers' adapters always were: they capture the user's
+// std::function). At a high call rate that is two malloc/free pairs per call,
+// with each free on the transport's thread, not the caller's.
+//
+// A CompletionSlot stores the callable IN PLACE when it fits in kInline bytes,
+// and slots are recycled through a process-wide pool, so a steady stream
+// of calls with small callbacks allocates nothing once the pool is warm. A
+// callable that does not fit is boxed on the heap as before. The pool is
+// process-wide rather than per-client because a completion may land after the
+// LpClient that issued it is gone.
+class CompletionSlot {
+public:
+    static constexpr std::size_t kInline = 64;
+
+    // Runs the stored callable with the C ABI's (ok, json) pair, destroys it,
+    // and returns the slot to the pool. Exactly once per slot.
+    static void trampoline(int ok, const char* json, void* ud) {
+        auto* slot = static_cast<CompletionSlot*>(ud);
+        slot->m_run(slot, ok, json);
+    }
+
+    template <typename F>
+    static CompletionSlot* make(F&& f);
+
+private:
+    template <typename D>
+    static void runInline(CompletionSlot* slot, int ok, const char* json) {
+        D* fn = std::launder(reinterpret_cast<D*>(slot->m_storage));
+        (*fn)(ok, json);
+        fn->~D();
+        release(slot);
+    }
+
+    template <typename D>
+    static void runBoxed(CompletionSlot* slot, int ok, const char* json) {
+        D* fn = *std::launder(reinterpret_cast<D**>(slot->m_storage));
+        (*fn)(ok, json);
+        delete fn;
+        release(slot);
+    }
+
+    static void release(CompletionSlot* slot);
+
+    friend class CompletionPool;
+    alignas(std::max_align_t) unsigned char m_storage[kInline];
+    void (*m_run)(CompletionSlot*, int, const char*) = nullptr;
+    CompletionSlot* m_next = nullptr;
+};
+
+// Slots are acquired on the threads that issue calls and released on the
+// transport's, so one shared free list would have every call take the same
+// mutex twice, from both sides. Each thread instead keeps a few free slots of
+// its own, and the shared list only rebalances between them, a batch at a
+// time: a thread that runs out takes a batch from it, and one that holds too
+// many hands a batch back. In the steady state a caller takes the lock once
+// per kBatch calls, and so does the transport.
+class CompletionPool {
+public:
+    // Free slots kept for reuse in the shared list. Beyond this a released
+    // slot is freed, so a burst does not pin its peak forever.
+    static constexpr std::size_t kMaxCached = 1024;
+    // Slots moved between a thread's cache and the shared list at a time, and
+    // the most a thread keeps before it hands a batch back.
+    static constexpr std::size_t kBatch = 32;
+    static constexpr std::size_t kMaxLocal = 2 * kBatch;
+
+    static CompletionPool& instance() {
+        // Never destroyed: a completion may still arrive during static
+        // destruction, and it must find the pool there.
+        static CompletionPool* pool = new CompletionPool;
+        return *pool;
+    }
+
+    CompletionSlot* acquire() {
+        Local& local = cache();
+        if (!local.free && !local.gone) refill(local);
+        if (CompletionSlot* slot = local.free) {
+            local.free = slot->m_next;
+            --local.count;
+            return slot;
+        }
+        return new CompletionSlot;
+    }
+
+    void release(CompletionSlot* slot) {
+        Local& local = cache();
+        if (local.gone) {
+            // The thread is exiting and its cache has been handed back.
+            slot->m_next = nullptr;
+            giveBack(slot);
+            return;
+        }
+        slot->m_next = local.free;
+        local.free = slot;
+        if (++local.count > kMaxLocal) {
+            // Keeps the slots most recently touched; the rest go back.
+            CompletionSlot* last = local.free;
+            for (std::size_t i = 1; i < kMaxLocal - kBatch; ++i) last = last->m_next;
+            CompletionSlot* batch = last->m_next;
+            last->m_next = nullptr;
+            giveBack(batch);
+            local.count = kMaxLocal - kBatch;
+        }
+    }
+
+private:
+    // A thread's own free slots. Trivially destructible, so it can still be
+    // read after the thread's Flush has run; `gone` then sends every slot
+    // straight to the shared list.
+    struct Local {
+        CompletionSlot* free = nullptr;
+        std::size_t count = 0;
+        bool gone = false;
+    };
+    // Hands the thread's slots back when it exits, so a thread that issued a
+    // burst and ended does not take them with it.
+    struct Flush {
+        Local& local;
+        ~Flush() {
+            local.gone = true;
+            if (local.free) CompletionPool::instance().giveBack(local.free);
+            local.free = nullptr;
+            local.count = 0;
+        }
+    };
+
+    static Local& cache() {
+        thread_local Local local;
+        thread_local Flush flush{local};
+        (void)flush;
+        return local;
+    }
+
+    void refill(Local& local) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        while (m_free && local.count < kBatch) {
+            CompletionSlot* slot = m_free;
+            m_free = slot->m_next;
+            --m_cached;
+            slot->m_next = local.free;
+            local.free = slot;
+            ++local.count;
+        }
+    }
+
+    // Takes a null-terminated chain of slots into the shared list, and frees
+    // what does not fit under kMaxCached.
+    void giveBack(CompletionSlot* chain) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            while (chain && m_cached < kMaxCached) {
+                CompletionSlot* slot = chain;
+                chain = slot->m_next;
+                slot->m_next = m_free;
+                m_free = slot;
+                ++m_cached;
+            }
+        }
+        while (chain) {
+            CompletionSlot* slot = chain;
+            chain = slot->m_next;
+            delete slot;
+        }
+    }
+
+    std::mutex m_mutex;
+    CompletionSlot* m_free = nullptr;
+    std::size_t m_cached = 0;
+};
+
+template <typename F>
+CompletionSlot* CompletionSlot::make(F&& f) {
+    using D = std::decay_t<F>;
+    CompletionSlot* slot = CompletionPool::instance().acquire();
+    if constexpr (sizeof(D) <= kInline && alignof(D) <= alignof(std::max_align_t)) {
+        ::new (static_cast<void*>(slot->m_storage)) D(std::forward<F>(f));
+        slot->m_run = &runInline<D>;
+    } else {
+        ::new (static_cast<void*>(slot->m_storage)) D*(new D(std::forward<F>(f)));
+        slot->m_run = &runBoxed<D>;
+    }
+    return slot;
+}
+
+inline void CompletionSlot::release(CompletionSlot* slot) {
+    CompletionPool::instance().release(slot);
+}
+
+// True only for a callback that is certainly empty: a null function pointer or
+// an empty std::function. A lambda is never empty. (`nullptr` itself is taken
+// by its own overloads.)
+template <typename F>
+bool callbackIsEmpty(const F& f) {
+    if constexpr (std::is_constructible_v<bool, const F&>) return !static_cast<bool>(f);
+    else return false;
+}
+
+// A callback that a cancellation can release before its call completes.
+// take() hands it to the completion; release() destroys it, for a cancel()
+// that gets there first. Whichever comes first has it; the other finds the
+// cell empty. It is destroyed outside the lock, so a callback whose captures
+// cancel something else cannot deadlock on it.
+template <typename Callback>
+class CancellableCallback {
+public:
+    explicit CancellableCallback(Callback cb) : m_cb(std::move(cb)) {}
+
+    std::optional<Callback> take() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::optional<Callback> out = std::move(m_cb);
+        m_cb.reset();
+        return out;
+    }
+
+    void release() { (void)take(); }
+
+private:
+    std::mutex m_mutex;
+    std::optional<Callback> m_cb;
+};
+
+}  // namespace detail
+
+// One call of an LpClient::invokeBatch. `args` is a JSON array, as for
+// invoke(). `onResult`, when set, fires as soon as THIS call's reply arrives,
+// with the same (value, error) pair invokeAsyncResult delivers.
+//
+// `argsText`, when set, is that array already written as text
+// (ArgsWriter::take()) and is sent in place of `args`. It is what the
+// generated Batch builder queues, so a batched call builds no DOM either.
+struct LpCall {
+    std::string method;
+    nlohmann::json args = nlohmann::json::array();
+    std::function<void(nlohmann::json, const CallError&)> onResult;
+    std::string argsText;
+};
+
+// The process's lp_clients, shared by every LpClient with the same (target,
+// origin) and counted by reference.
+//
+// Each generated Static wrapper owns its own LpClient, so a process that
+// builds several LogosModules aggregates, or binds several interface States
+// to one provider, used to hold one transport client per wrapper instance —
+// each with its own connection and its own capability handshake with the
+// target. Through the registry they share one, and the transport's cost
+// scales with the distinct targets a module calls, not with its wrappers.
+// The last LpClient to let go destroys it.
+//
+// Only the lp_client is shared. Everything an LpClient is configured with —
+// its cache, single-flight table, concurrency limit and subscriptions — stays
+// its own.
+//
+// Creation follows ensure()'s rule and happens outside the lock: two racers
+// for a new key may each build a client, one is registered, and the other
+// destroys its own. A failed create registers nothing, so the next acquire
+// tries again. Never destroyed, like the completion pool: an LpClient with
+// static storage may release its client during static destruction.
+class LpClientRegistry {
+public:
+    static LpClientRegistry& instance() {
+        static LpClientRegistry* registry = new LpClientRegistry;
+        return *registry;
+    }
+
+    // The shared client for (target, origin), with a reference the caller
+    // must release(); null when none could be created.
+    lp_client* acquire(const std::string& target, const std::string& origin) {
+        const Key key(target, origin);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_clients.find(key);
+            if (it != m_clients.end()) {
+                ++it->second.refs;
+                return it->second.client;
+            }
+        }
+        lp_client* fresh = lp_client_create(target.c_str(), origin.c_str(), nullptr, nullptr);
+        if (!fresh) return nullptr;
+        lp_client* winner = fresh;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto inserted = m_clients.emplace(key, Entry{fresh, 1});
+            if (!inserted.second) {
+                ++inserted.first->second.refs;
+                winner = inserted.first->second.client;
+            }
+        }
+        if (winner != fresh) lp_client_destroy(fresh);  // lost the registration race
+        return winner;
+    }
+
+    // Drops one reference to `client`; the last one destroys it, outside the
+    // lock.
+    void release(const std::string& target, const std::string& origin, lp_client* client) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_clients.find(Key(target, origin));
+            if (it == m_clients.end() || it->second.client != client) {
+                // Not one the registry holds: nothing shares it.
+            } else if (--it->second.refs > 0) {
+                return;
+            } else {
+                m_clients.erase(it);
+            }
+        }
+        lp_client_destroy(client);
+    }
+
+    // One more reference to `client`, which the caller already holds one to;
+    // false if the registry does not hold it.
+    bool retain(const std::string& target, const std::string& origin, lp_client* client) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_clients.find(Key(target, origin));
+        if (it == m_clients.end() || it->second.client != client) return false;
+        ++it->second.refs;
+        return true;
+    }
+
+    // Distinct clients alive.
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_clients.size();
+    }
+
+private:
+    using Key = std::pair<std::string, std::string>;
+    struct Entry {
+        lp_client* client;
+        std::size_t refs;
+    };
+
+    mutable std::mutex m_mutex;
+    std::map<Key, Entry> m_clients;
+};
+
+// std::atomic<std::shared_ptr> where the standard library has it (C++20),
+// for the listener lists below.
+#if defined(__cpp_lib_atomic_shared_ptr) && __cpp_lib_atomic_shared_ptr >= 201711L
+#define LOGOS_HAS_ATOMIC_SHARED_PTR 1
+#else
+#define LOGOS_HAS_ATOMIC_SHARED_PTR 0
+#endif
+
+namespace detail {
+
+// The listeners being called on this thread, innermost last: what a removal
+// from inside a callback must not wait for.
+inline std::vector<const void*>& runningListeners() {
+    thread_local std::vector<const void*> stack;
+    return stack;
+}
+
+// The listeners of one event payload, as delivered to them: the parsed json
+// for an EventHub, a decoded value for a DecodedChannel.
+//
+// The list is copy-on-write. An arrival takes a snapshot — an atomic load
+// of the list's pointer, with no mutex — and calls the listeners holding no
+// lock, so a listener may add or remove listeners, itself included, from its
+// own callback. Adding and removing copy the list under a mutex of their own
+// and publish the copy with an atomic store. The atomic is
+// std::atomic<std::shared_ptr> where the library has it, and the C++11
+// atomic_load / atomic_store overloads for shared_ptr elsewhere, which C++20
+// deprecates in its favour.
+//
+// Removal keeps lp_unsubscribe's promise: once it returns, the listener is
+// not called again. A call already running on another thread is waited for,
+// asleep on the listener's condition variable; one running on the removing
+// thread (a listener removing itself) is not.
+template <typename Arg>
+class ListenerList {
+public:
+    struct Listener {
+        Listener(std::function<void(const Arg&)> f, std::shared_ptr<const EventFilter> filt)
+            : fn(std::move(f)), filter(std::move(filt)) {}
+        std::function<void(const Arg&)> fn;
+        std::shared_ptr<const EventFilter> filter;  // null: every arrival
+        std::atomic<bool> active{true};
+        std::atomic<int> calls{0};
+        // A removal waiting for calls on other threads sleeps here. Only
+        // a call that ends after `active` went false takes the mutex.
+        std::mutex idleMutex;
+        std::condition_variable idle;
+    };
+    using List = std::vector<std::shared_ptr<Listener>>;
+
+    ListenerList() : m_list(std::make_shared<const List>()) {}
+
+    std::shared_ptr<Listener> add(std::function<void(const Arg&)> fn,
+                                  std::shared_ptr<const EventFilter> filter = nullptr) {
+        auto listener = std::make_shared<Listener>(std::move(fn), std::move(filter));
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        auto next = std::make_shared<List>(*snapshot());
+        next->push_back(listener);
+        publish(std::move(next));
+        return listener;
+    }
+
+    void remove(Listener& listener) {
+        {
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+            std::shared_ptr<const List> current = snapshot();
+            auto next = std::make_shared<List>();
+            next->reserve(current->size());
+            for (const std::shared_ptr<Listener>& l : *current)
+                if (l.get() != &listener) next->push_back(l);
+            publish(std::move(next));
+        }
+        // Sequentially consistent on both sides: either a call sees `active`
+        // false, and wakes this when it ends, or this sees its count and
+        // waits for it.
+        listener.active.store(false);
+        const auto& stack = runningListeners();
+        const int mine = static_cast<int>(std::count(stack.begin(), stack.end(), &listener));
+        std::unique_lock<std::mutex> lock(listener.idleMutex);
+        listener.idle.wait(lock, [&] { return listener.calls.load() <= mine; });
+    }
+
+    std::shared_ptr<const List> snapshot() const {
+#if LOGOS_HAS_ATOMIC_SHARED_PTR
+        return m_list.load();
+#else
+        return std::atomic_load(&m_list);
+#endif
+    }
+
+    static void deliver(const List& list, const Arg& arg) {
+        for (const std::shared_ptr<Listener>& l : list) {
+            Call call(*l);
+            if (l->active.load()) l->fn(arg);
+        }
+    }
+
+private:
+    struct Call {
+        explicit Call(Listener& l) : listener(l) {
+            listener.calls.fetch_add(1);
+            runningListeners().push_back(&listener);
+        }
+        ~Call() {
+            runningListeners().pop_back();
+            listener.calls.fetch_sub(1);
+            if (!listener.active.load()) {
+                // Under the mutex, so the wake cannot fall between the
+                // remover's check of the count and its wait.
+                std::lock_guard<std::mutex> lock(listener.idleMutex);
+                listener.idle.notify_all();
+            }
+        }
+        Listener& listener;
+    };
+
+    void publish(std::shared_ptr<const List> next) {
+#if LOGOS_HAS_ATOMIC_SHARED_PTR
+        m_list.store(std::move(next));
+#else
+        std::atomic_store(&m_list, std::move(next));
+#endif
+    }
+
+    std::mutex m_writeMutex;  // adders and removers only; arrivals never take it
+#if LOGOS_HAS_ATOMIC_SHARED_PTR
+    std::atomic<std::shared_ptr<const List>> m_list;
+#else
+    std::shared_ptr<const List> m_list;
+#endif
 };
 
+// Puts `fn` behind an EventQueue, if `options` or an `executor` asks for
+// one: `fn` becomes the queue's push, and the queue, started, is returned for
+// the handle to close. The push holds the queue by plain pointer, since the
+// handle closes the queue and then removes the listener before letting it go.
+template <typename Arg>
+std::shared_ptr<EventQueue<Arg>> queueListener(const EventQueueOptions& options, Executor* executor,
+                                               std::function<void(const Arg&)>& fn) {
+    if (options.capacity == 0 && !executor) return nullptr;
+    auto queue = std::make_shared<EventQueue<Arg>>(options, std::move(fn), executor);
+    queue->start();
+    fn = [q = queue.get()](const Arg& arg) { q->push(arg); };
+    return queue;
+}
+
+// A listener's handle, as LpSubscription's box: it keeps the list's owner
+// alive and takes the listener off when it goes. The owner goes with its
+// last handle.
+//
+// A queued listener's queue is closed FIRST: an arrival waiting for room
+// (Overflow::Block) is holding a listener call open, and the removal below
+// waits for that call.
+template <typename Owner, typename Arg>
+struct ListenerHandle {
+    std::shared_ptr<Owner> owner;
+    std::shared_ptr<typename ListenerList<Arg>::Listener> listener;
+    std::shared_ptr<EventQueue<Arg>> queue;  // null: called on the delivering thread
+
+    static LpSubscription make(std::shared_ptr<Owner> owner,
+                               std::shared_ptr<typename ListenerList<Arg>::Listener> listener,
+                               std::shared_ptr<EventQueue<Arg>> queue = nullptr) {
+        std::shared_ptr<const EventQueueCounters> counters = queue ? queue->counters() : nullptr;
+        return LpSubscription(nullptr,
+                              new ListenerHandle{std::move(owner), std::move(listener), std::move(queue)},
+                              &ListenerHandle::remove, std::move(counters));
+    }
+
+    static void remove(void* p) {
+        std::unique_ptr<ListenerHandle> handle(static_cast<ListenerHandle*>(p));
+        if (handle->queue) handle->queue->close();
+        handle->owner->listeners().remove(*handle->listener);
+    }
+};
+
+class DecodedChannelBase {
+public:
+    virtual ~DecodedChannelBase() = default;
+};
+
+class EventHub;
+
+// The listeners of one event that want it as a T, decoded by one `decode`.
+// It is ONE listener on the hub, so each arrival is decoded once, however
+// many listeners there are, and each is handed the same const T. A payload
+// `decode` rejects reaches none of them.
+template <typename T>
+class DecodedChannel : public DecodedChannelBase,
+                       public std::enable_shared_from_this<DecodedChannel<T>> {
+public:
+    using Decode = bool (*)(const nlohmann::json&, T&);
+    static constexpr char kTag = 0;  // one address per T: the channel's type
+
+    explicit DecodedChannel(Decode decode) : m_decode(decode) {}
+
+    // Feeds the channel from the hub. Not in the constructor: the feed holds
+    // the channel weakly, and there is no weak_ptr until the channel is owned.
+    void attach(EventHub& hub);
+
+    Decode decode() const { return m_decode; }
+    ListenerList<T>& listeners() { return m_listeners; }
+
+    LpSubscription add(std::function<void(const T&)> fn, const EventQueueOptions& queue = {},
+                       Executor* executor = nullptr) {
+        std::shared_ptr<EventQueue<T>> q = queueListener(queue, executor, fn);
+        return ListenerHandle<DecodedChannel, T>::make(this->shared_from_this(),
+                                                       m_listeners.add(std::move(fn)), std::move(q));
+    }
+
+private:
+    void deliver(const nlohmann::json& payload) {
+        std::shared_ptr<const typename ListenerList<T>::List> snapshot = m_listeners.snapshot();
+        if (snapshot->empty()) return;
+        T value{};
+        if (!m_decode(payload, value)) return;
+        ListenerList<T>::deliver(*snapshot, value);
+    }
+
+    Decode m_decode;
+    ListenerList<T> m_listeners;
+    LpSubscription m_feed;  // this channel's listener on the hub
+};
+
+// One event of one target, delivered to any number of listeners over ONE
+// transport subscription, with the payload parsed ONCE per arrival.
+//
+// Each LpClient::subscribe used to take its own lp_subscription with its own
+// callback box, so ten components listening to `priceUpdated` cost ten
+// transport subscriptions, and every arrival was parsed ten times. The hub
+// subscribes on its first listener, fans each arrival out, and unsubscribes
+// with its last. Listeners that want the payload decoded share a
+// DecodedChannel per decoder, so the decode is not repeated either.
+//
+// The hub holds its own reference to the shared lp_client (LpClientRegistry),
+// so a listener that outlives its LpClient stays safe.
+class EventHub : public std::enable_shared_from_this<EventHub> {
+public:
+    EventHub(std::string target, std::string origin, std::string event)
+        : m_target(std::move(target)), m_origin(std::move(origin)), m_event(std::move(event)) {}
+
+    ~EventHub() {
+        if (m_sub) lp_unsubscribe(m_sub);
+        if (m_client) LpClientRegistry::instance().release(m_target, m_origin, m_client);
+    }
+
+    EventHub(const EventHub&) = delete;
+    EventHub& operator=(const EventHub&) = delete;
+
+    // Takes the transport subscription. Called once, before the hub is shared;
+    // false if there is no client or the transport refused.
+    bool open() {
+        m_client = LpClientRegistry::instance().acquire(m_target, m_origin);
+        if (!m_client) return false;
+        m_sub = lp_subscribe(m_client, m_event.c_str(), &EventHub::trampoline, this);
+        return m_sub != nullptr;
+    }
+
+    ListenerList<nlohmann::json>& listeners() { return m_listeners; }
+
+    LpSubscription add(std::function<void(const nlohmann::json&)> fn,
+                       std::shared_ptr<const EventFilter> filter = nullptr,
+                       const EventQueueOptions& queue = {}, Executor* executor = nullptr) {
+        std::shared_ptr<EventQueue<nlohmann::json>> q = queueListener(queue, executor, fn);
+        return ListenerHandle<EventHub, nlohmann::json>::make(
+            shared_from_this(), m_listeners.add(std::move(fn), std::move(filter)), std::move(q));
+    }
+
+    // The live channel for (T, decode), or a new one. No transport call is
+    // made here, so the lookup and the creation share one lock.
+    template <typename T>
+    std::shared_ptr<DecodedChannel<T>> channel(typename DecodedChannel<T>::Decode decode) {
+        std::lock_guard<std::mutex> lock(m_channelsMutex);
+        for (auto it = m_channels.begin(); it != m_channels.end();) {
+            std::shared_ptr<DecodedChannelBase> live = it->channel.lock();
+            if (!live) { it = m_channels.erase(it); continue; }
+            if (it->tag == &DecodedChannel<T>::kTag) {
+                auto typed = std::static_pointer_cast<DecodedChannel<T>>(live);
+                if (typed->decode() == decode) return typed;
+            }
+            ++it;
+        }
+        auto fresh = std::make_shared<DecodedChannel<T>>(decode);
+        fresh->attach(*this);
+        m_channels.push_back({&DecodedChannel<T>::kTag, fresh});
+        return fresh;
+    }
+
+private:
+    struct ChannelEntry {
+        const void* tag;
+        std::weak_ptr<DecodedChannelBase> channel;
+    };
+
+    // Filtered listeners are sorted out on the payload's text, before the
+    // parse, so an arrival that only filtered listeners hear, and none of them
+    // wants, costs a partial read and no parse at all.
+    static void trampoline(const char* /*eventName*/, const char* dataJson, void* ud) {
+        using List = ListenerList<nlohmann::json>::List;
+        std::shared_ptr<EventHub> self = static_cast<EventHub*>(ud)->weak_from_this().lock();
+        if (!self) return;  // the last listener is going
+        std::shared_ptr<const List> snapshot = self->m_listeners.snapshot();
+        if (snapshot->empty()) return;
+
+        const char* text = dataJson ? dataJson : "[]";
+        const char* end = text + std::strlen(text);
+        const bool filtered = std::any_of(snapshot->begin(), snapshot->end(),
+                                          [](const auto& l) { return l->filter != nullptr; });
+        List wanted;
+        if (filtered) {
+            for (const auto& l : *snapshot)
+                if (!l->filter || l->filter->matches(text, end)) wanted.push_back(l);
+            if (wanted.empty()) return;
+        }
+
+        nlohmann::json payload = nlohmann::json::parse(text, end, nullptr, false);
+        if (payload.is_discarded()) {
+            // Unfiltered listeners get the empty argument list they always
+            // did; a filter has said nothing about a payload it never saw.
+            payload = nlohmann::json::array();
+            if (filtered) {
+                List unfiltered;
+                for (const auto& l : wanted) if (!l->filter) unfiltered.push_back(l);
+                wanted.swap(unfiltered);
+            }
+        }
+        ListenerList<nlohmann::json>::deliver(filtered ? wanted : *snapshot, payload);
+    }
+
+    const std::string m_target;
+    const std::string m_origin;
+    const std::string m_event;
+    lp_client* m_client = nullptr;
+    lp_subscription* m_sub = nullptr;
+    ListenerList<nlohmann::json> m_listeners;
+    std::mutex m_channelsMutex;
+    std::vector<ChannelEntry> m_channels;
+};
+
+template <typename T>
+void DecodedChannel<T>::attach(EventHub& hub) {
+    std::weak_ptr<DecodedChannel> weak = this->shared_from_this();
+    m_feed = hub.add([weak](const nlohmann::json& payload) {
+        if (std::shared_ptr<DecodedChannel> self = weak.lock()) self->deliver(payload);
+    });
+}
+
+}  // namespace detail
+
 // Qt-free typed client for one target module. The lp_client is created lazily
 // on first use, on behalf of `origin` (the calling module's name, baked by the
 // generated umbrella), over the process-default transport with the automatic
-// capability/token flow that logos-protocol provides.
+// capability/token flow that logos-protocol provides, and shared with every
+// other LpClient for the same target and origin (LpClientRegistry).
 class LpClient {
+    struct CallTicket;
+
 public:
     LpClient(std::string target, std::string origin)
         : m_target(std::move(target)), m_origin(std::move(origin)) {}
     ~LpClient() {
+        // Calls still waiting for a permit would be issued on a destroyed
+        // client: they are failed instead, before it goes.
+        if (m_limiter) m_limiter->abandon();
+        // The invalidation subscriptions go first: they hang off the client.
+        m_cacheSubs.clear();
         if (lp_client* c = m_client.load(std::memory_order_acquire))
-            lp_client_destroy(c);
+            LpClientRegistry::instance().release(m_target, m_origin, c);
     }
     LpClient(const LpClient&) = delete;
     LpClient& operator=(const LpClient&) = delete;
@@ -128,45 +1050,63 @@ public:
                           const nlohmann::json& args,
                           CallError* err,
                           int timeout_ms = 0) {
-        lp_client* c = ensure();
-        if (!c) {
-            if (err) { err->code = "object_unavailable";
-                       err->message = "could not create client for " + m_target;
-                       err->origin = m_target; }
-            return nullptr;
-        }
-        const std::string argsStr = args.dump();
-        char* outRes = nullptr;
-        char* outErr = nullptr;
-        const int rc = lp_invoke(c, method.c_str(), argsStr.c_str(), timeout_ms, &outRes, &outErr);
-        nlohmann::json result;  // null
-        if (rc == LP_OK) {
-            if (err) err->clear();
-            if (outRes) {
-                auto parsed = nlohmann::json::parse(outRes, nullptr, /*allow_exceptions=*/false);
-                if (!parsed.is_discarded()) result = std::move(parsed);
-            }
-        } else {
-            fillErr(err, outErr, rc);
-        }
-        if (outRes) lp_string_free(outRes);
-        if (outErr) lp_string_free(outErr);
-        return result;
+        return invokeReplyText(method, args.dump(), err, timeout_ms).takeJson();
+    }
+
+    // The same call with its arguments already written as text, straight
+    // from the typed values and without an intermediate json array. What the
+    // generated wrappers use. Every invoke* below has this twin.
+    nlohmann::json invoke(const std::string& method,
+                          ArgsWriter& args,
+                          CallError* err,
+                          int timeout_ms = 0) {
+        return invokeReplyText(method, args.text(), err, timeout_ms).takeJson();
+    }
+
+    // The same call, with the reply left as text for the caller to decode
+    // straight into its own type (see LpReply). What the generated blocking
+    // wrappers use: a reply that is only ever read as a std::string or a
+    // list of records never becomes an nlohmann::json at all.
+    LpReply invokeReply(const std::string& method,
+                        const nlohmann::json& args,
+                        CallError* err,
+                        int timeout_ms = 0) {
+        return invokeReplyText(method, args.dump(), err, timeout_ms);
+    }
+
+    LpReply invokeReply(const std::string& method,
+                        ArgsWriter& args,
+                        CallError* err,
+                        int timeout_ms = 0) {
+        return invokeReplyText(method, args.text(), err, timeout_ms);
     }
 
     // Async call. `cb` fires exactly once with the result JSON (null on
     // failure / parse error). Safe to call from any thread.
+    //
+    // A template over the callable rather than a std::function parameter, so
+    // the callable goes straight into a pooled completion slot: a callback of
+    // up to CompletionSlot::kInline bytes costs no allocation per call. Any
+    // std::function still binds here, as it always did. An empty callback
+    // (`nullptr`, an empty std::function) is a no-op, not a call.
+    template <typename Callback>
     void invokeAsync(const std::string& method,
                      const nlohmann::json& args,
-                     std::function<void(nlohmann::json)> cb,
+                     Callback&& cb,
                      int timeout_ms = 0) {
-        lp_client* c = ensure();
-        if (!c) { if (cb) cb(nullptr); return; }
-        auto* box = new std::function<void(nlohmann::json)>(std::move(cb));
-        const std::string argsStr = args.dump();
-        lp_invoke_async(c, method.c_str(), argsStr.c_str(), timeout_ms,
-            &LpClient::resultTrampoline, box);
+        if (detail::callbackIsEmpty(cb)) return;
+        invokeAsyncText(method, args.dump(), std::forward<Callback>(cb), timeout_ms);
+    }
+    template <typename Callback>
+    void invokeAsync(const std::string& method,
+                     ArgsWriter& args,
+                     Callback&& cb,
+                     int timeout_ms = 0) {
+        if (detail::callbackIsEmpty(cb)) return;
+        invokeAsyncText(method, args.text(), std::forward<Callback>(cb), timeout_ms);
     }
+    void invokeAsync(const std::string&, const nlohmann::json&, std::nullptr_t, int = 0) {}
+    void invokeAsync(const std::string&, ArgsWriter&, std::nullptr_t, int = 0) {}
 
     // Async call carrying the error — the async twin of invoke()'s `err`
     // out-parameter, and what the generated `<name>AsyncResult` wrappers are
@@ -188,30 +1128,206 @@ public:
     // Safe to call from any thread. logos-qt-sdk's LpBridge::invokeAsyncResult
     // is this function with a private second lp_client bolted on because this
     // one did not exist; it can now delegate here and drop that connection.
+    //
+    // A template over the callable for the same reason as invokeAsync.
+    template <typename Callback>
     void invokeAsyncResult(const std::string& method,
                            const nlohmann::json& args,
-                           std::function<void(nlohmann::json, const CallError&)> cb,
+                           Callback&& cb,
                            int timeout_ms = 0) {
-        if (!cb) return;
-        lp_client* c = ensure();
-        if (!c) {
-            cb(nlohmann::json(),
-               callErrorObjectUnavailable(m_target, "could not create client for " + m_target));
+        if (detail::callbackIsEmpty(cb)) return;
+        invokeAsyncResultText(method, args.dump(), std::forward<Callback>(cb), timeout_ms);
+    }
+    template <typename Callback>
+    void invokeAsyncResult(const std::string& method,
+                           ArgsWriter& args,
+                           Callback&& cb,
+                           int timeout_ms = 0) {
+        if (detail::callbackIsEmpty(cb)) return;
+        invokeAsyncResultText(method, args.text(), std::forward<Callback>(cb), timeout_ms);
+    }
+    void invokeAsyncResult(const std::string&, const nlohmann::json&, std::nullptr_t, int = 0) {}
+    void invokeAsyncResult(const std::string&, ArgsWriter&, std::nullptr_t, int = 0) {}
+
+    // The same call under a CancellationToken, in place of a timeout. The
+    // call is not issued at all if the token is already cancelled, and
+    // completes at once with a `timeout` error if its deadline has passed.
+    // Otherwise it is issued with what is left of the deadline as its
+    // timeout_ms, and cancel() releases its callback unrun while it is in
+    // flight. A call under a cancelled token, already or later, is the one
+    // exception to "fires exactly once": its callback is never called,
+    // because the caller asked not to hear.
+    template <typename Callback>
+    void invokeAsyncResult(const std::string& method,
+                           const nlohmann::json& args,
+                           Callback&& cb,
+                           const CancellationToken& token) {
+        if (detail::callbackIsEmpty(cb)) return;
+        invokeAsyncResultUntil(method, args.dump(), std::forward<Callback>(cb), token);
+    }
+    template <typename Callback>
+    void invokeAsyncResult(const std::string& method,
+                           ArgsWriter& args,
+                           Callback&& cb,
+                           const CancellationToken& token) {
+        if (detail::callbackIsEmpty(cb)) return;
+        invokeAsyncResultUntil(method, args.text(), std::forward<Callback>(cb), token);
+    }
+    void invokeAsyncResult(const std::string&, const nlohmann::json&, std::nullptr_t,
+                           const CancellationToken&) {}
+    void invokeAsyncResult(const std::string&, ArgsWriter&, std::nullptr_t,
+                           const CancellationToken&) {}
+
+#if LOGOS_HAS_COROUTINES
+    // invokeAsyncResult for a coroutine: `co_await client.invokeCo(...)`
+    // yields the same (value, error) pair, as an AsyncResult<nlohmann::json>.
+    // What the generated `<name>Co` wrappers are built on.
+    //
+    // The call is issued when the result is awaited, and its completion state
+    // is the awaiter itself, which lives in the awaiting coroutine's frame —
+    // there is no ResultErrBox and no std::function. The awaiter must
+    // therefore be awaited where it was made, not stored and awaited later.
+    // A cache hit (see cacheMethod) completes it without suspending; a call
+    // that joins another's flight (see singleFlight) resumes when that lands.
+    class CoCall {
+    public:
+        bool await_ready() {
+            return m_client->route(m_method, m_args, m_result.value, m_ticket, m_joined,
+                                   /*mayJoin=*/true) == Route::Cached;
+        }
+
+        bool await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            m_awaiting = awaiting;
+            if (m_joined) {
+                m_joined->then([this](const nlohmann::json& v, const CallError& e) {
+                    m_result.value = v;
+                    m_result.error = e;
+                    if (m_phase.exchange(kReplied, std::memory_order_acq_rel) == kSuspended)
+                        m_awaiting.resume();
+                });
+                return m_phase.exchange(kSuspended, std::memory_order_acq_rel) != kReplied;
+            }
+            lp_client* c = m_client->ensure();
+            if (!c) {
+                m_result.error = callErrorObjectUnavailable(
+                    m_client->m_target, "could not create client for " + m_client->m_target);
+                if (m_ticket) m_ticket->finish(nlohmann::json(), m_result.error);
+                return false;
+            }
+            if (m_client->m_limiter) {
+                // A call that may have to wait for a permit needs a
+                // completion that can be queued; the pooled slot is one, and
+                // it lands in the same trampoline.
+                m_client->issueAsync(c, m_method, m_args, m_timeoutMs,
+                    [this](int ok, const char* json) { trampoline(ok, json, this); });
+                return m_phase.exchange(kSuspended, std::memory_order_acq_rel) != kReplied;
+            }
+            const int rc = lp_invoke_async(c, m_method.c_str(), m_args.c_str(), m_timeoutMs,
+                                           &CoCall::trampoline, this);
+            if (rc != LP_OK) {
+                // Not called back (the C ABI's rule): carry on with the error.
+                m_result.error = callErrorCallFailed(
+                    m_client->m_target, "lp_invoke_async refused the call (rc="
+                                            + std::to_string(rc) + ")");
+                if (m_ticket) m_ticket->finish(nlohmann::json(), m_result.error);
+                return false;
+            }
+            // The reply may already have landed, on this thread or another.
+            // Whichever side gets here second resumes the coroutine; the
+            // trampoline touches nothing of `this` after its exchange.
+            return m_phase.exchange(kSuspended, std::memory_order_acq_rel) != kReplied;
+        }
+
+        AsyncResult<nlohmann::json> await_resume() noexcept { return std::move(m_result); }
+
+    private:
+        friend class LpClient;
+        CoCall(LpClient* client, std::string method, std::string args, int timeout_ms)
+            : m_client(client), m_method(std::move(method)), m_args(std::move(args)),
+              m_timeoutMs(timeout_ms) {}
+
+        static void trampoline(int ok, const char* json, void* ud) {
+            auto* self = static_cast<CoCall*>(ud);
+            self->m_result.value = decodeAsyncReply(ok, json, self->m_result.error);
+            if (self->m_ticket) self->m_ticket->finish(self->m_result.value, self->m_result.error);
+            if (self->m_phase.exchange(kReplied, std::memory_order_acq_rel) == kSuspended)
+                self->m_awaiting.resume();
+        }
+
+        static constexpr int kIssuing = 0;
+        static constexpr int kSuspended = 1;
+        static constexpr int kReplied = 2;
+
+        LpClient* m_client;
+        std::string m_method;
+        std::string m_args;
+        int m_timeoutMs;
+        std::coroutine_handle<> m_awaiting;
+        std::atomic<int> m_phase{kIssuing};
+        AsyncResult<nlohmann::json> m_result;
+        std::unique_ptr<CallTicket> m_ticket;
+        std::shared_ptr<InFlightCall> m_joined;
+    };
+
+    CoCall invokeCo(const std::string& method, const nlohmann::json& args, int timeout_ms = 0) {
+        return CoCall(this, method, args.dump(), timeout_ms);
+    }
+    // The awaiter outlives the writer's statement, so it takes the text over
+    // rather than copying it.
+    CoCall invokeCo(const std::string& method, ArgsWriter&& args, int timeout_ms = 0) {
+        return CoCall(this, method, args.take(), timeout_ms);
+    }
+#endif
+
+    // Many calls to this target, PIPELINED: every call is on the wire before
+    // the first reply is awaited, so N lookups cost about one round trip
+    // rather than N. Each call's `onResult` fires as its own reply arrives, in
+    // whatever order the target answers; `done`, when set, fires once after
+    // the last of them with every outcome in CALL order. Both may run on any
+    // thread, exactly like invokeAsyncResult's callback, and an empty batch
+    // completes at once.
+    //
+    // The calls still travel as separate lp_invoke_async requests. Folding
+    // them into ONE transport message needs a batch operation in the lp_* C
+    // ABI itself, which logos-protocol does not have; the pipelining is what
+    // this side can do on its own, and it is where most of the 500 round
+    // trips went.
+    //
+    // A batch bypasses the result cache: every call in it is a round trip.
+    //
+    // There is deliberately no blocking form. A blocking batch would have to
+    // wait for completions that a Qt-affine transport delivers through the
+    // very event loop the waiting thread may be running. A provider that needs
+    // the results before it can answer returns a logos::Deferred and resolves
+    // it from `done`.
+    void invokeBatch(std::vector<LpCall> calls,
+                     std::function<void(std::vector<AsyncResult<nlohmann::json>>)> done,
+                     int timeout_ms = 0) {
+        auto batch = std::make_shared<BatchState>();
+        batch->calls = std::move(calls);
+        batch->results.resize(batch->calls.size());
+        batch->remaining.store(batch->calls.size(), std::memory_order_relaxed);
+        batch->done = std::move(done);
+        if (batch->calls.empty()) {
+            if (batch->done) batch->done({});
             return;
         }
-        auto* box = new ResultErrBox(std::move(cb));
-        const std::string argsStr = args.dump();
-        const int rc = lp_invoke_async(c, method.c_str(), argsStr.c_str(), timeout_ms,
-                                       &LpClient::resultErrorTrampoline, box);
-        if (rc != LP_OK) {
-            // A synchronous refusal does NOT call back (the C ABI's rule), so
-            // the completion is this function's to make — `cb` still has to fire
-            // exactly once, which is the whole contract a caller schedules on.
-            ResultErrBox fn = std::move(*box);
-            delete box;
-            fn(nlohmann::json(),
-               callErrorCallFailed(m_target, "lp_invoke_async refused the call (rc="
-                                                 + std::to_string(rc) + ")"));
+        lp_client* c = ensure();
+        for (std::size_t i = 0; i < batch->calls.size(); ++i) {
+            if (!c) {
+                completeBatchCall(*batch, i, nlohmann::json(),
+                    callErrorObjectUnavailable(m_target, "could not create client for " + m_target));
+                continue;
+            }
+            const LpCall& call = batch->calls[i];
+            std::string dumped;
+            if (call.argsText.empty()) dumped = call.args.dump();
+            issueAsync(c, call.method, call.argsText.empty() ? dumped : call.argsText, timeout_ms,
+                [batch, i](int ok, const char* json) {
+                    CallError err;
+                    nlohmann::json parsed = decodeAsyncReply(ok, json, err);
+                    completeBatchCall(*batch, i, std::move(parsed), err);
+                });
         }
     }
 
@@ -232,19 +1348,610 @@ public:
     // Subscribe to `event`. The payload is delivered as a JSON array. The
     // returned handle owns the subscription — keep it alive (the generated
     // wrapper stores it) for as long as you want the callback to fire.
+    //
+    // Every listener of one event on this client shares ONE transport
+    // subscription and one parse of each payload (detail::EventHub). A
+    // callback that takes the payload by const reference reads that parse;
+    // one that takes it by value gets its own copy, as it always did.
+    //
+    // With a `queue` capacity the callback runs on a delivery thread of its
+    // own, behind a bounded queue with the chosen overflow policy
+    // (logos_event_queue.h); the handle's queueCounters() report on it. An
+    // `executor` runs it there instead — &logos::ThreadPool::shared(), or
+    // one of the module's own — one call at a time and in arrival order. A
+    // queued listener is handed its own copy of each payload.
     LpSubscription subscribe(const std::string& event,
-                             std::function<void(nlohmann::json)> cb) {
-        lp_client* c = ensure();
-        if (!c) return {};
-        auto* box = new std::function<void(nlohmann::json)>(std::move(cb));
-        lp_subscription* sub = lp_subscribe(c, event.c_str(), &LpClient::eventTrampoline, box);
-        if (!sub) { delete box; return {}; }
-        return LpSubscription(sub, box, &LpClient::deleteBox);
+                             std::function<void(const nlohmann::json&)> cb,
+                             const EventQueueOptions& queue = {},
+                             Executor* executor = nullptr) {
+        std::shared_ptr<detail::EventHub> hub = eventHub(event);
+        if (!hub) return {};
+        return hub->add(std::move(cb), nullptr, queue, executor);
+    }
+
+    // Subscribe to the arrivals of `event` that pass `filter` (see
+    // logos_event_filter.h). The filter is checked on the payload's text as it
+    // arrives, before it is parsed, so an arrival no listener wants is never
+    // parsed at all. An empty filter is the plain subscribe.
+    // A queue is offered only the arrivals that pass.
+    LpSubscription subscribe(const std::string& event, const EventFilter& filter,
+                             std::function<void(const nlohmann::json&)> cb,
+                             const EventQueueOptions& queue = {},
+                             Executor* executor = nullptr) {
+        std::shared_ptr<detail::EventHub> hub = eventHub(event);
+        if (!hub) return {};
+        if (filter.empty()) return hub->add(std::move(cb), nullptr, queue, executor);
+        return hub->add(std::move(cb), std::make_shared<const EventFilter>(filter), queue, executor);
+    }
+
+    // Subscribe to `event` decoded as a T. `decode` turns the payload into a
+    // T, or returns false for one that does not fit, which no listener then
+    // sees. Listeners that pass the same `decode` share ONE decode per
+    // arrival and are each handed the same const T. What the generated
+    // `on<Event>` accessors use, with the event's arguments as a std::tuple.
+    // A `queue` and an `executor` are as for subscribe; the queue holds
+    // copies of the decoded T.
+    template <typename T>
+    LpSubscription subscribeDecoded(const std::string& event,
+                                    bool (*decode)(const nlohmann::json&, T&),
+                                    std::function<void(const T&)> cb,
+                                    const EventQueueOptions& queue = {},
+                                    Executor* executor = nullptr) {
+        std::shared_ptr<detail::EventHub> hub = eventHub(event);
+        if (!hub) return {};
+        return hub->channel<T>(decode)->add(std::move(cb), queue, executor);
     }
 
+    // ── Result cache ────────────────────────────────────────────────────────
+    //
+    // Opt-in, per method. After cacheMethod("getConfig", 5000), a successful
+    // getConfig reply is remembered for five seconds under its exact
+    // arguments, and invoke / invokeAsync / invokeAsyncResult / invokeCo with
+    // the same arguments are answered from memory, on the calling thread,
+    // without touching the transport. Failures and provider rejections are
+    // never remembered. Only mark methods whose answer depends on nothing but
+    // their arguments and the target's state: the cache cannot tell a pure
+    // read from one that happens to be called twice.
+    //
+    // `invalidatedBy` names events of the target that mean the answer may have
+    // changed. Each arriving one drops every entry of the method. The
+    // subscriptions are taken on the method's first miss, and until they are
+    // in place nothing is remembered, so an entry never outlives a change the
+    // target announced. Without events the TTL alone bounds staleness.
+    //
+    // The generated wrappers call this from their constructor for each method
+    // the contract tags `@cache`; a hand-written caller configures it the same
+    // way, BEFORE the client's first call — the policy table is not locked.
+    void cacheMethod(const std::string& method, int ttl_ms,
+                     std::vector<std::string> invalidatedBy = {}) {
+        if (!m_cache) m_cache = std::make_shared<ResultCache>();
+        auto policy = std::make_unique<CachePolicy>();
+        policy->ttl = std::chrono::milliseconds(ttl_ms > 0 ? ttl_ms : 0);
+        policy->invalidatedBy = std::move(invalidatedBy);
+        m_cachePolicies[method] = std::move(policy);
+    }
+
+    // Entries kept across all of this client's methods (default 256); the
+    // least recently used go first. Same configuration rule as cacheMethod.
+    void setCacheCapacity(std::size_t maxEntries) {
+        if (!m_cache) m_cache = std::make_shared<ResultCache>(maxEntries);
+        else m_cache->setCapacity(maxEntries);
+    }
+
+    // Forgets the cached answers of `method`, or of every method when it is
+    // empty — for a caller that knows the target changed without an event.
+    // Safe from any thread; a call already in flight does not repopulate.
+    void invalidateCache(const std::string& method = std::string()) {
+        if (m_cache) m_cache->invalidate(method);
+    }
+
+    // ── Single-flight (opt-in, per method or client-wide) ───────────────────
+    //
+    // After singleFlight("getConfig"), a getConfig call made while an
+    // identical one (same arguments) is already out does not go to the
+    // transport: it waits for that call and gets its outcome, value and error
+    // alike. An empty `method` turns it on for every method of this client.
+    // Combined with cacheMethod it also collapses a cold cache's stampede: the
+    // first miss fetches, the rest wait for it, and the next call hits.
+    //
+    // Only the async paths (invokeAsync, invokeAsyncResult, invokeCo) join.
+    // A blocking invoke() never waits on another caller's request: it could
+    // not keep to its own timeout_ms while it did, and on a Qt-affine host it
+    // could be the very thread that request needs in order to land. It leads
+    // a flight when none is out, so async callers may join it, and otherwise
+    // issues its own request.
+    //
+    // Only for methods that may share an answer: a call with effects must
+    // still happen once per caller. The generated wrappers call this for each
+    // method the contract tags `@single-flight`. Configure before the client's
+    // first call, like cacheMethod.
+    void singleFlight(const std::string& method = std::string()) {
+        if (!m_flights) m_flights = std::make_shared<SingleFlight>();
+        if (method.empty()) m_singleFlightAll = true;
+        else m_singleFlightMethods.insert(method);
+    }
+
+    // ── Concurrency limit (opt-in, per client) ──────────────────────────────
+    //
+    // After limitConcurrency(), at most limit() of this client's calls are out
+    // at a time (see logos_concurrency_limit.h for how the limit adapts). A
+    // call over the limit waits in line and is issued when an earlier one
+    // lands; one that finds the line full fails at once with CallError code
+    // `overloaded` — a load-shedding signal, not a fault of the target. Every
+    // issuing path takes its permit: invoke, invokeAsync, invokeAsyncResult,
+    // invokeCo and each call of invokeBatch. A cache hit or a single-flight
+    // joiner never reaches the transport, so it takes none.
+    //
+    // A call's timeout_ms starts when it is issued, not while it waits in
+    // line. A blocking invoke() over the limit blocks until a permit frees,
+    // which is the single-flight hazard again: on a Qt-affine host, the main
+    // thread must not make blocking calls to a limited client whose async
+    // completions it delivers itself. Set maxQueued to 0 to make such a call
+    // fail with `overloaded` instead of waiting.
+    //
+    // Configure before the client's first call, like cacheMethod.
+    void limitConcurrency(ConcurrencyLimiter::Options options = ConcurrencyLimiter::Options()) {
+        m_limiter = std::make_shared<ConcurrencyLimiter>(options);
+    }
+
+    // The limiter's gauges (limit(), inFlight(), queued()); null without one.
+    const ConcurrencyLimiter* concurrencyLimiter() const { return m_limiter.get(); }
+
 private:
-    using Box = std::function<void(nlohmann::json)>;
-    using ResultErrBox = std::function<void(nlohmann::json, const CallError&)>;
+    // The bodies of invoke, invokeAsync and invokeAsyncResult, past the
+    // point where the arguments are text. The blocking body leaves the reply
+    // unparsed unless a cache or a flight needs the value.
+    LpReply invokeReplyText(const std::string& method, const std::string& argsStr,
+                            CallError* err, int timeout_ms) {
+        nlohmann::json routed;
+        std::unique_ptr<CallTicket> ticket;
+        std::shared_ptr<InFlightCall> joined;
+        switch (route(method, argsStr, routed, ticket, joined, /*mayJoin=*/false)) {
+        case Route::Cached:
+            if (err) err->clear();
+            return LpReply(std::move(routed));
+        case Route::Joined:  // not routed here: a blocking call never joins
+        case Route::Issue:
+            break;
+        }
+        lp_client* c = ensure();
+        if (!c) {
+            if (err) { err->code = "object_unavailable";
+                       err->message = "could not create client for " + m_target;
+                       err->origin = m_target; }
+            if (ticket) ticket->finish(nlohmann::json(), callErrorObjectUnavailable(
+                m_target, "could not create client for " + m_target));
+            return LpReply();
+        }
+        ConcurrencyLimiter::Clock::time_point issued;
+        if (m_limiter) {
+            CallError refused;
+            if (!awaitPermit(method, refused)) {
+                if (err) *err = refused;
+                if (ticket) ticket->finish(nlohmann::json(), refused);
+                return LpReply();
+            }
+            issued = ConcurrencyLimiter::Clock::now();
+        }
+        char* outRes = nullptr;
+        char* outErr = nullptr;
+        const int rc = lp_invoke(c, method.c_str(), argsStr.c_str(), timeout_ms, &outRes, &outErr);
+        if (m_limiter) m_limiter->release(issued);
+        LpReply result;  // null
+        if (rc == LP_OK) {
+            if (err) err->clear();
+            result = LpReply::adopt(outRes);
+            outRes = nullptr;
+            if (ticket) ticket->finish(result.json(), CallError());
+        } else {
+            fillErr(err, outErr, rc);
+            if (ticket) {
+                CallError failed;
+                fillErr(&failed, outErr, rc);
+                ticket->finish(nlohmann::json(), failed);
+            }
+        }
+        if (outRes) lp_string_free(outRes);
+        if (outErr) lp_string_free(outErr);
+        return result;
+    }
+
+    template <typename Callback>
+    void invokeAsyncText(const std::string& method, const std::string& argsStr,
+                         Callback&& cb, int timeout_ms) {
+        nlohmann::json routed;
+        std::unique_ptr<CallTicket> ticket;
+        std::shared_ptr<InFlightCall> joined;
+        switch (route(method, argsStr, routed, ticket, joined, /*mayJoin=*/true)) {
+        case Route::Cached:
+            cb(std::move(routed));
+            return;
+        case Route::Joined: {
+            auto shared = std::make_shared<std::decay_t<Callback>>(std::forward<Callback>(cb));
+            joined->then([shared](const nlohmann::json& v, const CallError&) { (*shared)(v); });
+            return;
+        }
+        case Route::Issue:
+            break;
+        }
+        lp_client* c = ensure();
+        if (!c) {
+            if (ticket) ticket->finish(nlohmann::json(), callErrorObjectUnavailable(
+                m_target, "could not create client for " + m_target));
+            cb(nullptr);
+            return;
+        }
+        issueAsync(c, method, argsStr, timeout_ms,
+            [cb = std::forward<Callback>(cb), ticket = std::move(ticket)](int ok, const char* json) mutable {
+                // decodeAsyncReply yields null for a failure and for an
+                // unparseable reply alike, which is this callback's contract.
+                CallError err;
+                nlohmann::json r = decodeAsyncReply(ok, json, err);
+                if (ticket) ticket->finish(r, err);
+                cb(std::move(r));
+            });
+    }
+
+    template <typename Callback>
+    void invokeAsyncResultText(const std::string& method, const std::string& argsStr,
+                               Callback&& cb, int timeout_ms) {
+        nlohmann::json routed;
+        std::unique_ptr<CallTicket> ticket;
+        std::shared_ptr<InFlightCall> joined;
+        switch (route(method, argsStr, routed, ticket, joined, /*mayJoin=*/true)) {
+        case Route::Cached:
+            cb(std::move(routed), CallError());
+            return;
+        case Route::Joined: {
+            auto shared = std::make_shared<std::decay_t<Callback>>(std::forward<Callback>(cb));
+            joined->then([shared](const nlohmann::json& v, const CallError& e) { (*shared)(v, e); });
+            return;
+        }
+        case Route::Issue:
+            break;
+        }
+        lp_client* c = ensure();
+        if (!c) {
+            const CallError unavailable =
+                callErrorObjectUnavailable(m_target, "could not create client for " + m_target);
+            if (ticket) ticket->finish(nlohmann::json(), unavailable);
+            cb(nlohmann::json(), unavailable);
+            return;
+        }
+        issueAsync(c, method, argsStr, timeout_ms,
+            [cb = std::forward<Callback>(cb), ticket = std::move(ticket)](int ok, const char* json) mutable {
+                CallError err;
+                nlohmann::json parsed = decodeAsyncReply(ok, json, err);
+                if (ticket) ticket->finish(parsed, err);
+                cb(std::move(parsed), err);
+            });
+    }
+
+    // The callback waits in a cell the token can empty, so cancel() destroys
+    // it (and whatever it captured) there and then. The completion keeps only
+    // the cell and the registration, and drops the registration when the
+    // reply lands, so a long-lived token is not left holding one per call.
+    template <typename Callback>
+    void invokeAsyncResultUntil(const std::string& method, const std::string& argsStr,
+                                Callback&& cb, const CancellationToken& token) {
+        if (token.cancelled()) return;
+        if (token.expired()) {
+            CallError late;
+            late.code = "timeout";
+            late.message = "the deadline passed before " + method + " was issued";
+            late.origin = m_target;
+            cb(nlohmann::json(), late);
+            return;
+        }
+        auto pending = std::make_shared<detail::CancellableCallback<std::decay_t<Callback>>>(
+            std::forward<Callback>(cb));
+        std::shared_ptr<void> registration = token.onCancel([pending] { pending->release(); });
+        invokeAsyncResultText(method, argsStr,
+            [pending, registration = std::move(registration), token](nlohmann::json value,
+                                                                     const CallError& err) mutable {
+                registration.reset();
+                auto cb = pending->take();
+                if (cb && !token.cancelled()) (*cb)(std::move(value), err);
+            },
+            token.remainingMs());
+    }
+
+    struct CachePolicy {
+        std::chrono::milliseconds ttl{0};
+        std::vector<std::string> invalidatedBy;
+        std::atomic<bool> armed{false};  // invalidation subscriptions in place
+    };
+
+    // What an issued call owes the cache and the callers that joined it, once
+    // its reply is in. Held by the completion, which may outlive this client,
+    // so it shares the cache and the flight table rather than pointing into
+    // them. A ticket dropped unfinished still lands its flight — with an
+    // error — so a joiner can never be left waiting.
+    struct CallTicket {
+        std::string method;
+        std::string args;
+        // Result cache: `cache` is null when the reply is not to be stored.
+        std::shared_ptr<ResultCache> cache;
+        std::chrono::milliseconds ttl{0};
+        std::uint64_t generation = 0;
+        // Single-flight: `flights` is null when this call leads no flight.
+        std::shared_ptr<SingleFlight> flights;
+        std::shared_ptr<InFlightCall> flight;
+        bool finished = false;
+
+        CallTicket() = default;
+        CallTicket(const CallTicket&) = delete;
+        CallTicket& operator=(const CallTicket&) = delete;
+        ~CallTicket() {
+            if (!finished && flights)
+                flights->finish(flightKey(method, args), flight, nlohmann::json(),
+                                callErrorCallFailed("", "the leading call was abandoned"));
+        }
+
+        void finish(const nlohmann::json& value, const CallError& error) {
+            finished = true;
+            if (cache && error.ok() && !looksLikeRejection(value))
+                cache->store(method, args, value, ttl, generation);
+            if (flights) flights->finish(flightKey(method, args), flight, value, error);
+        }
+    };
+
+    static std::string flightKey(const std::string& method, const std::string& args) {
+        std::string key;
+        key.reserve(method.size() + 1 + args.size());
+        key.append(method).push_back('\0');
+        key.append(args);
+        return key;
+    }
+
+    // The provider rejection object by SHAPE alone: exactly the three string
+    // fields {code, message, origin}. Broader than the generated detectors,
+    // which also match the code against a closed set — here a false match
+    // costs only a cache miss, and the shape does not drift the way the code
+    // vocabulary can.
+    static bool looksLikeRejection(const nlohmann::json& v) {
+        if (!v.is_object() || v.size() != 3) return false;
+        for (const char* key : {"code", "message", "origin"}) {
+            auto it = v.find(key);
+            if (it == v.end() || !it->is_string()) return false;
+        }
+        return true;
+    }
+
+    enum class Route {
+        Issue,   // go to the transport; `ticket`, when set, must be finished
+        Cached,  // answered: `hit` holds the remembered value
+        Joined,  // an identical call is out; hear from `joined`
+    };
+
+    // Where a call goes, before any of it touches the transport. A client with
+    // neither a cache nor single-flight configured pays two pointer tests.
+    // Without `mayJoin` (a blocking call) a call that finds an identical one
+    // out is issued alone, neither joining nor leading.
+    //
+    // A cached method whose invalidation subscriptions could not be taken is
+    // issued uncached this once; the next call tries again.
+    Route route(const std::string& method, const std::string& args, nlohmann::json& hit,
+                std::unique_ptr<CallTicket>& ticket, std::shared_ptr<InFlightCall>& joined,
+                bool mayJoin) {
+        if (!m_cache && !m_flights) return Route::Issue;
+        std::shared_ptr<ResultCache> cache;
+        std::chrono::milliseconds ttl{0};
+        std::uint64_t generation = 0;
+        if (m_cache) {
+            auto it = m_cachePolicies.find(method);
+            if (it != m_cachePolicies.end()) {
+                if (m_cache->lookup(method, args, hit, &generation)) return Route::Cached;
+                if (armInvalidation(method, *it->second)) {
+                    cache = m_cache;
+                    ttl = it->second->ttl;
+                }
+            }
+        }
+        std::shared_ptr<InFlightCall> flight;
+        if (m_flights && (m_singleFlightAll || m_singleFlightMethods.count(method))) {
+            if (mayJoin) {
+                bool leader = false;
+                flight = m_flights->join(flightKey(method, args), leader);
+                if (!leader) {
+                    joined = std::move(flight);
+                    return Route::Joined;
+                }
+            } else {
+                flight = m_flights->tryLead(flightKey(method, args));
+            }
+        }
+        if (cache || flight) {
+            ticket.reset(new CallTicket);
+            ticket->method = method;
+            ticket->args = args;
+            ticket->cache = std::move(cache);
+            ticket->ttl = ttl;
+            ticket->generation = generation;
+            if (flight) {
+                ticket->flights = m_flights;
+                ticket->flight = std::move(flight);
+            }
+        }
+        return Route::Issue;
+    }
+
+    // Subscribes the method's invalidating events, once. Like ensure(), it
+    // never holds a lock across the transport: racers each subscribe, one set
+    // is kept, and the losers' subscriptions are dropped outside the lock.
+    bool armInvalidation(const std::string& method, CachePolicy& policy) {
+        if (policy.armed.load(std::memory_order_acquire)) return true;
+        std::vector<LpSubscription> subs;
+        for (const std::string& event : policy.invalidatedBy) {
+            std::shared_ptr<ResultCache> cache = m_cache;
+            LpSubscription sub = subscribe(event, [cache, method](nlohmann::json) {
+                cache->invalidate(method);
+            });
+            if (!sub.valid()) return false;
+            subs.push_back(std::move(sub));
+        }
+        std::lock_guard<std::mutex> lock(m_cacheSubsMutex);
+        if (policy.armed.load(std::memory_order_relaxed)) {
+            // Lost the race: ours go when `subs` leaves scope, after the lock.
+            return true;
+        }
+        for (LpSubscription& sub : subs) m_cacheSubs.push_back(std::move(sub));
+        policy.armed.store(true, std::memory_order_release);
+        return true;
+    }
+
+    // Hands `onReply(ok, json)` to lp_invoke_async in a pooled slot. It runs
+    // exactly once: with the reply, or — when the call is refused
+    // synchronously, which the C ABI does NOT call back for — right here with
+    // the canonical call_failed error object, so every caller's completion
+    // fires on that path too. Under a concurrency limit the call takes a
+    // permit first, and may be issued later or fail `overloaded` instead.
+    template <typename OnReply>
+    void issueAsync(lp_client* c, const std::string& method, const std::string& argsStr,
+                    int timeout_ms, OnReply&& onReply) {
+        auto* slot = detail::CompletionSlot::make(std::forward<OnReply>(onReply));
+        if (!m_limiter) {
+            issueSlot(c, method.c_str(), argsStr.c_str(), timeout_ms, slot, m_target);
+            return;
+        }
+        if (!m_limiter->tryAcquire()) {
+            // Only a call that may wait pays for a copy of its text.
+            auto* queued = new QueuedCall(c, method, argsStr, timeout_ms, slot, m_limiter, m_target, m_origin);
+            switch (m_limiter->admit({&QueuedCall::run, queued})) {
+            case ConcurrencyLimiter::Admission::Queued:
+                return;
+            case ConcurrencyLimiter::Admission::Rejected:
+                delete queued;
+                detail::CompletionSlot::trampoline(
+                    0, errorText(overloaded(m_target, method)).c_str(), slot);
+                return;
+            case ConcurrencyLimiter::Admission::Admitted:
+                delete queued;
+                break;
+            }
+        }
+        issuePermitted(c, method.c_str(), argsStr.c_str(), timeout_ms, slot, m_limiter, m_target);
+    }
+
+    static void issueSlot(lp_client* c, const char* method, const char* argsStr, int timeout_ms,
+                          detail::CompletionSlot* slot, const std::string& target) {
+        const int rc = lp_invoke_async(c, method, argsStr, timeout_ms,
+                                       &detail::CompletionSlot::trampoline, slot);
+        if (rc != LP_OK) {
+            const std::string refusal = errorText(callErrorCallFailed(
+                target, "lp_invoke_async refused the call (rc=" + std::to_string(rc) + ")"));
+            detail::CompletionSlot::trampoline(0, refusal.c_str(), slot);
+        }
+    }
+
+    // Issues a call that holds a permit. The permit goes back as the reply
+    // lands and BEFORE the caller's completion runs, so a completion that
+    // makes its next call finds the permit it just freed.
+    static void issuePermitted(lp_client* c, const char* method, const char* argsStr,
+                               int timeout_ms, detail::CompletionSlot* reply,
+                               const std::shared_ptr<ConcurrencyLimiter>& limiter,
+                               const std::string& target) {
+        auto* permit = detail::CompletionSlot::make(
+            [limiter, issued = ConcurrencyLimiter::Clock::now(), reply](int ok, const char* json) {
+                limiter->release(issued);
+                detail::CompletionSlot::trampoline(ok, json, reply);
+            });
+        issueSlot(c, method, argsStr, timeout_ms, permit, target);
+    }
+
+    // An async call waiting in the limiter's line. It is started from another
+    // call's completion, which may run after this LpClient is gone, so it
+    // holds its own limiter and its own REGISTRY REFERENCE to the client.
+    // The destructor's abandon() cannot stand in for that reference: a
+    // completion takes the call off the line, and starts it only after it
+    // lets go of the limiter's lock, so abandon() can find the line empty
+    // and the client be destroyed before the call is issued on it.
+    struct QueuedCall {
+        QueuedCall(lp_client* c, std::string m, std::string a, int timeout,
+                   detail::CompletionSlot* r, std::shared_ptr<ConcurrencyLimiter> l,
+                   std::string t, std::string o)
+            : client(c), method(std::move(m)), args(std::move(a)), timeoutMs(timeout), reply(r),
+              limiter(std::move(l)), target(std::move(t)), origin(std::move(o)),
+              retained(LpClientRegistry::instance().retain(target, origin, client)) {}
+        ~QueuedCall() {
+            if (retained) LpClientRegistry::instance().release(target, origin, client);
+        }
+        QueuedCall(const QueuedCall&) = delete;
+        QueuedCall& operator=(const QueuedCall&) = delete;
+
+        lp_client* client;
+        std::string method;
+        std::string args;
+        int timeoutMs;
+        detail::CompletionSlot* reply;
+        std::shared_ptr<ConcurrencyLimiter> limiter;
+        std::string target;
+        std::string origin;
+        bool retained;
+
+        static void run(void* ud, bool admitted) {
+            std::unique_ptr<QueuedCall> q(static_cast<QueuedCall*>(ud));
+            if (admitted) {
+                issuePermitted(q->client, q->method.c_str(), q->args.c_str(), q->timeoutMs,
+                               q->reply, q->limiter, q->target);
+                return;
+            }
+            const std::string gone = errorText(callErrorObjectUnavailable(
+                q->target, "the client for " + q->target + " was destroyed before "
+                               + q->method + " was issued"));
+            detail::CompletionSlot::trampoline(0, gone.c_str(), q->reply);
+        }
+    };
+
+    // A blocking call waiting in the limiter's line. `run` sets the state and
+    // notifies under the lock: the waiter may return, and destroy this, the
+    // moment it sees the state change.
+    struct PermitWait {
+        std::mutex mutex;
+        std::condition_variable cv;
+        int state = 0;  // 0 waiting, 1 admitted, 2 turned away
+
+        static void run(void* ud, bool admitted) {
+            auto* w = static_cast<PermitWait*>(ud);
+            std::lock_guard<std::mutex> lock(w->mutex);
+            w->state = admitted ? 1 : 2;
+            w->cv.notify_one();
+        }
+    };
+
+    bool awaitPermit(const std::string& method, CallError& refused) {
+        if (m_limiter->tryAcquire()) return true;
+        PermitWait wait;
+        switch (m_limiter->admit({&PermitWait::run, &wait})) {
+        case ConcurrencyLimiter::Admission::Admitted:
+            return true;
+        case ConcurrencyLimiter::Admission::Rejected:
+            refused = overloaded(m_target, method);
+            return false;
+        case ConcurrencyLimiter::Admission::Queued:
+            break;
+        }
+        std::unique_lock<std::mutex> lock(wait.mutex);
+        wait.cv.wait(lock, [&wait] { return wait.state != 0; });
+        if (wait.state == 1) return true;
+        refused = callErrorObjectUnavailable(
+            m_target, "the client for " + m_target + " was destroyed before " + method + " was issued");
+        return false;
+    }
+
+    static CallError overloaded(const std::string& target, const std::string& method) {
+        CallError e;
+        e.code = "overloaded";
+        e.message = "too many calls in flight to " + target + "; " + method + " was not issued";
+        e.origin = target;
+        return e;
+    }
+
+    // A CallError as the C ABI's {code, message, origin} error object text,
+    // for completions that take the (ok, json) pair.
+    static std::string errorText(const CallError& e) {
+        return nlohmann::json{{"code", e.code}, {"message", e.message}, {"origin", e.origin}}.dump();
+    }
 
     // Create-once, and never while holding a lock.
     //
@@ -273,10 +1980,14 @@ private:
     //
     // A failed create is deliberately NOT latched: the next call retries, which
     // is what the pre-CAS version did.
+    //
+    // The client itself comes from the LpClientRegistry, which applies the same
+    // rule across LpClients; here a racer that loses the publish just gives its
+    // reference back.
     lp_client* ensure() {
         if (lp_client* c = m_client.load(std::memory_order_acquire))
             return c;
-        lp_client* fresh = lp_client_create(m_target.c_str(), m_origin.c_str(), nullptr, nullptr);
+        lp_client* fresh = LpClientRegistry::instance().acquire(m_target, m_origin);
         // Creation failed — report whatever is published (usually null, but a
         // racer may have succeeded meanwhile) rather than caching the failure.
         if (!fresh) return m_client.load(std::memory_order_acquire);
@@ -285,34 +1996,21 @@ private:
                                              std::memory_order_acq_rel,
                                              std::memory_order_acquire))
             return fresh;
-        lp_client_destroy(fresh);   // lost the publish race
+        LpClientRegistry::instance().release(m_target, m_origin, fresh);  // lost the publish race
         return expected;
     }
 
-    static void resultTrampoline(int ok, const char* json, void* ud) {
-        auto* fn = static_cast<Box*>(ud);
-        nlohmann::json r;  // null
-        if (ok && json) {
-            auto parsed = nlohmann::json::parse(json, nullptr, false);
-            if (!parsed.is_discarded()) r = std::move(parsed);
-        }
-        (*fn)(std::move(r));
-        delete fn;  // result callback fires exactly once
-    }
-
-    // The error-aware twin of resultTrampoline. `ok == 0` means `json` is the
+    // An lp_invoke_async reply as (value, error). `ok == 0` means `json` is the
     // canonical error object rather than a value, so the value is dropped and
     // the error decoded; a malformed/absent one still yields a NON-ok
     // CallError, because reporting ok() for a call the ABI said failed is the
-    // one outcome this trampoline exists to prevent.
-    static void resultErrorTrampoline(int ok, const char* json, void* ud) {
-        auto* fn = static_cast<ResultErrBox*>(ud);
+    // one outcome the error-carrying paths exist to prevent.
+    static nlohmann::json decodeAsyncReply(int ok, const char* json, CallError& err) {
         nlohmann::json parsed;  // null
         if (json) {
             auto p = nlohmann::json::parse(json, nullptr, /*allow_exceptions=*/false);
             if (!p.is_discarded()) parsed = std::move(p);
         }
-        CallError err;
         if (!ok) {
             err = callErrorCallFailed("", "lp_invoke_async failed");
             if (parsed.is_object()) {
@@ -325,21 +2023,60 @@ private:
             }
             parsed = nlohmann::json();
         }
-        (*fn)(std::move(parsed), err);
-        delete fn;  // result callback fires exactly once
+        return parsed;
     }
 
-    static void eventTrampoline(const char* /*eventName*/, const char* dataJson, void* ud) {
-        auto* fn = static_cast<Box*>(ud);
-        nlohmann::json r = nlohmann::json::array();
-        if (dataJson) {
-            auto parsed = nlohmann::json::parse(dataJson, nullptr, false);
-            if (!parsed.is_discarded()) r = std::move(parsed);
+    // One invokeBatch in flight. Each slot of `results` is written by exactly
+    // one completion, and `remaining` hands the finished vector to whichever
+    // completion is last; its acq_rel decrement is what makes every other
+    // slot's write visible there.
+    struct BatchState {
+        std::vector<LpCall> calls;
+        std::vector<AsyncResult<nlohmann::json>> results;
+        std::atomic<std::size_t> remaining{0};
+        std::function<void(std::vector<AsyncResult<nlohmann::json>>)> done;
+    };
+
+    static void completeBatchCall(BatchState& batch, std::size_t index,
+                                  nlohmann::json value, const CallError& err) {
+        LpCall& call = batch.calls[index];
+        if (!batch.done) {
+            // Nobody reads the vector, so the value goes to the call alone.
+            if (call.onResult) call.onResult(std::move(value), err);
+        } else {
+            if (call.onResult) call.onResult(value, err);
+            batch.results[index].value = std::move(value);
+            batch.results[index].error = err;
         }
-        (*fn)(std::move(r));
+        if (batch.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1 && batch.done)
+            batch.done(std::move(batch.results));
     }
 
-    static void deleteBox(void* p) { delete static_cast<Box*>(p); }
+    // The hub for `event`: the live one, or a new one, subscribed. Like
+    // ensure(), it never holds a lock across the transport: racers for a new
+    // hub each subscribe, one hub is kept, and the others unsubscribe as they
+    // are dropped, outside the lock.
+    std::shared_ptr<detail::EventHub> eventHub(const std::string& event) {
+        {
+            std::lock_guard<std::mutex> lock(m_hubsMutex);
+            auto it = m_hubs.find(event);
+            if (it != m_hubs.end()) {
+                if (std::shared_ptr<detail::EventHub> live = it->second.lock()) return live;
+            }
+        }
+        if (!ensure()) return nullptr;
+        auto fresh = std::make_shared<detail::EventHub>(m_target, m_origin, event);
+        if (!fresh->open()) return nullptr;
+        std::lock_guard<std::mutex> lock(m_hubsMutex);
+        std::weak_ptr<detail::EventHub>& slot = m_hubs[event];
+        if (std::shared_ptr<detail::EventHub> live = slot.lock()) {
+            // Lost the race: `fresh` goes when it leaves scope. Its
+            // subscription never had a listener to call.
+            return live;
+        }
+        slot = fresh;
+        return fresh;
+    }
 
     static void fillErr(CallError* err, const char* errJson, int rc) {
         if (!err) return;
@@ -360,6 +2097,28 @@ private:
     std::string m_origin;
     // Published exactly once by ensure(); read from any thread.
     std::atomic<lp_client*> m_client{nullptr};
+
+    // Null until cacheMethod / setCacheCapacity, so an uncached client pays
+    // one pointer test per call.
+    std::shared_ptr<ResultCache> m_cache;
+    std::map<std::string, std::unique_ptr<CachePolicy>> m_cachePolicies;
+    std::mutex m_cacheSubsMutex;
+    std::vector<LpSubscription> m_cacheSubs;
+
+    // Null until singleFlight(); configured before the first call, like the
+    // cache policies.
+    std::shared_ptr<SingleFlight> m_flights;
+    std::set<std::string> m_singleFlightMethods;
+    bool m_singleFlightAll = false;
+
+    // One hub per subscribed event, held by its listeners' handles. An entry
+    // whose hub has gone is replaced on the event's next subscribe.
+    std::mutex m_hubsMutex;
+    std::map<std::string, std::weak_ptr<detail::EventHub>> m_hubs;
+
+    // Null until limitConcurrency(). Shared with the completions that hand
+    // its permits back, which may land after this client is gone.
+    std::shared_ptr<ConcurrencyLimiter> m_limiter;
 };
 
 }  // namespace logos
@@ -216,6 +216,24 @@ public:
         m_emitEventCallback = std::move(cb);
     }
 
+    // Framework-only — installs the callback the bodies of COALESCIBLE events
+    // (`@coalesce` in the event's doc comment) invoke instead of the emit
+    // callback. Same `void*` payload; the export TU keeps only the newest one
+    // per event and delivers it at a bounded rate.
+    void _logosCoreSetCoalesceEvent_(std::function<void(const std::string&, void*)> cb) {
+        m_coalesceEventCallback = std::move(cb);
+    }
+
+    // Framework-only — installs the pair batchEvents() drives. `begin` opens
+    // (or nests) a batch on the calling thread; `end` closes it and, at the
+    // outermost level, hands everything it collected to the host. The
+    // batching state itself lives in the generated C-ABI export TU, next to
+    // the emit callback it buffers for.
+    void _logosCoreSetEventBatching_(std::function<void()> begin, std::function<void()> end) {
+        m_eventBatchBegin = std::move(begin);
+        m_eventBatchEnd = std::move(end);
+    }
+
     // Framework-only — installs the callback `unloadFinished()` fires. Left
     // empty outside a framework context, which is what makes unloadFinished()
     // a no-op there rather than a crash.
@@ -242,6 +260,65 @@ protected:
             m_emitEventCallback(eventName, args);
     }
 
+    // The body of an event marked `@coalesce` calls this instead of
+    // emitEventImpl_. The event is a state snapshot — progress, a peer count —
+    // so only its newest value matters: a payload still waiting to go out is
+    // REPLACED by the next one rather than queued behind it, and what is
+    // pending is delivered at a bounded rate and whenever a dispatch returns.
+    // A subscriber sees fewer events, and always the latest.
+    //
+    // Falls back to an immediate emit when no coalescing callback is installed,
+    // so a coalescible event is never lost to wiring it was not given.
+    void coalesceEventImpl_(const std::string& eventName, void* args) const {
+        if (m_coalesceEventCallback)
+            m_coalesceEventCallback(eventName, args);
+        else
+            emitEventImpl_(eventName, args);
+    }
+
+    // Scoped event batching. While an EventBatch is alive, typed
+    // `logos_events:` emissions made on the SAME thread are collected instead
+    // of sent, and handed to the host together when the batch goes out of
+    // scope. A host that accepts batches gets one callback with one array
+    // payload; any other host gets the events one by one, in order, at that
+    // point. Either way the per-event cost of the crossing is paid once per
+    // batch instead of once per event.
+    //
+    //     void ChainSync::applyBlocks(const std::vector<Block>& blocks) {
+    //         auto batch = batchEvents();
+    //         for (const Block& b : blocks)
+    //             blockSeen(b.height, b.hash);   // buffered
+    //     }                                      // one crossing, here
+    //
+    // Batches nest; only the outermost one flushes. Events emitted on other
+    // threads are not held back, so a batch delays its own thread's events
+    // and reorders nothing else. A very long batch is flushed in chunks
+    // rather than held whole. Outside a framework context this is inert,
+    // like emitEventImpl_ itself.
+    class EventBatch {
+    public:
+        EventBatch(EventBatch&& other) noexcept : m_end(other.m_end) { other.m_end = nullptr; }
+        EventBatch(const EventBatch&) = delete;
+        EventBatch& operator=(const EventBatch&) = delete;
+        EventBatch& operator=(EventBatch&&) = delete;
+        ~EventBatch() {
+            if (m_end)
+                (*m_end)();
+        }
+
+    private:
+        friend class LogosModuleContext;
+        explicit EventBatch(const std::function<void()>* end) : m_end(end) {}
+        const std::function<void()>* m_end;
+    };
+
+    EventBatch batchEvents() const {
+        if (!m_eventBatchBegin || !m_eventBatchEnd)
+            return EventBatch(nullptr);
+        m_eventBatchBegin();
+        return EventBatch(&m_eventBatchEnd);
+    }
+
 protected:
     // Hook for derived impls. Fires exactly once, after the three
     // getters above become readable, before any method dispatch. The
@@ -303,6 +380,13 @@ private:
     // when the impl is constructed outside a framework-provisioned
     // context, in which case `emitEventImpl_` becomes a no-op.
     std::function<void(const std::string&, void*)> m_emitEventCallback;
+    // Installed with the emit callback; empty when the module declares no
+    // coalescible event, and then coalesceEventImpl_ emits directly.
+    std::function<void(const std::string&, void*)> m_coalesceEventCallback;
+    // Installed with the emit callback; both empty outside a framework
+    // context, which is what makes batchEvents() inert there.
+    std::function<void()> m_eventBatchBegin;
+    std::function<void()> m_eventBatchEnd;
     // Installed by the host before it calls _logosCoreAboutToUnload_. Empty
     // outside a framework context; see unloadFinished().
     std::function<void()> m_unloadFinishedCallback;
@@ -397,6 +481,36 @@ inline auto maybeSetEmitEvent(T&, std::function<void(const std::string&, void*)>
     // Module impl didn't opt into LogosModuleContext; nothing to do.
 }
 
+// Installs the coalescing callback. Same tag-dispatch again.
+template<class T>
+inline auto maybeSetCoalesceEvent(T& impl, std::function<void(const std::string&, void*)> cb)
+    -> std::enable_if_t<std::is_base_of_v<LogosModuleContext, T>>
+{
+    static_cast<LogosModuleContext&>(impl)._logosCoreSetCoalesceEvent_(std::move(cb));
+}
+
+template<class T>
+inline auto maybeSetCoalesceEvent(T&, std::function<void(const std::string&, void*)>)
+    -> std::enable_if_t<!std::is_base_of_v<LogosModuleContext, T>>
+{
+    // Module impl didn't opt into LogosModuleContext; nothing to do.
+}
+
+// Installs batchEvents()'s begin/end pair. Same tag-dispatch again.
+template<class T>
+inline auto maybeSetEventBatching(T& impl, std::function<void()> begin, std::function<void()> end)
+    -> std::enable_if_t<std::is_base_of_v<LogosModuleContext, T>>
+{
+    static_cast<LogosModuleContext&>(impl)._logosCoreSetEventBatching_(std::move(begin), std::move(end));
+}
+
+template<class T>
+inline auto maybeSetEventBatching(T&, std::function<void()>, std::function<void()>)
+    -> std::enable_if_t<!std::is_base_of_v<LogosModuleContext, T>>
+{
+    // Module impl didn't opt into LogosModuleContext; nothing to do.
+}
+
 // Teardown, for an impl that opted into LogosModuleContext. Same tag-dispatch
 // as the setters above: an impl that did not inherit the context reports
 // Synchronous, which is exactly right -- it has no hook, so there is nothing to
@@ -0,0 +1,127 @@
+#pragma once
+// ---------------------------------------------------------------------------
+// A C ABI reply, serialized straight into the buffer the ABI hands back.
+//
+// Every module-impl export that answers with JSON returns a malloc'd,
+// NUL-terminated char* which the host releases through
+// logos_module_string_free (std::free). The generated dispatch used to get
+// there in three steps: build the reply as an nlohmann::json, `.dump()` it into
+// a std::string, then malloc a second buffer and memcpy the string into it. That
+// is two full copies of every reply, and two allocations on top of the value's
+// own, for bytes that are written once and read once by the host. On a large
+// `[Record]` return both copies are the size of the payload, and the DOM they
+// were dumped from costs as much again.
+//
+// logos::ReplyWriter writes the reply's text directly into one malloc'd buffer,
+// grown in place with realloc, and hands that buffer over. It is the writer
+// ArgsWriter is (logos_json_writer.h), so the bytes are the ones `.dump()`
+// produces (down to the rare double spelled with other digits that read back
+// the same) — compact, UTF-8 passed through, and the same strict handling of
+// invalid UTF-8 (it throws nlohmann::json::type_error, which the dispatch
+// reports as dispatch_failed exactly as it did when `.dump()` threw). The
+// generated dispatch writes a typed return with it field by field, through a
+// writer it emits per record; no DOM is built.
+//
+// dumpToMalloc() is the fallback for a value that is JSON already — `any`,
+// LogosMap, LogosList — and for the result object: it walks the DOM it is
+// given straight into the same kind of buffer, with no dump() string between.
+//
+// Qt-FREE. Returns NULL only if an allocation fails, which is what the
+// generated lidlStrdup already answered in that case.
+// ---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+#include <nlohmann/json.hpp>
+
+#include "logos_json_writer.h"
+
+namespace logos {
+
+namespace detail {
+
+// JsonWriter's text in a malloc'd buffer. An allocation failure is remembered
+// rather than thrown: the writes after it are dropped and release() answers
+// NULL.
+class MallocText {
+public:
+    MallocText() { grow(64); }
+    ~MallocText() { std::free(m_buf); }
+    MallocText(const MallocText&) = delete;
+    MallocText& operator=(const MallocText&) = delete;
+
+    void push_back(char c) {
+        if (!reserveFor(1)) return;
+        m_buf[m_len++] = c;
+    }
+
+    void append(const char* s, std::size_t length) {
+        if (!reserveFor(length)) return;
+        std::memcpy(m_buf + m_len, s, length);
+        m_len += length;
+    }
+
+    void reserve(std::size_t n) {
+        if (n > m_len) reserveFor(n - m_len);
+    }
+
+    std::size_t size() const { return m_len; }
+
+    // The finished, NUL-terminated buffer; ownership passes to the caller.
+    // NULL if any allocation along the way failed.
+    char* release() {
+        if (m_failed || !m_buf) return nullptr;
+        m_buf[m_len] = '\0';
+        char* out = m_buf;
+        m_buf = nullptr;
+        m_len = m_cap = 0;
+        return out;
+    }
+
+private:
+    // Room for `n` more bytes AND the terminator, so release() never grows.
+    bool reserveFor(std::size_t n) {
+        if (m_failed) return false;
+        if (m_len + n < m_cap) return true;
+        std::size_t want = m_cap ? m_cap : 64;
+        while (want <= m_len + n) want *= 2;
+        return grow(want);
+    }
+
+    bool grow(std::size_t cap) {
+        char* p = static_cast<char*>(std::realloc(m_buf, cap));
+        if (!p) { m_failed = true; return false; }
+        m_buf = p;
+        m_cap = cap;
+        return true;
+    }
+
+    char* m_buf = nullptr;
+    std::size_t m_len = 0;
+    std::size_t m_cap = 0;
+    bool m_failed = false;
+};
+
+}  // namespace detail
+
+// One reply: a single value, written as JSON text.
+class ReplyWriter : public detail::JsonWriter<ReplyWriter, detail::MallocText> {
+public:
+    ReplyWriter() = default;
+
+    // The reply, NUL-terminated, in a buffer std::free (and so
+    // logos_module_string_free) releases; NULL if an allocation failed.
+    char* release() { return m_buf.release(); }
+};
+
+// `j.dump()`'s text, written into a single malloc'd buffer that std::free
+// releases. Throws what `.dump()` throws.
+inline char* dumpToMalloc(const nlohmann::json& j) {
+    ReplyWriter out;
+    out.value(j);
+    return out.release();
+}
+
+}  // namespace logos
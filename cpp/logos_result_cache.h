@@ -0,0 +1,161 @@
+#ifndef LOGOS_RESULT_CACHE_H
+#define LOGOS_RESULT_CACHE_H
+
+// ---------------------------------------------------------------------------
+// logos::ResultCache — remembered answers to pure reads.
+//
+// Many dependency methods are reads whose answer changes rarely (`getConfig`,
+// `resolveName`), and a consumer asks them the same question again and again.
+// Each ask is a full cross-process round trip. logos::LpClient keeps one of
+// these per target and consults it for the methods a contract marks cacheable
+// (see LpClient::cacheMethod), so a repeat read within the TTL is answered
+// locally.
+//
+// Entries are keyed by method plus the serialized arguments, expire after the
+// method's TTL, and are evicted least-recently-used beyond a fixed capacity.
+// invalidate(method) drops a method's entries — LpClient calls it when one of
+// the method's invalidating events arrives from the target.
+//
+// A call that was already in flight when its method was invalidated must not
+// put its (possibly pre-change) answer back. So a miss hands out the method's
+// GENERATION, invalidate() bumps it, and store() discards an answer whose
+// generation is no longer current.
+//
+// Thread-safe; one mutex, held only for the map and list operations.
+//
+// Qt-FREE, std + nlohmann only.
+// ---------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+namespace logos {
+
+class ResultCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit ResultCache(std::size_t capacity = 256) : m_capacity(capacity) {}
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    // True and `out` filled on a live hit. On a miss, `generation` (when
+    // non-null) receives the token store() needs.
+    bool lookup(const std::string& method, const std::string& args, nlohmann::json& out,
+                std::uint64_t* generation = nullptr, Clock::time_point now = Clock::now())
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_index.find(keyFor(method, args));
+        if (it != m_index.end()) {
+            if (it->second->expires > now) {
+                m_lru.splice(m_lru.begin(), m_lru, it->second);
+                out = it->second->value;
+                return true;
+            }
+            m_lru.erase(it->second);
+            m_index.erase(it);
+        }
+        if (generation) *generation = generationLocked(method);
+        return false;
+    }
+
+    // Remembers `value` for `ttl`, unless the method was invalidated since the
+    // lookup that handed out `generation`.
+    void store(const std::string& method, const std::string& args, nlohmann::json value,
+               std::chrono::milliseconds ttl, std::uint64_t generation,
+               Clock::time_point now = Clock::now())
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_capacity == 0 || generation != generationLocked(method)) return;
+        std::string key = keyFor(method, args);
+        auto it = m_index.find(key);
+        if (it != m_index.end()) {
+            it->second->value = std::move(value);
+            it->second->expires = now + ttl;
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            return;
+        }
+        m_lru.push_front(Entry{method, key, std::move(value), now + ttl});
+        m_index.emplace(std::move(key), m_lru.begin());
+        while (m_lru.size() > m_capacity) {
+            m_index.erase(m_lru.back().key);
+            m_lru.pop_back();
+        }
+    }
+
+    // Drops every entry of `method`, or of every method when it is empty.
+    void invalidate(const std::string& method = std::string())
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (method.empty()) ++m_epoch;
+        else ++m_generations[method];
+        for (auto it = m_lru.begin(); it != m_lru.end();) {
+            if (method.empty() || it->method == method) {
+                m_index.erase(it->key);
+                it = m_lru.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void setCapacity(std::size_t capacity)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_capacity = capacity;
+        while (m_lru.size() > m_capacity) {
+            m_index.erase(m_lru.back().key);
+            m_lru.pop_back();
+        }
+    }
+
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_lru.size();
+    }
+
+private:
+    struct Entry {
+        std::string method;
+        std::string key;
+        nlohmann::json value;
+        Clock::time_point expires;
+    };
+
+    // Method names cannot contain a NUL, so it separates the two unambiguously.
+    static std::string keyFor(const std::string& method, const std::string& args)
+    {
+        std::string key;
+        key.reserve(method.size() + 1 + args.size());
+        key.append(method).push_back('\0');
+        key.append(args);
+        return key;
+    }
+
+    std::uint64_t generationLocked(const std::string& method) const
+    {
+        auto it = m_generations.find(method);
+        return m_epoch + (it == m_generations.end() ? 0 : it->second);
+    }
+
+    mutable std::mutex m_mutex;
+    std::size_t m_capacity;
+    std::list<Entry> m_lru;  // most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+    std::map<std::string, std::uint64_t> m_generations;
+    std::uint64_t m_epoch = 0;
+};
+
+} // namespace logos
+
+#endif // LOGOS_RESULT_CACHE_H
@@ -0,0 +1,323 @@
+#pragma once
+// ---------------------------------------------------------------------------
+// THE SCALAR FAST PATH — reading a positional argument array without a DOM.
+//
+// The generated cdylib dispatch parses `args_json` into an nlohmann::json tree
+// and then pulls each argument back out through logos::fromJson<T>. For a
+// method like `add(int, int)` or `getBalance(tstr)` that tree is most of the
+// call: an array node, a node per argument, a string copy per tstr — all built
+// to be read once and thrown away.
+//
+// ScalarArgs reads the same bytes in place, one argument at a time, straight
+// into the C++ type the impl takes. The generator uses it for every method
+// whose parameters are ALL LIDL scalars (int / uint / float64 / bool / tstr),
+// and only as a first attempt:
+//
+//     logos::ScalarArgs in(args_json);
+//     int64_t arg0; std::string arg1;
+//     if (in.read(arg0) && in.read(arg1) && in.atEnd())
+//         ...call the impl...
+//     // otherwise: fall through to the DOM path, unchanged
+//
+// THE RULE THAT MAKES THIS SAFE: a read only ever ACCEPTS a value the DOM path
+// would have accepted, decoded to the same value. Anything else — a type
+// mismatch, a missing or extra argument, a nested value, malformed JSON, a
+// number out of range, a lone surrogate — answers false, and the caller falls
+// back to the full parse. So every rejection still produces the reply it always
+// did (`invalid_args` with its count, `dispatch_failed` with logos::Codec's
+// path and message, NULL for bad JSON), from the code that always produced it.
+// The scanner never has to reproduce an error, only to recognise the common
+// case of a well-typed call.
+//
+// What "would have accepted" means per type, which is Codec<T>::from's rule:
+//
+//   int      an integer literal (no fraction, no exponent) in int64 range
+//   uint     an integer literal without a sign, in uint64 range
+//   float64  any JSON number, as strtod reads it (finite only)
+//   bool     `true` / `false`
+//   tstr     a JSON string, escapes decoded, UTF-8 validated
+//
+// `null` is accepted for none of them: a scalar slot is not optional, and the
+// generator does not take this path for a method with an optional parameter.
+//
+// Qt-FREE and allocation-free except for the tstr value itself, which is
+// decoded straight into the caller's std::string.
+// ---------------------------------------------------------------------------
+
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+namespace logos {
+
+class ScalarArgs {
+public:
+    // `json` may be NULL or empty, which the dispatch has always read as `[]`.
+    // Anything that does not open an array leaves the reader failed.
+    explicit ScalarArgs(const char* json) : m_p(json) {
+        if (!m_p || !*m_p) { m_p = ""; m_empty = true; return; }
+        skipWs();
+        if (*m_p != '[') { m_failed = true; return; }
+        ++m_p;
+        skipWs();
+        if (*m_p == ']') { ++m_p; m_empty = true; }
+    }
+
+    bool read(int64_t& out) {
+        const char* start = nullptr;
+        bool negative = false;
+        if (!beginValue() || !scanNumber(start, negative, /*integerOnly=*/true)) return fail();
+        const char* p = start + (negative ? 1 : 0);
+        // Accumulate as the magnitude, so INT64_MIN (whose magnitude is one
+        // more than INT64_MAX) is reachable without overflowing.
+        uint64_t mag = 0;
+        for (; p < m_p; ++p) {
+            const uint64_t d = static_cast<uint64_t>(*p - '0');
+            if (mag > (UINT64_MAX - d) / 10) return fail();
+            mag = mag * 10 + d;
+        }
+        if (negative) {
+            if (mag > static_cast<uint64_t>(INT64_MAX) + 1) return fail();
+            out = mag == static_cast<uint64_t>(INT64_MAX) + 1
+                ? INT64_MIN : -static_cast<int64_t>(mag);
+        } else {
+            if (mag > static_cast<uint64_t>(INT64_MAX)) return fail();
+            out = static_cast<int64_t>(mag);
+        }
+        return endValue();
+    }
+
+    bool read(uint64_t& out) {
+        const char* start = nullptr;
+        bool negative = false;
+        if (!beginValue() || !scanNumber(start, negative, /*integerOnly=*/true)) return fail();
+        // Even `-0`: whether the DOM path takes it as unsigned is the codec's
+        // call to make, not this reader's.
+        if (negative) return fail();
+        uint64_t v = 0;
+        for (const char* p = start; p < m_p; ++p) {
+            const uint64_t d = static_cast<uint64_t>(*p - '0');
+            if (v > (UINT64_MAX - d) / 10) return fail();
+            v = v * 10 + d;
+        }
+        out = v;
+        return endValue();
+    }
+
+    bool read(double& out) {
+        const char* start = nullptr;
+        bool negative = false;
+        if (!beginValue() || !scanNumber(start, negative, /*integerOnly=*/false)) return fail();
+        // The token has been checked against the JSON grammar above, so
+        // strtod reads exactly it — except under a locale whose decimal point
+        // is not '.', where the DOM path has its own workaround and this one
+        // simply steps aside.
+        const char* dp = std::localeconv()->decimal_point;
+        if (!dp || dp[0] != '.' || dp[1] != '\0') return fail();
+        char* end = nullptr;
+        const double v = std::strtod(start, &end);
+        if (end != m_p || !std::isfinite(v)) return fail();
+        out = v;
+        return endValue();
+    }
+
+    bool read(bool& out) {
+        if (!beginValue()) return fail();
+        if (matchWord("true")) out = true;
+        else if (matchWord("false")) out = false;
+        else return fail();
+        return endValue();
+    }
+
+    bool read(std::string& out) {
+        if (!beginValue() || *m_p != '"') return fail();
+        ++m_p;
+        out.clear();
+        for (;;) {
+            const unsigned char c = static_cast<unsigned char>(*m_p);
+            if (c == '"') { ++m_p; break; }
+            if (c == '\0' || c < 0x20) return fail();   // unterminated / raw control
+            if (c == '\\') {
+                if (!readEscape(out)) return fail();
+                continue;
+            }
+            if (c < 0x80) { out.push_back(static_cast<char>(c)); ++m_p; continue; }
+            if (!copyUtf8(out)) return fail();
+        }
+        return endValue();
+    }
+
+    // True when every argument has been read and nothing but the closing
+    // bracket (and whitespace) is left. An array with MORE elements than were
+    // read is not at its end: extra arguments are the DOM path's to ignore.
+    bool atEnd() {
+        if (m_failed) return false;
+        if (!m_empty) return fail();
+        skipWs();
+        return *m_p == '\0' || fail();
+    }
+
+private:
+    bool fail() { m_failed = true; return false; }
+
+    void skipWs() {
+        while (*m_p == ' ' || *m_p == '\t' || *m_p == '\n' || *m_p == '\r') ++m_p;
+    }
+
+    bool beginValue() {
+        if (m_failed || m_empty) return false;
+        skipWs();
+        return true;
+    }
+
+    // After a value: either `,` (another follows) or `]` (this was the last).
+    bool endValue() {
+        skipWs();
+        if (*m_p == ',') { ++m_p; skipWs(); return *m_p != ']' || fail(); }
+        if (*m_p == ']') { ++m_p; m_empty = true; return true; }
+        return fail();
+    }
+
+    bool matchWord(const char* w) {
+        const char* p = m_p;
+        for (; *w; ++w, ++p)
+            if (*p != *w) return false;
+        m_p = p;
+        return true;
+    }
+
+    // The JSON number grammar, exactly: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+    // Leaves m_p one past the token and `start` on its first byte.
+    bool scanNumber(const char*& start, bool& negative, bool integerOnly) {
+        start = m_p;
+        const char* p = m_p;
+        negative = *p == '-';
+        if (negative) ++p;
+        if (*p == '0') ++p;
+        else if (*p >= '1' && *p <= '9') { while (*p >= '0' && *p <= '9') ++p; }
+        else return false;
+        bool integral = true;
+        if (*p == '.') {
+            ++p;
+            if (!(*p >= '0' && *p <= '9')) return false;
+            while (*p >= '0' && *p <= '9') ++p;
+            integral = false;
+        }
+        if (*p == 'e' || *p == 'E') {
+            ++p;
+            if (*p == '+' || *p == '-') ++p;
+            if (!(*p >= '0' && *p <= '9')) return false;
+            while (*p >= '0' && *p <= '9') ++p;
+            integral = false;
+        }
+        // `3.0` and `1e2` are floats to the DOM path too, and an integer slot
+        // rejects them there; so must this one.
+        if (integerOnly && !integral) return false;
+        m_p = p;
+        return true;
+    }
+
+    static int hexDigit(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    bool readHex4(uint32_t& out) {
+        uint32_t v = 0;
+        for (int i = 0; i < 4; ++i) {
+            const int d = hexDigit(m_p[i]);
+            if (d < 0) return false;
+            v = (v << 4) | static_cast<uint32_t>(d);
+        }
+        m_p += 4;
+        out = v;
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, uint32_t cp) {
+        if (cp < 0x80) {
+            out.push_back(static_cast<char>(cp));
+        } else if (cp < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+    }
+
+    bool readEscape(std::string& out) {
+        ++m_p;   // the backslash
+        const char e = *m_p++;
+        switch (e) {
+        case '"':  out.push_back('"');  return true;
+        case '\\': out.push_back('\\'); return true;
+        case '/':  out.push_back('/');  return true;
+        case 'b':  out.push_back('\b'); return true;
+        case 'f':  out.push_back('\f'); return true;
+        case 'n':  out.push_back('\n'); return true;
+        case 'r':  out.push_back('\r'); return true;
+        case 't':  out.push_back('\t'); return true;
+        case 'u': {
+            uint32_t cp = 0;
+            if (!readHex4(cp)) return false;
+            if (cp >= 0xDC00 && cp <= 0xDFFF) return false;   // lone low surrogate
+            if (cp >= 0xD800 && cp <= 0xDBFF) {
+                // A high surrogate is only half a code point; the other half
+                // must follow as its own escape, or the string is malformed.
+                if (m_p[0] != '\\' || m_p[1] != 'u') return false;
+                m_p += 2;
+                uint32_t lo = 0;
+                if (!readHex4(lo) || lo < 0xDC00 || lo > 0xDFFF) return false;
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+            }
+            appendUtf8(out, cp);
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    // One well-formed UTF-8 sequence (RFC 3629: no overlongs, no encoded
+    // surrogates, nothing past U+10FFFF), copied through as-is.
+    bool copyUtf8(std::string& out) {
+        const auto* p = reinterpret_cast<const unsigned char*>(m_p);
+        int len = 0;
+        unsigned char lo = 0x80, hi = 0xBF;
+        if (p[0] >= 0xC2 && p[0] <= 0xDF) len = 2;
+        else if (p[0] >= 0xE0 && p[0] <= 0xEF) {
+            len = 3;
+            if (p[0] == 0xE0) lo = 0xA0;
+            if (p[0] == 0xED) hi = 0x9F;
+        } else if (p[0] >= 0xF0 && p[0] <= 0xF4) {
+            len = 4;
+            if (p[0] == 0xF0) lo = 0x90;
+            if (p[0] == 0xF4) hi = 0x8F;
+        } else {
+            return false;
+        }
+        if (p[1] < lo || p[1] > hi) return false;
+        for (int i = 2; i < len; ++i)
+            if (p[i] < 0x80 || p[i] > 0xBF) return false;
+        out.append(m_p, static_cast<size_t>(len));
+        m_p += len;
+        return true;
+    }
+
+    const char* m_p;
+    bool m_empty = false;    // the closing bracket has been consumed
+    bool m_failed = false;
+};
+
+}  // namespace logos
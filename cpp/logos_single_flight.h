@@ -0,0 +1,135 @@
+#ifndef LOGOS_SINGLE_FLIGHT_H
+#define LOGOS_SINGLE_FLIGHT_H
+
+// ---------------------------------------------------------------------------
+// logos::SingleFlight — one transport request for many identical calls.
+//
+// A concurrency:"multi" module that has just started runs dozens of handlers at
+// once, and they tend to ask their dependencies the same question at the same
+// moment: `config.get()`, `registry.resolve("x")`. Each becomes its own
+// request, and the dependency answers the same thing dozens of times. With
+// single-flight on for that method (LpClient::singleFlight), the first caller
+// LEADS: it issues the request. Every identical call that arrives while it is
+// out JOINS it and is handed the leader's outcome, value and error alike.
+// The flight is over the moment the reply lands; the next call leads again.
+//
+// "Identical" is method plus serialized arguments, as for the result cache.
+// The leader's deadline is the one the flight runs under, and a joiner's own
+// timeout_ms is not consulted.
+//
+// Only a caller that is called back joins. A blocking caller could not honour
+// its own timeout while it waited on someone else's request, and on a
+// Qt-affine host it could be the very thread that request needs to land; so
+// it may lead a flight (tryLead) but never waits on one, and issues its own
+// request when one is already out.
+//
+// Thread-safe. A joiner's callback runs on the thread that lands the flight,
+// exactly as if it had been the leader.
+//
+// Qt-FREE, std + nlohmann only.
+// ---------------------------------------------------------------------------
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "logos_call_error.h"
+
+namespace logos {
+
+// One call in flight, and the outcome its joiners are waiting for. The value
+// and error are written once, under the mutex, before `m_landed` is set, and
+// never again — so whoever has seen `m_landed` reads them without the lock.
+class InFlightCall {
+public:
+    using Waiter = std::function<void(const nlohmann::json&, const CallError&)>;
+
+    // Runs `waiter` with the outcome: later, on the landing thread, or now, on
+    // this one, if the call has already landed.
+    void then(Waiter waiter)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_landed) {
+                m_waiters.push_back(std::move(waiter));
+                return;
+            }
+        }
+        waiter(m_value, m_error);
+    }
+
+    void land(nlohmann::json value, const CallError& error)
+    {
+        std::vector<Waiter> waiters;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_value = std::move(value);
+            m_error = error;
+            m_landed = true;
+            waiters.swap(m_waiters);
+        }
+        for (Waiter& w : waiters) w(m_value, m_error);
+    }
+
+private:
+    std::mutex m_mutex;
+    bool m_landed = false;
+    nlohmann::json m_value;
+    CallError m_error;
+    std::vector<Waiter> m_waiters;
+};
+
+class SingleFlight {
+public:
+    // The call in flight for `key`, or a new one. `leader` is set when it is
+    // new, in which case the caller must issue it and finish() it.
+    std::shared_ptr<InFlightCall> join(const std::string& key, bool& leader)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_inFlight.find(key);
+        leader = (it == m_inFlight.end());
+        if (!leader) return it->second;
+        auto call = std::make_shared<InFlightCall>();
+        m_inFlight.emplace(key, call);
+        return call;
+    }
+
+    // A new flight for `key`, which the caller must issue and finish(); null
+    // when one is already out, in which case the caller goes alone rather
+    // than joining it.
+    std::shared_ptr<InFlightCall> tryLead(const std::string& key)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_inFlight.count(key)) return nullptr;
+        auto call = std::make_shared<InFlightCall>();
+        m_inFlight.emplace(key, call);
+        return call;
+    }
+
+    // Ends the flight and hands the outcome to its joiners. A call arriving
+    // from here on leads a flight of its own.
+    void finish(const std::string& key, const std::shared_ptr<InFlightCall>& call,
+                nlohmann::json value, const CallError& error)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_inFlight.find(key);
+            if (it != m_inFlight.end() && it->second == call) m_inFlight.erase(it);
+        }
+        call->land(std::move(value), error);
+    }
+
+private:
+    std::mutex m_mutex;
+    std::unordered_map<std::string, std::shared_ptr<InFlightCall>> m_inFlight;
+};
+
+} // namespace logos
+
+#endif // LOGOS_SINGLE_FLIGHT_H
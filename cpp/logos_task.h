@@ -0,0 +1,253 @@
+#ifndef LOGOS_TASK_H
+#define LOGOS_TASK_H
+
+// ---------------------------------------------------------------------------
+// logos::Task<T> — a C++20 coroutine result, for `co_await`-ing dependency
+// calls instead of nesting callbacks.
+//
+// The generated Qt-free wrappers (ApiStyle::Lp) have always offered
+// `<name>AsyncResult(..., callback)`. Chaining three of those is three nested
+// lambdas, and each hop heap-allocates a std::function plus the client's
+// completion box. A module built as C++20 also gets `<name>Co(...)`, which
+// returns `logos::Task<logos::AsyncResult<T>>`:
+//
+//     logos::Task<void> refresh() {
+//         auto user = co_await modules().accounts.lookupCo(id);
+//         if (!user.ok()) co_return;
+//         auto feed = co_await modules().feed.latestCo(user.value.handle);
+//         ...
+//     }
+//
+// The call's completion state lives in the coroutine frame, so an awaited call
+// costs the frame and nothing else.
+//
+// A Task is EAGER: calling `<name>Co` puts the call on the wire at once, and
+// co_await only collects the outcome. Fan-out is therefore just "start them
+// all, then await each":
+//
+//     std::vector<logos::Task<logos::AsyncResult<int64_t>>> calls;
+//     for (int64_t id : ids) calls.push_back(dep.scoreCo(id));
+//     for (auto& c : calls) total += (co_await c).value;
+//
+// Dropping a Task without awaiting it detaches it: the coroutine runs to the
+// end and frees itself, and its result is discarded. A top-level
+// `logos::Task<void>` is started exactly that way. An exception that escapes
+// a detached Task is discarded with it, so catch inside. The generated `Co`
+// functions never throw; their failures are in AsyncResult::error.
+//
+// A Task is awaited at most once, and the coroutine resumes on whichever thread
+// completed the call it was waiting on. There is no blocking get(): waiting on
+// a Qt-affine host's own thread for a completion that thread has to deliver is
+// a deadlock. A provider method that needs a Task's value before it can answer
+// returns a logos::Deferred and resolves it from a coroutine.
+//
+// Everything here exists only when the compiler has coroutines, which
+// LOGOS_HAS_COROUTINES reports. C++17 translation units see the macro as 0
+// and nothing else, so including this header costs them nothing.
+//
+// Qt-FREE, std-only.
+// ---------------------------------------------------------------------------
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && __has_include(<coroutine>)
+#define LOGOS_HAS_COROUTINES 1
+#else
+#define LOGOS_HAS_COROUTINES 0
+#endif
+
+#if LOGOS_HAS_COROUTINES
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace logos {
+
+template <typename T>
+class Task;
+
+namespace detail {
+
+// The rendezvous between a Task's coroutine and whoever holds the Task. It is
+// one word, moved through exactly one of three paths:
+//
+//   pending  -> <awaiter's handle>  the holder awaited first; completion
+//                                   transfers straight to it
+//   pending  -> completed           the coroutine finished first; the awaiter
+//                                   finds it done and does not suspend
+//   pending  -> detached            the holder dropped the Task; completion
+//                                   frees the frame
+//
+// and `completed` -> `detached` when a finished Task is dropped. Both racing
+// sides use acq_rel exchanges, so the result written before completion is
+// visible to the awaiter that reads it.
+class TaskPromiseBase {
+public:
+    std::suspend_never initial_suspend() noexcept { return {}; }
+
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept
+        {
+            TaskPromiseBase& p = self.promise();
+            void* prev = p.m_state.exchange(completed(), std::memory_order_acq_rel);
+            if (prev == detached()) {
+                self.destroy();
+                return std::noop_coroutine();
+            }
+            if (prev == nullptr) return std::noop_coroutine();
+            return std::coroutine_handle<>::from_address(prev);
+        }
+
+        void await_resume() noexcept {}
+    };
+
+    FinalAwaiter final_suspend() noexcept { return {}; }
+
+    void unhandled_exception() noexcept { m_exception = std::current_exception(); }
+
+    // Awaiter side. False when the coroutine has already finished, in which
+    // case the awaiting coroutine carries on without suspending.
+    bool registerContinuation(std::coroutine_handle<> awaiting) noexcept
+    {
+        void* expected = nullptr;
+        return m_state.compare_exchange_strong(expected, awaiting.address(),
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_acquire);
+    }
+
+    bool isCompleted() const noexcept
+    {
+        return m_state.load(std::memory_order_acquire) == completed();
+    }
+
+    // Holder side. True when the frame is the holder's to destroy, because the
+    // coroutine has already finished.
+    bool detach() noexcept
+    {
+        return m_state.exchange(detached(), std::memory_order_acq_rel) == completed();
+    }
+
+    void rethrowIfFailed()
+    {
+        if (m_exception) std::rethrow_exception(m_exception);
+    }
+
+private:
+    static void* completed() noexcept { return reinterpret_cast<void*>(std::uintptr_t(1)); }
+    static void* detached() noexcept { return reinterpret_cast<void*>(std::uintptr_t(2)); }
+
+    std::atomic<void*> m_state{nullptr};
+    std::exception_ptr m_exception;
+};
+
+template <typename T>
+class TaskPromise : public TaskPromiseBase {
+public:
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& value) { m_value.emplace(std::forward<U>(value)); }
+
+    T take()
+    {
+        rethrowIfFailed();
+        return std::move(*m_value);
+    }
+
+private:
+    std::optional<T> m_value;
+};
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase {
+public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() noexcept {}
+
+    void take() { rethrowIfFailed(); }
+};
+
+} // namespace detail
+
+/**
+ * @brief An eager, awaitable coroutine result.
+ *
+ * Move-only. `co_await task` yields the T the coroutine returned (or rethrows
+ * what escaped it); dropping the task unawaited detaches it.
+ */
+template <typename T>
+class Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other) {
+            release();
+            m_handle = std::exchange(other.m_handle, nullptr);
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() { release(); }
+
+    // True once the coroutine has finished; co_await will not suspend.
+    bool ready() const noexcept { return m_handle && m_handle.promise().isCompleted(); }
+
+    struct Awaiter {
+        Handle handle;
+
+        bool await_ready() const noexcept { return handle.promise().isCompleted(); }
+        bool await_suspend(std::coroutine_handle<> awaiting) noexcept
+        {
+            return handle.promise().registerContinuation(awaiting);
+        }
+        T await_resume() { return handle.promise().take(); }
+    };
+
+    Awaiter operator co_await() & noexcept { return Awaiter{m_handle}; }
+    Awaiter operator co_await() && noexcept { return Awaiter{m_handle}; }
+
+private:
+    friend class detail::TaskPromise<T>;
+    explicit Task(Handle handle) noexcept : m_handle(handle) {}
+
+    void release() noexcept
+    {
+        if (!m_handle) return;
+        if (m_handle.promise().detach()) m_handle.destroy();
+        m_handle = nullptr;
+    }
+
+    Handle m_handle;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+} // namespace detail
+
+} // namespace logos
+
+#endif // LOGOS_HAS_COROUTINES
+
+#endif // LOGOS_TASK_H
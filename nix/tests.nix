@@ -41,6 +41,10 @@ pkgs.stdenv.mkDerivation {
 
     mkdir -p $out/bin
     cp build-tests/sdk/sdk_tests $out/bin/
+    # Built only where the compiler has C++20 (see tests/sdk/CMakeLists.txt).
+    if [ -f build-tests/sdk/sdk_coroutine_tests ]; then
+      cp build-tests/sdk/sdk_coroutine_tests $out/bin/
+    fi
     cp build-tests/generator/generator_tests $out/bin/
     cp build-tests/experimental/experimental_tests $out/bin/
 
@@ -744,6 +744,35 @@ TEST_F(ImplHeaderParserTest, NlohmannJsonIsAnyByName)
     EXPECT_EQ(r.module.events[0].params[0].type.name, "any");
 }
 
+// A method that answers later returns logos::Deferred<T>, and the contract says
+// T: when the reply arrives is the provider's business. The generated dispatch
+// recognises the Deferred itself, so nothing else about the method changes.
+TEST_F(ImplHeaderParserTest, DeferredReturnPublishesItsValueType)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString hp = probeHeader(dir,
+        "class ProbeImpl {\n"
+        "public:\n"
+        "    logos::Deferred<std::vector<std::string>> lookup(const std::string& key);\n"
+        "    Deferred<void> flush();\n"
+        "    logos::Deferred<LogosMap> stats();\n"
+        "};\n");
+    auto r = parseImplHeader(hp, "ProbeImpl",
+                             fixturesDir() + "/sample_metadata.json", err);
+    ASSERT_FALSE(r.hasError()) << r.error.toStdString();
+
+    ASSERT_EQ(r.module.methods.size(), 3u);
+    const TypeExpr& lookup = r.module.methods[0].returnType;
+    EXPECT_EQ(lookup.kind, TypeExpr::Array);
+    ASSERT_EQ(lookup.elements.size(), 1u);
+    EXPECT_EQ(lookup.elements[0].name, "tstr");
+    EXPECT_EQ(r.module.methods[1].returnType.name, "void");
+    // The flags that follow the spelling follow the unwrapped one.
+    EXPECT_TRUE(r.module.methods[2].jsonReturn);
+    EXPECT_EQ(r.module.methods[2].returnType.kind, TypeExpr::Map);
+}
+
 // ---------------------------------------------------------------------------
 // A C++ spelling with no LIDL type is a BUILD ERROR, not a silent `any`.
 //
@@ -803,6 +832,8 @@ TEST_F(ImplHeaderParserTest, EachUnsupportedFamilyNamesItsReplacement)
         {"int64_t f(const std::set<std::string>& v);",               "std::vector<T>"},
         {"int64_t f(const std::pair<std::string, std::string>& v);", "struct"},
         {"int64_t f(const std::map<int64_t, std::string>& v);",      "`tstr`"},
+        {"std::future<int64_t> f();",                                "logos::Deferred<T>"},
+        {"int64_t f(logos::Deferred<int64_t> v);",                   "RETURN type only"},
     };
     for (const Case& c : cases) {
         QTemporaryDir dir;
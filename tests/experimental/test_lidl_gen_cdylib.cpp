@@ -226,7 +226,8 @@ TEST(LidlGenCdylib, ArrayOfBytesReturnTagsEachElement)
     ASSERT_TRUE(lidlCdylibSupported(m, &error)) << error.toStdString();
 
     const QString source = implSourceFor(m);
-    EXPECT_TRUE(source.contains("logos::toJson<std::vector<std::vector<uint8_t>>>("))
+    EXPECT_TRUE(source.contains(
+        "w.beginArray(); for (const auto& e0 : result) { w.bytes(e0); } w.endArray();"))
         << source.toStdString();
     EXPECT_FALSE(source.contains("nlohmann::json(result)")) << source.toStdString();
 }
@@ -621,7 +622,9 @@ TEST(LidlGenCdylib, TypedMapBindsTheAuthorsOwnContainer)
 
     const QString src = lidlMakeModuleImplExports(m, "OImpl", "o_impl.h");
     EXPECT_TRUE(src.contains("logos::JsonArg(args.at(0), \"arg0\")")) << src.toStdString();
-    EXPECT_TRUE(src.contains("logos::toJson(result)")) << src.toStdString();
+    EXPECT_TRUE(src.contains("w.beginObject(); for (const auto& kv0 : result) { w.key(kv0.first); "
+                             "w.value(kv0.second); } w.endObject();"))
+        << src.toStdString();
     EXPECT_FALSE(src.contains("logos::fromJson<std::map<std::string, int64_t>>"))
         << src.toStdString();
     EXPECT_FALSE(src.contains("logos::toJson<std::map<std::string, int64_t>>"))
@@ -719,6 +722,16 @@ QString implExportsFor(const ModuleDecl& m)
     return lidlMakeModuleImplExports(m, "SomeImpl", "some_impl.h");
 }
 
+// True when the generated interface document carries `json` — written here as
+// plain JSON, and looked for with the quotes escaped as the emitted literal
+// spells them.
+bool publishes(const QString& src, const QString& json)
+{
+    QString literal = json;
+    literal.replace("\"", "\\\"");
+    return src.contains(literal);
+}
+
 } // namespace
 
 TEST(LidlGenCdylib, IdentityMethodsAnswerFromTheModuleDeclaration)
@@ -728,9 +741,9 @@ TEST(LidlGenCdylib, IdentityMethodsAnswerFromTheModuleDeclaration)
     // The literal is the module's OWN version, not a default. A generator that
     // fell back to "1.0.0" here would be indistinguishable from a correct one
     // on the many modules that happen to be at 1.0.0.
-    EXPECT_TRUE(src.contains("if (m == \"name\")")) << src.toStdString();
+    EXPECT_TRUE(src.contains("case 0: {  // name")) << src.toStdString();
     EXPECT_TRUE(src.contains("std::string(\"weather_module\")")) << src.toStdString();
-    EXPECT_TRUE(src.contains("if (m == \"version\")")) << src.toStdString();
+    EXPECT_TRUE(src.contains("case 1: {  // version")) << src.toStdString();
     EXPECT_TRUE(src.contains("std::string(\"2.4.1\")")) << src.toStdString();
 
     // ...and never through the impl class, which has no such member.
@@ -743,9 +756,9 @@ TEST(LidlGenCdylib, IdentityMethodsAreListedForIntrospection)
     // `lm methods` and every untyped caller read this listing, so an identity
     // method that dispatches but is not advertised is only half present.
     const QString src = implExportsFor(moduleWithIdentity("weather_module", "2.4.1"));
-    EXPECT_TRUE(src.contains("obj[\"name\"] = \"name\"")) << src.toStdString();
-    EXPECT_TRUE(src.contains("obj[\"name\"] = \"version\"")) << src.toStdString();
-    EXPECT_TRUE(src.contains("obj[\"signature\"] = \"name()\"")) << src.toStdString();
+    EXPECT_TRUE(publishes(src, R"j("name":"name")j")) << src.toStdString();
+    EXPECT_TRUE(publishes(src, R"j("name":"version")j")) << src.toStdString();
+    EXPECT_TRUE(publishes(src, R"j("signature":"name()")j")) << src.toStdString();
 }
 
 TEST(LidlGenCdylib, AnAuthorsOwnIdentityMethodStillReachesTheImpl)
@@ -985,9 +998,9 @@ TEST(LidlGenCdylib, PublishedTypesAreTheLidlSpelling)
     ModuleDecl m = moduleWithMethod(method("echo_uints", arrOf(prim("uint")),
                                            { param("v", arrOf(prim("uint"))) }));
     const QString src = implExportsFor(m);
-    EXPECT_TRUE(src.contains("obj[\"returnType\"] = \"[uint]\"")) << src.toStdString();
-    EXPECT_TRUE(src.contains("obj[\"signature\"] = \"echo_uints([uint])\"")) << src.toStdString();
-    EXPECT_TRUE(src.contains("{\"type\", \"[uint]\"}")) << src.toStdString();
+    EXPECT_TRUE(publishes(src, R"j("returnType":"[uint]")j")) << src.toStdString();
+    EXPECT_TRUE(publishes(src, R"j("signature":"echo_uints([uint])")j")) << src.toStdString();
+    EXPECT_TRUE(publishes(src, R"j({"name":"v","type":"[uint]"})j")) << src.toStdString();
     // The Qt vocabulary is GONE from the published surface.
     EXPECT_FALSE(src.contains("\"QVariantList\"")) << src.toStdString();
 }
@@ -1002,9 +1015,9 @@ TEST(LidlGenCdylib, PublishedTypesDistinguishWhatQtCollapsed)
         moduleWithMethod(method("m", arrOf(prim("bstr")), {})));
     const QString anys = implExportsFor(
         moduleWithMethod(method("m", arrOf(prim("any")), {})));
-    EXPECT_TRUE(uints.contains("obj[\"returnType\"] = \"[uint]\""));
-    EXPECT_TRUE(blobs.contains("obj[\"returnType\"] = \"[bstr]\""));
-    EXPECT_TRUE(anys.contains("obj[\"returnType\"] = \"[any]\""));
+    EXPECT_TRUE(publishes(uints, R"j("returnType":"[uint]")j"));
+    EXPECT_TRUE(publishes(blobs, R"j("returnType":"[bstr]")j"));
+    EXPECT_TRUE(publishes(anys, R"j("returnType":"[any]")j"));
 }
 
 // A record publishes its DECLARED NAME — what the contract calls it — not
@@ -1024,18 +1037,503 @@ TEST(LidlGenCdylib, PublishedRecordTypesUseTheDeclaredName)
     m.types.push_back(t);
 
     const QString src = implExportsFor(m);
-    EXPECT_TRUE(src.contains("obj[\"returnType\"] = \"Blob\"")) << src.toStdString();
-    EXPECT_TRUE(src.contains("obj[\"signature\"] = \"bounds([Blob])\"")) << src.toStdString();
+    EXPECT_TRUE(publishes(src, R"j("returnType":"Blob")j")) << src.toStdString();
+    EXPECT_TRUE(publishes(src, R"j("signature":"bounds([Blob])")j")) << src.toStdString();
 }
 
 TEST(LidlGenCdylib, PublishedTypesSpellMapsAndOptionals)
 {
     const QString maps = implExportsFor(
         moduleWithMethod(method("m", mapOf(prim("uint")), {})));
-    EXPECT_TRUE(maps.contains("obj[\"returnType\"] = \"{tstr: uint}\"")) << maps.toStdString();
+    EXPECT_TRUE(publishes(maps, R"j("returnType":"{tstr: uint}")j")) << maps.toStdString();
 
     const QString opts = implExportsFor(moduleWithMethod(
         method("m", prim("bool"), { param("id", optionalOf(prim("tstr"))) })));
-    EXPECT_TRUE(opts.contains("obj[\"signature\"] = \"m(? tstr)\"")) << opts.toStdString();
-    EXPECT_TRUE(opts.contains("{\"type\", \"? tstr\"}")) << opts.toStdString();
+    EXPECT_TRUE(publishes(opts, R"j("signature":"m(? tstr)")j")) << opts.toStdString();
+    EXPECT_TRUE(publishes(opts, R"j({"name":"id","type":"? tstr"})j")) << opts.toStdString();
+}
+
+// ---------------------------------------------------------------------------
+// Method lookup
+//
+// The dispatch used to build a std::string from the C name and walk one
+// `if (m == "<name>")` per method, so the last method of a large contract paid
+// for every compare in front of it. It is now a generated decision tree over
+// (length, byte) that ends in exactly one memcmp per method.
+// ---------------------------------------------------------------------------
+
+TEST(LidlGenCdylib, DispatchLooksUpTheMethodWithoutBuildingAString)
+{
+    ModuleDecl m;
+    m.name = "o_module";
+    m.methods.push_back(method("peek", prim("tstr"), {}));
+    m.methods.push_back(method("poke", prim("tstr"), {}));
+    m.methods.push_back(method("pull", prim("tstr"), {}));
+
+    const QString src = implExportsFor(m);
+    EXPECT_FALSE(src.contains("const std::string m(method)")) << src.toStdString();
+    EXPECT_FALSE(src.contains("if (m == ")) << src.toStdString();
+    EXPECT_TRUE(src.contains("switch (std::strlen(method)) {")) << src.toStdString();
+    // Same length and same first byte: the tree has to split on a LATER byte,
+    // not fall back to comparing the three in turn.
+    EXPECT_TRUE(src.contains("switch (method[1]) {")) << src.toStdString();
+    EXPECT_FALSE(src.contains("switch (method[0]) {")) << src.toStdString();
+    // Every method is confirmed by exactly one memcmp, and answers its
+    // position in the contract.
+    EXPECT_EQ(src.count("std::memcmp(method, \"peek\", 4)"), 1) << src.toStdString();
+    EXPECT_TRUE(src.contains("std::memcmp(method, \"peek\", 4) == 0 ? 0 : -1"))
+        << src.toStdString();
+    EXPECT_TRUE(src.contains("std::memcmp(method, \"poke\", 4) == 0 ? 1 : -1"))
+        << src.toStdString();
+    EXPECT_TRUE(src.contains("std::memcmp(method, \"pull\", 4) == 0 ? 2 : -1"))
+        << src.toStdString();
+    EXPECT_TRUE(src.contains("case 2: {  // pull")) << src.toStdString();
+}
+
+TEST(LidlGenCdylib, AnUnknownMethodIsRejectedBeforeTheArgumentsAreParsed)
+{
+    const QString src = implExportsFor(moduleWithMethod(method("ping", prim("tstr"), {})));
+    const int lookup = src.indexOf("if (index < 0 || index >= 1) return nullptr;");
+    const int parse = src.indexOf("nlohmann::json::parse(args_json");
+    ASSERT_GE(lookup, 0) << src.toStdString();
+    ASSERT_GE(parse, 0) << src.toStdString();
+    EXPECT_LT(lookup, parse) << src.toStdString();
+}
+
+TEST(LidlGenCdylib, ADuplicatedMethodNameDispatchesToItsFirstDeclaration)
+{
+    // The old if-chain reached the first of two same-named methods and never
+    // the second; the table keeps that, rather than emitting a tree that cannot
+    // tell the two apart.
+    ModuleDecl m;
+    m.name = "o_module";
+    m.methods.push_back(method("ping", prim("tstr"), {}));
+    m.methods.push_back(method("ping", prim("bool"), {}));
+
+    const QString src = implExportsFor(m);
+    EXPECT_EQ(src.count("std::memcmp(method, \"ping\", 4)"), 1) << src.toStdString();
+    EXPECT_TRUE(src.contains("case 0: {  // ping")) << src.toStdString();
+    EXPECT_FALSE(src.contains("case 1: {  // ping")) << src.toStdString();
+}
+
+TEST(LidlGenCdylib, EmitsTheResolveAndDispatchByIdExports)
+{
+    ModuleDecl m;
+    m.name = "o_module";
+    m.methods.push_back(method("peek", prim("tstr"), {}));
+    m.methods.push_back(method("poke", prim("tstr"), {}));
+
+    const QString src = implExportsFor(m);
+    EXPECT_TRUE(src.contains("int32_t logos_module_resolve_method(const char* method)"))
+        << src.toStdString();
+    EXPECT_TRUE(src.contains(
+        "char* logos_module_dispatch_by_id(int32_t method_id, const char* args_json)"))
+        << src.toStdString();
+    // One set of method bodies behind both entry points, so the two cannot
+    // disagree about what a method does.
+    EXPECT_EQ(src.count("static char* lidlDispatchIndex("), 1) << src.toStdString();
+    EXPECT_TRUE(src.contains("return lidlDispatchIndex(lidlMethodIndex(method), args_json, nullptr);"))
+        << src.toStdString();
+    EXPECT_TRUE(src.contains("return lidlDispatchIndex(method_id, args_json, nullptr);"))
+        << src.toStdString();
+    // An id outside the table is an unknown method, not undefined behaviour.
+    EXPECT_TRUE(src.contains("if (index < 0 || index >= 2) return nullptr;"))
+        << src.toStdString();
+}
+
+TEST(LidlGenCdylib, ResolveAndDispatchByIdAreGuardedMajorAware)
+{
+    const QString src = implExportsFor(moduleWithMethod(method("ping", prim("tstr"), {})));
+    const QString guard =
+        "#if defined(LOGOS_PROTOCOL_VERSION_MINOR) && (LOGOS_PROTOCOL_VERSION_MAJOR > 0 || "
+        "(LOGOS_PROTOCOL_VERSION_MAJOR == 0 && LOGOS_PROTOCOL_VERSION_MINOR >= 7))\n"
+        "int32_t logos_module_resolve_method(";
+    EXPECT_TRUE(src.contains(guard)) << src.toStdString();
+    // The by-name export is the baseline surface and stays unguarded.
+    EXPECT_TRUE(src.contains("extern \"C\" {\n\nchar* logos_module_dispatch("))
+        << src.toStdString();
+}
+
+// ---------------------------------------------------------------------------
+// Scalar fast path
+//
+// A method whose parameters are all LIDL scalars reads them in place with
+// logos::ScalarArgs before any DOM is built. The reader's own acceptance rules
+// are covered by value in tests/sdk/test_logos_scalar_args.cpp; what is pinned
+// here is which methods take the path, and that the DOM path stays behind it
+// unchanged for everything the reader declines.
+// ---------------------------------------------------------------------------
+
+TEST(LidlGenCdylib, ScalarOnlyMethodsReadTheirArgumentsInPlace)
+{
+    ModuleDecl m;
+    m.name = "o_module";
+    m.methods.push_back(method("work", prim("int"),
+                               {param("n", prim("int")), param("who", prim("tstr")),
+                                param("u", prim("uint")), param("f", prim("float64")),
+                                param("b", prim("bool"))}));
+
+    const QString src = implExportsFor(m);
+    EXPECT_TRUE(src.contains("#include \"logos_scalar_args.h\"")) << src.toStdString();
+    EXPECT_TRUE(src.contains("logos::ScalarArgs in(args_json);")) << src.toStdString();
+    EXPECT_TRUE(src.contains("std::string arg1{};")) << src.toStdString();
+    EXPECT_TRUE(src.contains(
+        "if (in.read(arg0) && in.read(arg1) && in.read(arg2) && in.read(arg3) "
+        "&& in.read(arg4) && in.atEnd()) {")) << src.toStdString();
+    EXPECT_TRUE(src.contains("lidlImpl().work(arg0, std::move(arg1), arg2, arg3, arg4)"))
+        << src.toStdString();
+    // ...and the DOM path, with its arity gate and codec decode, is still
+    // there for every call the reader declines.
+    EXPECT_TRUE(src.contains("if (args.size() < 5) {")) << src.toStdString();
+    EXPECT_TRUE(src.contains("logos::fromJson<int64_t>(args.at(0), \"arg0\")"))
+        << src.toStdString();
+    EXPECT_LT(src.indexOf("logos::ScalarArgs in(args_json);"),
+              src.indexOf("nlohmann::json::parse(args_json")) << src.toStdString();
+}
+
+TEST(LidlGenCdylib, OnlyScalarOnlyMethodsTakeTheFastPath)
+{
+    // Optional, bytes, containers and records keep the DOM path alone: each has
+    // a decode (null, the lenient bytes rule, element recursion) the in-place
+    // reader does not reproduce.
+    const std::vector<ParamDecl> notScalar = {
+        param("v", opt(prim("tstr"))),
+        param("v", prim("bstr")),
+        param("v", arr(prim("int"))),
+        param("v", prim("any")),
+    };
+    for (const ParamDecl& p : notScalar) {
+        const QString src = implExportsFor(
+            moduleWithMethod(method("f", prim("bool"), {param("n", prim("int")), p})));
+        EXPECT_FALSE(src.contains("logos::ScalarArgs in(")) << src.toStdString();
+    }
+
+    const QString identity = implExportsFor(moduleWithIdentity("weather_module", "2.4.1"));
+    EXPECT_FALSE(identity.contains("logos::ScalarArgs in(")) << identity.toStdString();
+}
+
+// A reply used to be built as JSON, `.dump()`ed into a std::string and then
+// copied again by lidlStrdup — two copies of every payload. It is now written
+// once, into the buffer the C ABI returns, and a typed one without a DOM: each
+// record the replies reach gets a writer of its own.
+TEST(LidlGenCdylib, RepliesAreSerializedStraightIntoTheReturnedBuffer)
+{
+    ModuleDecl m;
+    m.name = "o_module";
+    TypeDecl t;
+    t.name = "Row";
+    t.fields.push_back(field("id", prim("uint")));
+    m.types.push_back(t);
+    m.methods.push_back(method("rows", arr(TypeExpr{TypeExpr::Named, "Row", {}}), {}));
+    m.methods.push_back(method("count", prim("uint"), {param("q", prim("tstr"))}));
+    m.methods.push_back(method("raw", prim("any"), {}));
+
+    const QString src = implExportsFor(m);
+    EXPECT_TRUE(src.contains("#include \"logos_reply_buffer.h\"")) << src.toStdString();
+    EXPECT_TRUE(src.contains("void lidlWrite_Row(logos::ReplyWriter& w, const Row& v)\n{\n"
+                             "    w.beginObject();\n"
+                             "    w.key(\"id\"); w.value(v.id);\n"
+                             "    w.endObject();\n}"))
+        << src.toStdString();
+    EXPECT_TRUE(src.contains("logos::ReplyWriter w; w.beginArray(); for (const auto& e0 : result) { "
+                             "lidlWrite_Row(w, e0); } w.endArray(); return w.release();"))
+        << src.toStdString();
+    EXPECT_TRUE(src.contains("logos::ReplyWriter w; w.value(result); return w.release();"))
+        << src.toStdString();
+    EXPECT_FALSE(src.contains("logos::toJson<std::vector<Row>>")) << src.toStdString();
+    // Untyped JSON is JSON already: it is dumped as it is.
+    EXPECT_TRUE(src.contains("return logos::dumpToMalloc(result);")) << src.toStdString();
+    EXPECT_FALSE(src.contains("(result).dump()")) << src.toStdString();
+}
+
+// The bytes are the ones the record's DOM dumped to, so a record's keys are
+// written in the order the DOM kept them — sorted — and an empty optional
+// field is left out, as the codec leaves it out. A record no reply reaches
+// gets no writer.
+TEST(LidlGenCdylib, ARecordWriterWritesItsKeysAsTheDomDumpedThem)
+{
+    ModuleDecl m;
+    m.name = "o_module";
+    TypeDecl inner;
+    inner.name = "Tag";
+    inner.fields.push_back(field("label", prim("tstr")));
+    TypeDecl row;
+    row.name = "Row";
+    row.fields.push_back(field("name", prim("tstr")));
+    row.fields.push_back(field("id", prim("uint")));
+    row.fields.push_back(field("tag", opt(TypeExpr{TypeExpr::Named, "Tag", {}})));
+    TypeDecl unused;
+    unused.name = "Input";
+    unused.fields.push_back(field("q", prim("tstr")));
+    m.types = {inner, row, unused};
+    m.methods.push_back(method("row", TypeExpr{TypeExpr::Named, "Row", {}},
+                               {param("in", TypeExpr{TypeExpr::Named, "Input", {}})}));
+
+    const QString src = implExportsFor(m);
+    EXPECT_TRUE(src.contains("void lidlWrite_Row(logos::ReplyWriter& w, const Row& v)\n{\n"
+                             "    w.beginObject();\n"
+                             "    w.key(\"id\"); w.value(v.id);\n"
+                             "    w.key(\"name\"); w.value(v.name);\n"
+                             "    if (v.tag.has_value()) { w.key(\"tag\"); lidlWrite_Tag(w, (*v.tag)); }\n"
+                             "    w.endObject();\n}"))
+        << src.toStdString();
+    EXPECT_TRUE(src.contains("void lidlWrite_Tag(logos::ReplyWriter& w, const Tag& v);"))
+        << src.toStdString();
+    EXPECT_FALSE(src.contains("lidlWrite_Input")) << src.toStdString();
+}
+
+// The listing is fixed when the module is generated, so it is written then: a
+// constexpr literal that logos_module_get_methods copies out, instead of a DOM
+// rebuilt and dumped on every poll.
+TEST(LidlGenCdylib, TheInterfaceDocumentIsAGeneratedLiteral)
+{
+    ModuleDecl m = moduleWithIdentity("weather_module", "2.4.1");
+    const QString src = implExportsFor(m);
+    EXPECT_TRUE(src.contains("static constexpr char lidlInterfaceDocument[] =")) << src.toStdString();
+    EXPECT_TRUE(src.contains("std::memcpy(out, lidlInterfaceDocument, sizeof lidlInterfaceDocument);"))
+        << src.toStdString();
+    EXPECT_FALSE(src.contains("lidlInterfaceJson")) << src.toStdString();
+    // Keys in the order the nlohmann DOM used to dump them.
+    EXPECT_TRUE(publishes(src, R"j({"isInvokable":true,"name":"name","returnType":"tstr","signature":"name()"})j"))
+        << src.toStdString();
+
+    ModuleDecl empty;
+    empty.name = "empty_module";
+    EXPECT_TRUE(implExportsFor(empty).contains("lidlInterfaceDocument[] =\n    \"[]\";"));
+}
+
+TEST(LidlGenCdylib, TheInterfaceDocumentEscapesDescriptionsAsJson)
+{
+    MethodDecl md = method("m", prim("bool"), {});
+    md.description = "say \"hi\"\\\r\n\t\x01 caf\xc3\xa9 \xff";
+    EventDecl ed;
+    ed.name = "changed";
+    ed.description = "tick";
+    ModuleDecl m = moduleWithMethod(md);
+    m.events.push_back(ed);
+    const QString src = implExportsFor(m);
+
+    // JSON escapes first, then C++ literal escapes on top: `\"` in the document
+    // is `\\\"` in the source, control bytes and UTF-8 are octal, and the
+    // invalid 0xff is published as U+FFFD.
+    EXPECT_TRUE(src.contains(R"(\"description\":\"say \\\"hi\\\"\\\\\\r\\n\\t\\u0001 caf\303\251 \357\277\275\")"))
+        << src.toStdString();
+    EXPECT_TRUE(publishes(src, R"j({"description":"tick","name":"changed","signature":"changed()","type":"event"}])j"))
+        << src.toStdString();
+}
+
+// Every dispatch runs the context latch, so once the hook has fired it must
+// cost one flag load: the call_once wirings and g_ctxMutex are cold-path only.
+TEST(LidlGenCdylib, TheContextLatchIsOneLoadOnceFired)
+{
+    const QString src = implExportsFor(moduleWithIdentity("weather_module", "2.4.1"));
+    const int hot = src.indexOf("static inline void lidlTryFireContext(bool requireEmit)\n{\n"
+                                "    if (g_hookFired.load(std::memory_order_acquire)) return;\n"
+                                "    lidlTryFireContextCold(requireEmit);\n"
+                                "}\n");
+    ASSERT_GE(hot, 0) << src.toStdString();
+
+    const int cold = src.indexOf("static void lidlTryFireContextCold(bool requireEmit)");
+    ASSERT_GE(cold, 0) << src.toStdString();
+    const QString coldBody = src.mid(cold, hot - cold);
+    EXPECT_TRUE(coldBody.contains("lidlEnsureEmitWiring();")) << coldBody.toStdString();
+    EXPECT_TRUE(coldBody.contains("lidlEnsureModulesWired();")) << coldBody.toStdString();
+    EXPECT_TRUE(coldBody.contains("std::lock_guard<std::mutex> lock(g_ctxMutex);")) << coldBody.toStdString();
+    // The hook fires once even when two first dispatches race into the cold half.
+    EXPECT_TRUE(coldBody.contains("if (g_hookFired.exchange(true, std::memory_order_acq_rel)) return;"))
+        << coldBody.toStdString();
+    // No context yet: answered without the mutex.
+    EXPECT_LT(coldBody.indexOf("if (!g_ctxStored.load(std::memory_order_acquire)) return;"),
+              coldBody.indexOf("g_ctxMutex")) << coldBody.toStdString();
+}
+
+// Emitters read the host callback from an atomic snapshot and dump the payload
+// outside any lock; only logos_module_set_emit_callback takes a mutex, and it
+// waits out callbacks still running on the snapshot it replaced.
+TEST(LidlGenCdylib, EventEmissionTakesNoLock)
+{
+    ModuleDecl m = moduleWithIdentity("weather_module", "2.4.1");
+    EventDecl e;
+    e.name = "changed";
+    e.params.push_back(param("n", prim("uint")));
+    m.events.push_back(e);
+    const QString src = implExportsFor(m);
+
+    EXPECT_FALSE(src.contains("g_emitMutex")) << src.toStdString();
+    const int wiring = src.indexOf("static void lidlEmitNow(");
+    const int wiringEnd = src.indexOf("static void lidlEnsureModulesWired()");
+    ASSERT_GE(wiring, 0);
+    const QString emit = src.mid(wiring, wiringEnd - wiring);
+    EXPECT_FALSE(emit.contains("lock_guard")) << emit.toStdString();
+    // The payload is serialized before anything reaches for the host callback.
+    EXPECT_TRUE(emit.contains("lidlEmitNow(name, payload ? payload->dump() : \"[]\");")) << emit.toStdString();
+    EXPECT_TRUE(emit.contains("cb(name.c_str(), dumped.c_str(), ud);")) << emit.toStdString();
+
+    // The snapshot is entered through its in-flight count, with no lock...
+    const int slot = src.indexOf("class LidlCallbackSlot {");
+    ASSERT_GE(slot, 0) << src.toStdString();
+    const QString call = src.mid(slot, src.indexOf("void set(Cb cb, void* ud)", slot) - slot);
+    EXPECT_FALSE(call.contains("lock_guard")) << call.toStdString();
+    EXPECT_TRUE(call.contains("t->inflight.fetch_add(1);")) << call.toStdString();
+    // ...and a setter sleeps out callbacks on the snapshot it replaced...
+    EXPECT_TRUE(src.contains("m_drained.wait(wait, [prev] { return prev->inflight.load() == 0; });"))
+        << src.toStdString();
+    EXPECT_FALSE(src.contains("std::this_thread::yield()")) << src.toStdString();
+    // ...then frees the retired snapshots once no emitter can still reach one.
+    EXPECT_TRUE(src.contains("m_retired.emplace_back(prev);\n"
+                             "        }\n"
+                             "        if (m_entering.load() == 0) m_retired.clear();\n")) << src.toStdString();
+    EXPECT_TRUE(src.contains("    g_emit.set(cb, user_data);\n")) << src.toStdString();
+}
+
+// batchEvents() collects a thread's emissions and hands them over together:
+// as ONE call to a host that set the batch callback, one by one otherwise.
+TEST(LidlGenCdylib, BatchedEventsReachTheHostAsOneArray)
+{
+    ModuleDecl m = moduleWithIdentity("chain_module", "1.0.0");
+    EventDecl e;
+    e.name = "blockSeen";
+    e.params.push_back(param("height", prim("uint")));
+    m.events.push_back(e);
+    const QString src = implExportsFor(m);
+
+    EXPECT_TRUE(src.contains("_logos_codegen_::maybeSetEventBatching(lidlImpl(),")) << src.toStdString();
+    EXPECT_TRUE(src.contains("thread_local LidlEventBatch t_eventBatch;")) << src.toStdString();
+    EXPECT_TRUE(src.contains("if (batch.depth > 0 && --batch.depth == 0)\n"
+                             "                    lidlDeliverEvents(batch.events);")) << src.toStdString();
+    // Bounded: a long batch is delivered in chunks.
+    EXPECT_TRUE(src.contains("if (batch.events.size() >= kLidlMaxBatchedEvents)")) << src.toStdString();
+    // One document for a batch-aware host, per-event calls for any other.
+    EXPECT_TRUE(src.contains("g_emitBatch.call([&](LidlEmitBatchCb cb, void* ud) { cb(doc.c_str(), ud); })"))
+        << src.toStdString();
+    EXPECT_TRUE(src.contains("cb(e.first.c_str(), e.second.c_str(), ud);")) << src.toStdString();
+}
+
+TEST(LidlGenCdylib, TheBatchCallbackExportIsGuardedMajorAware)
+{
+    const QString src = implExportsFor(moduleWithIdentity("chain_module", "1.0.0"));
+    const QString guard =
+        "#if defined(LOGOS_PROTOCOL_VERSION_MINOR) && (LOGOS_PROTOCOL_VERSION_MAJOR > 0 || "
+        "(LOGOS_PROTOCOL_VERSION_MAJOR == 0 && LOGOS_PROTOCOL_VERSION_MINOR >= 7))\n"
+        "void logos_module_set_emit_batch_callback(";
+    EXPECT_TRUE(src.contains(guard)) << src.toStdString();
+}
+
+// An event whose doc comment carries `@coalesce` is a state snapshot: its body
+// posts to a last-value-wins slot instead of emitting, and the slot is flushed
+// at a bounded rate and as each dispatch returns.
+namespace {
+
+ModuleDecl moduleWithCoalescedEvent()
+{
+    ModuleDecl m = moduleWithIdentity("sync_module", "1.0.0");
+    EventDecl progress;
+    progress.name = "progressChanged";
+    progress.description = "Sync progress, 0..1.\n@coalesce";
+    progress.params.push_back(param("pct", prim("float64")));
+    m.events.push_back(progress);
+    EventDecl block;
+    block.name = "blockSeen";
+    block.params.push_back(param("height", prim("uint")));
+    m.events.push_back(block);
+    return m;
+}
+
+} // namespace
+
+TEST(LidlGenCdylib, CoalescibleEventsPostToALastValueSlot)
+{
+    const ModuleDecl m = moduleWithCoalescedEvent();
+    const QString events = lidlMakeEventsSourceCdylib(m, "SomeImpl", "some_impl.h");
+    EXPECT_TRUE(events.contains("coalesceEventImpl_(\"progressChanged\", &args);")) << events.toStdString();
+    // An unmarked event is untouched.
+    EXPECT_TRUE(events.contains("emitEventImpl_(\"blockSeen\", &args);")) << events.toStdString();
+
+    const QString src = implExportsFor(m);
+    EXPECT_TRUE(src.contains("LidlCoalesceSlot g_coalesceSlots[] = {\n    {\"progressChanged\"},\n};"))
+        << src.toStdString();
+    EXPECT_TRUE(src.contains("delete slot.payload.exchange(new std::string(std::move(dumped)));"))
+        << src.toStdString();
+    EXPECT_TRUE(src.contains("if (!g_coalescePending.exchange(true)) g_coalesceFlusher.wake();"))
+        << src.toStdString();
+    EXPECT_TRUE(src.contains("if (g_coalescePending.load(std::memory_order_relaxed)) lidlFlushCoalesced();"))
+        << src.toStdString();
+    // What is still pending when the module unloads is freed, not leaked.
+    EXPECT_TRUE(src.contains("if (m_thread.joinable()) m_thread.join();\n"
+                             "        for (LidlCoalesceSlot& slot : g_coalesceSlots) delete slot.payload.exchange(nullptr);"))
+        << src.toStdString();
+    // The directive is delivery policy, not documentation.
+    EXPECT_TRUE(publishes(src, R"j("description":"Sync progress, 0..1.","name":"progressChanged")j"))
+        << src.toStdString();
+}
+
+TEST(LidlGenCdylib, AModuleWithoutCoalescibleEventsEmitsNoCoalescer)
+{
+    const QString src = implExportsFor(moduleWithIdentity("plain_module", "1.0.0"));
+    EXPECT_FALSE(src.contains("Coalesce")) << src.toStdString();
+    EXPECT_FALSE(src.contains("#include <chrono>")) << src.toStdString();
+    EXPECT_TRUE(src.contains("    return lidlDispatchIndex(lidlMethodIndex(method), args_json, nullptr);\n"))
+        << src.toStdString();
+}
+
+// A method's `@cache` / `@invalidated-by` / `@single-flight` lines are for the consumer's
+// generated wrapper; the provider publishes the description without them.
+TEST(LidlGenCdylib, MethodCacheTagsAreLeftOutOfThePublishedDescription)
+{
+    ModuleDecl m = moduleWithIdentity("config_module", "1.0.0");
+    MethodDecl get = method("getConfig", prim("tstr"), {});
+    get.description = "Current configuration.\n@cache 5000\n@invalidated-by configChanged\n@single-flight";
+    m.methods.push_back(get);
+    const QString src = implExportsFor(m);
+    EXPECT_TRUE(publishes(src, R"j("description":"Current configuration.","isInvokable":true,"name":"getConfig")j"))
+        << src.toStdString();
+    EXPECT_FALSE(src.contains("@cache")) << src.toStdString();
+    EXPECT_FALSE(src.contains("@single-flight")) << src.toStdString();
+}
+
+// logos_module_dispatch_async runs the same method bodies as the synchronous
+// entry points, with a completion instead of a return value. A method that
+// returns logos::Deferred<T> is recognised by the compiler, not the contract.
+TEST(LidlGenCdylib, AsyncDispatchSharesTheMethodBodies)
+{
+    ModuleDecl m;
+    m.name = "a_module";
+    m.methods.push_back(method("peek", prim("tstr"), {}));
+    m.methods.push_back(method("poke", prim("void"), {}));
+
+    const QString src = implExportsFor(m);
+    const QString guard =
+        "#if defined(LOGOS_PROTOCOL_VERSION_MINOR) && (LOGOS_PROTOCOL_VERSION_MAJOR > 0 || "
+        "(LOGOS_PROTOCOL_VERSION_MAJOR == 0 && LOGOS_PROTOCOL_VERSION_MINOR >= 7))\n";
+    const int guardAt = src.indexOf(guard + "int32_t logos_module_resolve_method(");
+    const int asyncAt = src.indexOf(
+        "void logos_module_dispatch_async(const char* method, const char* args_json,\n"
+        "                                 LidlCompleteCb completion_cb, void* user_data)");
+    ASSERT_GE(guardAt, 0) << src.toStdString();
+    ASSERT_GT(asyncAt, guardAt) << src.toStdString();
+    EXPECT_LT(asyncAt, src.indexOf("#endif", guardAt)) << src.toStdString();
+
+    EXPECT_EQ(src.count("static char* lidlDispatchIndex("), 1) << src.toStdString();
+    EXPECT_TRUE(src.contains("? lidlDispatchIndex(lidlMethodIndex(method), args_json, &done)"))
+        << src.toStdString();
+    // Anything that did not hand its completion to a Deferred answers inline.
+    EXPECT_TRUE(src.contains("if (reply != lidlPendingReply()) lidlComplete(done, reply);"))
+        << src.toStdString();
+
+    // Every call goes through lidlReply, which picks the Deferred branch only
+    // when the impl's return type is one.
+    EXPECT_TRUE(src.contains("#include \"logos_deferred.h\"")) << src.toStdString();
+    EXPECT_TRUE(src.contains("if constexpr (logos::isDeferred<R>::value) {")) << src.toStdString();
+    EXPECT_TRUE(src.contains(
+        "return lidlReply(done, [&] { return lidlImpl().peek(); },\n"
+        "                                 [](const auto& result) { logos::ReplyWriter w; w.value(result); return w.release(); });"))
+        << src.toStdString();
+    EXPECT_TRUE(src.contains(
+        "return lidlReply(done, [&] { return lidlImpl().poke(); },\n"
+        "                                 nullptr);"))
+        << src.toStdString();
+    // A rejection keeps its own code on the synchronous path too.
+    EXPECT_TRUE(src.contains("} catch (const logos::DeferredRejected& e) {\n"
+                             "        return lidlRejectedReply(e);"))
+        << src.toStdString();
 }
@@ -10,6 +10,7 @@
 #include <QJsonArray>
 #include <QJsonObject>
 #include "generator_lib.h"
+#include "lidl_to_json.h"
 
 namespace {
 
@@ -85,8 +86,8 @@ TEST(SyncTimeout, LpBodyForwardsTimeoutMs)
     EXPECT_TRUE(src.contains("Mod::add(int64_t p0, int64_t p1, logos::CallError* err, int timeout_ms)"));
     // Into a LOCAL `_err`, then copied out: `err` is optional on this surface,
     // and the dispatch-rejection fold needs somewhere to write either way.
-    EXPECT_TRUE(src.contains("m_client.invoke(\"add\", _args, &_err, timeout_ms);"));
-    EXPECT_TRUE(src.contains("m_client.invoke(\"reset\", _args, &_err, timeout_ms);"));
+    EXPECT_TRUE(src.contains("m_client.invokeReply(\"add\", _args, &_err, timeout_ms);"));
+    EXPECT_TRUE(src.contains("m_client.invokeReply(\"reset\", _args, &_err, timeout_ms);"));
     EXPECT_TRUE(src.contains("if (err) *err = _err;"));
     // The deadline is still forwarded, never dropped for a fresh default.
     EXPECT_FALSE(src.contains("_args, &_err);"));
@@ -98,13 +99,13 @@ TEST(SyncTimeout, LpSyncFoldsAProviderRejectionIntoTheErrorChannel)
     // its RESULT, so LpClient::invoke reports ok() and the decode erases it.
     // The Qt sync path has folded this for a while; this surface now does too.
     const QString src = lpSource();
-    const QString fold = "if (_err.ok()) logosDispatchRejectionJson(_r, _err);";
+    const QString fold = "if (_err.ok() && _r.mayBeRejection()) logosDispatchRejectionJson(_r.json(), _err);";
     ASSERT_TRUE(src.contains(fold));
     // Folded BEFORE the value is decoded and before `err` is written out, so a
     // caller never reads an ok() error next to a default-decoded rejection.
     const int f = src.indexOf(fold);
     const int copy = src.indexOf("if (err) *err = _err;");
-    const int ret = src.indexOf("    return (_r.is_number_integer()");
+    const int ret = src.indexOf("    return _r.as<int64_t>();");
     ASSERT_NE(copy, -1);
     ASSERT_NE(ret, -1);
     EXPECT_LT(f, copy);
@@ -117,7 +118,7 @@ TEST(SyncTimeout, LpVoidSyncStillCapturesTheResultSoItCanSeeARejection)
     // place that says so — so the result is captured even where nothing is
     // returned. `_r` is not unused: the fold reads it.
     const QString src = lpSource();
-    EXPECT_TRUE(src.contains("nlohmann::json _r = m_client.invoke(\"reset\", _args, &_err, timeout_ms);"));
+    EXPECT_TRUE(src.contains("logos::LpReply _r = m_client.invokeReply(\"reset\", _args, &_err, timeout_ms);"));
 }
 
 // ─── 2. Async gains a result-carrying entry point ───────────────────────────
@@ -224,7 +225,7 @@ TEST(AsyncResult, LpBodyRoutesToTheErrorCarryingClientEntryPoint)
     // failure form into a bare JSON null, which is also what a successful call
     // returning nothing delivers — indistinguishable, which is the whole defect.
     EXPECT_TRUE(src.contains("m_client.invokeAsyncResult(\"add\", _args,"));
-    EXPECT_TRUE(src.contains("[callback](nlohmann::json _r, const logos::CallError& _err) {"));
+    EXPECT_TRUE(src.contains("[callback = std::move(callback)](nlohmann::json _r, const logos::CallError& _err) {"));
     EXPECT_TRUE(src.contains("logos::AsyncResult<int64_t> _res;"));
     EXPECT_TRUE(src.contains("_res.error = _err;"));
     EXPECT_TRUE(src.contains("callback(_res);"));
@@ -232,6 +233,29 @@ TEST(AsyncResult, LpBodyRoutesToTheErrorCarryingClientEntryPoint)
     EXPECT_TRUE(src.contains("logos::AsyncResult<void> _res;"));
 }
 
+TEST(AsyncResult, LpTakesACancellationTokenInPlaceOfTheTimeout)
+{
+    // An overload, not a new name: a token and an int never convert into each
+    // other, so the two cannot be ambiguous.
+    EXPECT_TRUE(lpHeader().contains("void addAsyncResult(int64_t p0, int64_t p1, "
+                                    "std::function<void(logos::AsyncResult<int64_t>)> callback, "
+                                    "const logos::CancellationToken& token);"));
+    // A cancelled call never calls back, and the declaration says so.
+    EXPECT_TRUE(lpHeader().contains("    // way `callback` is never called.\n"
+                                    "    void addAsyncResult(int64_t p0, int64_t p1, "
+                                    "std::function<void(logos::AsyncResult<int64_t>)> callback, "
+                                    "const logos::CancellationToken& token);"));
+    const QString src = lpSource();
+    const int begin = src.indexOf("void Mod::addAsyncResult(int64_t p0, int64_t p1, "
+                                  "std::function<void(logos::AsyncResult<int64_t>)> callback, "
+                                  "const logos::CancellationToken& token) {\n");
+    ASSERT_NE(begin, -1) << src.toStdString();
+    const QString body = src.mid(begin, src.indexOf("\n}\n", begin) - begin);
+    EXPECT_TRUE(body.contains("m_client.invokeAsyncResult(\"add\", _args,"));
+    EXPECT_TRUE(body.contains("if (_res.error.ok()) logosDispatchRejectionJson(_r, _res.error);"));
+    EXPECT_TRUE(body.endsWith(", token);")) << body.toStdString();
+}
+
 TEST(AsyncResult, LpValueDecodeIsSharedWithThePlainAsyncEntryPoint)
 {
     // Same decode expression in both, so a failed call delivers exactly the
@@ -326,7 +350,7 @@ TEST(AsyncResult, LpPlainAsyncEntryPointIsUnchanged)
     const QString h = lpHeader();
     EXPECT_TRUE(h.contains("void addAsync(int64_t p0, int64_t p1, std::function<void(int64_t)> callback);"));
     EXPECT_TRUE(h.contains("void resetAsync(std::function<void()> callback);"));
-    EXPECT_TRUE(lpSource().contains("m_client.invokeAsync(\"add\", _args, [callback](nlohmann::json _r) {"));
+    EXPECT_TRUE(lpSource().contains("m_client.invokeAsync(\"add\", _args, [callback = std::move(callback)](nlohmann::json _r) {"));
 }
 
 // ─── 5. A REJECTION reaches the surface that can report it ──────────────────
@@ -364,3 +388,259 @@ TEST(AsyncResult, ThePlainAsyncEntryPointStillOnlyWarns)
     EXPECT_TRUE(src.contains("Mod::addAsync: remote call failed:"));
     EXPECT_FALSE(src.contains("Mod::addAsyncResult: remote call failed:"));
 }
+
+// ─── 6. The Qt-free surface pipelines a batch ───────────────────────────────
+//
+// `batch()` hands out a typed builder over LpClient::invokeBatch: one queueing
+// method per contract method, each taking the callback `<name>AsyncResult`
+// takes, and send() to put them all on the wire at once.
+
+TEST(LpBatch, HeaderDeclaresOneQueueingMethodPerContractMethod)
+{
+    const QString h = lpHeader();
+    EXPECT_TRUE(h.contains("class Batch {"));
+    EXPECT_TRUE(h.contains("void add(int64_t p0, int64_t p1, "
+                           "std::function<void(logos::AsyncResult<int64_t>)> callback = nullptr);"));
+    EXPECT_TRUE(h.contains("void reset(std::function<void(logos::AsyncResult<void>)> callback = nullptr);"));
+    EXPECT_TRUE(h.contains("void send(std::function<void()> done = nullptr, int timeout_ms = 0);"));
+    EXPECT_TRUE(h.contains("Batch batch();"));
+}
+
+TEST(LpBatch, QueuedCallsShareTheAsyncResultAdapterAndGoOutTogether)
+{
+    const QString src = lpSource();
+    EXPECT_TRUE(src.contains("Mod::Batch Mod::batch() {\n    return Batch(m_client);\n}"));
+    EXPECT_TRUE(src.contains("void Mod::Batch::add(int64_t p0, int64_t p1, "
+                             "std::function<void(logos::AsyncResult<int64_t>)> callback) {"));
+    EXPECT_TRUE(src.contains("    _call.method = \"add\";\n"
+                             "    logos::ArgsWriter _args;\n"
+                             "    _args.value(p0);\n"
+                             "    _args.value(p1);\n"
+                             "    _call.argsText = _args.take();\n"));
+    EXPECT_FALSE(src.contains("_call.args.push_back(")) << src.toStdString();
+    // The same fold-then-decode adapter a lone AsyncResult call gets: one per
+    // method on the two AsyncResult overloads and the Co and batch paths.
+    const QString fold = "if (_res.error.ok()) logosDispatchRejectionJson(_r, _res.error);";
+    EXPECT_EQ(src.count(fold), 4 * sampleMethods().size());
+    EXPECT_TRUE(src.contains("m_client->invokeBatch(std::move(_calls),"));
+}
+
+TEST(LpBatch, ANameThatWouldCollideSuppressesTheBuilder)
+{
+    QJsonArray methods = sampleMethods();
+    methods.append(method("send", "void"));
+    EXPECT_FALSE(makeHeader("mod", "Mod", methods, ApiStyle::Lp).contains("class Batch"));
+    EXPECT_FALSE(makeSource("mod", "Mod", "mod.h", methods, ApiStyle::Lp).contains("invokeBatch"));
+    // Nothing to queue, nothing to emit.
+    EXPECT_FALSE(makeHeader("mod", "Mod", QJsonArray{}, ApiStyle::Lp).contains("class Batch"));
+}
+
+// ─── 7. …and a C++20 coroutine twin ─────────────────────────────────────────
+//
+// `<name>Co` returns logos::Task<logos::AsyncResult<T>> for `co_await`. It is
+// guarded by LOGOS_HAS_COROUTINES, so a C++17 module never sees it.
+
+TEST(LpCoroutine, HeaderDeclaresTheTwinBehindTheFeatureMacro)
+{
+    const QString h = lpHeader();
+    EXPECT_TRUE(h.contains("#include \"logos_task.h\""));
+    const QString decl = "    logos::Task<logos::AsyncResult<int64_t>> addCo(int64_t p0, int64_t p1, int timeout_ms = 0);\n";
+    EXPECT_TRUE(h.contains("#if LOGOS_HAS_COROUTINES\n" + decl + "#endif\n"));
+    EXPECT_TRUE(h.contains("logos::Task<logos::AsyncResult<void>> resetCo(int timeout_ms = 0);"));
+}
+
+// Arguments are written straight to text; no json array is built to be
+// dumped by the client.
+TEST(LpArgs, EachOverloadWritesItsArgumentsIntoAnArgsWriter)
+{
+    const QString src = lpSource();
+    EXPECT_EQ(src.count("    logos::ArgsWriter _args;\n"
+                        "    _args.value(p0);\n"
+                        "    _args.value(p1);\n"), 5) << src.toStdString();
+    EXPECT_FALSE(src.contains("nlohmann::json _args")) << src.toStdString();
+}
+
+TEST(LpCoroutine, BodyAwaitsTheClientThenFoldsAndDecodesLikeAsyncResult)
+{
+    const QString src = lpSource();
+    const int begin = src.indexOf("logos::Task<logos::AsyncResult<std::string>> Mod::nameCo(int timeout_ms) {");
+    ASSERT_NE(begin, -1) << src.toStdString();
+    const QString body = src.mid(begin, src.indexOf("#endif", begin) - begin);
+    EXPECT_TRUE(body.contains("co_await m_client.invokeCo(\"name\", std::move(_args), timeout_ms);"));
+    const int fold = body.indexOf("if (_res.error.ok()) logosDispatchRejectionJson(_r, _res.error);");
+    const int decode = body.indexOf("_res.value = (_r.is_string() ? _r.get<std::string>() : std::string());");
+    ASSERT_NE(fold, -1);
+    ASSERT_NE(decode, -1);
+    EXPECT_LT(fold, decode);
+    EXPECT_TRUE(body.contains("co_return _res;"));
+}
+
+TEST(LpCompletion, TheCallerCallbackIsMovedIntoTheAdapterNotCopied)
+{
+    // LpClient stores the adapter in a pooled slot without allocating; a COPY
+    // of the caller's std::function would put an allocation straight back.
+    const QString src = lpSource();
+    EXPECT_FALSE(src.contains("[callback](nlohmann::json _r"));
+    EXPECT_TRUE(src.contains("_call.onResult =\n        [callback = std::move(callback)]"));
+}
+
+// ─── Result cache: `@cache` methods are registered with the client ─────────
+
+namespace {
+
+QJsonArray cachedMethods()
+{
+    QJsonArray a = sampleMethods();
+    QJsonObject get = method("getConfig", "QString");
+    QJsonObject cache;
+    cache["ttlMs"] = 5000;
+    cache["invalidatedBy"] = QJsonArray{"configChanged"};
+    get["cache"] = cache;
+    a.append(get);
+    QJsonObject resolve = method("resolve", "QString", {"QString"});
+    QJsonObject plain;
+    plain["ttlMs"] = 250;
+    plain["invalidatedBy"] = QJsonArray();
+    resolve["cache"] = plain;
+    a.append(resolve);
+    return a;
+}
+
+} // namespace
+
+TEST(LpCache, TheStaticConstructorRegistersEachCachedMethod)
+{
+    const QString src = makeSource("mod", "Mod", "mod.h", cachedMethods(), ApiStyle::Lp);
+    EXPECT_TRUE(src.contains(
+        "Mod::Mod(const std::string& origin) : m_client(\"mod\", origin) {\n"
+        "    m_client.cacheMethod(\"getConfig\", 5000, {\"configChanged\"});\n"
+        "    m_client.cacheMethod(\"resolve\", 250);\n"
+        "}\n")) << src.toStdString();
+    EXPECT_FALSE(src.contains("cacheMethod(\"add\""));
+    EXPECT_TRUE(src.contains("void Mod::invalidateCache(const std::string& method) {\n"
+                             "    m_client.invalidateCache(method);\n"));
+}
+
+TEST(LpCache, TheBoundStateRegistersThemInItsConstructor)
+{
+    const QString h = makeHeader("mod", "Mod", cachedMethods(), ApiStyle::Lp, {}, BindMode::Bound);
+    EXPECT_TRUE(h.contains(
+        "        State(const std::string& target, const std::string& origin) : client(target, origin) {\n"
+        "            client.cacheMethod(\"getConfig\", 5000, {\"configChanged\"});\n"))
+        << h.toStdString();
+    EXPECT_TRUE(h.contains("    void invalidateCache(const std::string& method = std::string());\n"));
+    const QString src = makeSource("mod", "Mod", "mod.h", cachedMethods(), ApiStyle::Lp, {}, BindMode::Bound);
+    EXPECT_TRUE(src.contains("    m_state->client.invalidateCache(method);\n"));
+}
+
+TEST(LpCache, AnUntaggedContractEmitsNoCacheCode)
+{
+    EXPECT_TRUE(lpSource().contains("Mod::Mod(const std::string& origin) : m_client(\"mod\", origin) {}\n"));
+    EXPECT_FALSE(lpSource().contains("cacheMethod"));
+    EXPECT_FALSE(lpSource().contains("invalidateCache"));
+    EXPECT_FALSE(lpHeader().contains("invalidateCache"));
+    const QString bound = makeHeader("mod", "Mod", sampleMethods(), ApiStyle::Lp, {}, BindMode::Bound);
+    EXPECT_TRUE(bound.contains(": client(target, origin) {}\n"));
+}
+
+TEST(LpCache, TheDocCommentTagsReachTheJsonSurface)
+{
+    ModuleDecl mod;
+    mod.name = "config";
+    MethodDecl get;
+    get.name = "getConfig";
+    get.returnType = {TypeExpr::Primitive, "tstr", {}};
+    get.description = "Current configuration.\n@cache 5000\n@invalidated-by configChanged nosuchEvent";
+    mod.methods.push_back(get);
+    MethodDecl bad;
+    bad.name = "peek";
+    bad.returnType = {TypeExpr::Primitive, "tstr", {}};
+    bad.description = "@cache soon";
+    mod.methods.push_back(bad);
+    EventDecl changed;
+    changed.name = "configChanged";
+    mod.events.push_back(changed);
+
+    const QJsonArray methods = moduleMethodsToJson(mod);
+    const QJsonObject cache = methods.at(0).toObject().value("cache").toObject();
+    EXPECT_EQ(cache.value("ttlMs").toInt(), 5000);
+    // An event the module does not declare could never fire; it is dropped.
+    EXPECT_EQ(cache.value("invalidatedBy").toArray(), QJsonArray{"configChanged"});
+    EXPECT_FALSE(methods.at(1).toObject().contains("cache"));
+
+    QString notes;
+    QTextStream err(&notes);
+    noteMethodCacheTags(mod, "config.lidl", err);
+    err.flush();
+    EXPECT_TRUE(notes.contains("peek: `@cache` needs a positive TTL")) << notes.toStdString();
+    EXPECT_TRUE(notes.contains("`@invalidated-by nosuchEvent` names no event")) << notes.toStdString();
+}
+
+// `@single-flight` registers the method with the client next to its cache
+// policy; a method may carry either tag without the other.
+TEST(LpSingleFlight, TaggedMethodsAreRegisteredWithTheClient)
+{
+    QJsonArray methods;
+    QJsonObject resolve = method("resolve", "QString", {"QString"});
+    resolve["singleFlight"] = true;
+    methods.append(resolve);
+    methods.append(method("add", "int", {"int", "int"}));
+
+    const QString src = makeSource("mod", "Mod", "mod.h", methods, ApiStyle::Lp);
+    EXPECT_TRUE(src.contains(
+        "Mod::Mod(const std::string& origin) : m_client(\"mod\", origin) {\n"
+        "    m_client.singleFlight(\"resolve\");\n"
+        "}\n")) << src.toStdString();
+    // Nothing cached, so nothing to invalidate.
+    EXPECT_FALSE(src.contains("invalidateCache")) << src.toStdString();
+
+    const QString h = makeHeader("mod", "Mod", methods, ApiStyle::Lp, {}, BindMode::Bound);
+    EXPECT_TRUE(h.contains(
+        "        State(const std::string& target, const std::string& origin) : client(target, origin) {\n"
+        "            client.singleFlight(\"resolve\");\n"
+        "        }\n")) << h.toStdString();
+}
+
+TEST(LpSingleFlight, TheDocCommentTagReachesTheJsonSurface)
+{
+    ModuleDecl mod;
+    mod.name = "registry";
+    MethodDecl resolve;
+    resolve.name = "resolve";
+    resolve.returnType = {TypeExpr::Primitive, "tstr", {}};
+    resolve.description = "Resolves a name.\n@single-flight";
+    mod.methods.push_back(resolve);
+    MethodDecl plain;
+    plain.name = "list";
+    plain.returnType = {TypeExpr::Primitive, "tstr", {}};
+    mod.methods.push_back(plain);
+
+    const QJsonArray methods = moduleMethodsToJson(mod);
+    EXPECT_TRUE(methods.at(0).toObject().value("singleFlight").toBool());
+    EXPECT_FALSE(methods.at(0).toObject().contains("cache"));
+    EXPECT_FALSE(methods.at(1).toObject().contains("singleFlight"));
+}
+
+// ─── Concurrency limit: every Lp wrapper can cap its calls in flight ───────
+
+TEST(LpConcurrencyLimit, EveryWrapperForwardsToItsClient)
+{
+    const QString h = lpHeader();
+    EXPECT_TRUE(h.contains("    void limitConcurrency(const logos::ConcurrencyLimitOptions& options"
+                           " = logos::ConcurrencyLimitOptions());\n")) << h.toStdString();
+    EXPECT_TRUE(lpSource().contains(
+        "void Mod::limitConcurrency(const logos::ConcurrencyLimitOptions& options) {\n"
+        "    m_client.limitConcurrency(options);\n"
+        "}\n"));
+    const QString bound = makeSource("mod", "Mod", "mod.h", sampleMethods(), ApiStyle::Lp, {}, BindMode::Bound);
+    EXPECT_TRUE(bound.contains("    m_state->client.limitConcurrency(options);\n"));
+}
+
+TEST(LpConcurrencyLimit, AContractMethodOfThatNameWins)
+{
+    QJsonArray methods = sampleMethods();
+    methods.append(method("limitConcurrency", "void", {"int"}));
+    const QString src = makeSource("mod", "Mod", "mod.h", methods, ApiStyle::Lp);
+    EXPECT_FALSE(src.contains("ConcurrencyLimitOptions")) << src.toStdString();
+    EXPECT_FALSE(makeHeader("mod", "Mod", methods, ApiStyle::Lp).contains("ConcurrencyLimitOptions"));
+}
@@ -163,8 +163,8 @@ TEST(MakeSourceTest, LpAnyReturnPassesThroughButMapForcesObject)
     methods.append(mp);
 
     QString src = makeSourceLp("mod", "Mod", "mod.h", methods);
-    // `any` return: raw passthrough (return _r;), no is_object coercion.
-    EXPECT_TRUE(src.contains("return _r;"));
+    // `any` return: raw passthrough (return _r.json();), no is_object coercion.
+    EXPECT_TRUE(src.contains("return _r.json();"));
     // `{tstr:any}` map return: still forced to an object.
     EXPECT_TRUE(src.contains("_r.is_object() ? _r : LogosMap::object()"));
 }
@@ -192,6 +192,12 @@ TEST(OptionalSpellings, OptionalityActuallySurvivesOnLp)
         // into 0 / "".
         EXPECT_TRUE(e.source.contains(
             "if (w.contains(\"maybe\") && !w.at(\"maybe\").is_null())")) << e.source.toStdString();
+        // Read off the reply text, null is the same empty state — and resets
+        // the field, since a repeated key's last value is the one that counts.
+        EXPECT_TRUE(e.source.contains(
+            "if (__key == \"maybe\") { if (r.peek() == logos::JsonReader::Kind::Null) { r.skip(); "
+            "out.maybe.reset(); } else { out.maybe.emplace(); logos::readLenient(r, (*out.maybe)); } }"))
+            << e.source.toStdString();
     }
 }
 
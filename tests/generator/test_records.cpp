@@ -154,6 +154,74 @@ TEST(Records, ConversionsStayOutOfTheHeader)
               c.indexOf("static nlohmann::json recToWire_Status(const InfoModule::Status& v) {"));
 }
 
+// A record argument is written field by field into the call's ArgsWriter,
+// with the same encoding recToWire_* gives it, and without the json object.
+TEST(Records, LpArgumentsAreWrittenWithoutAJsonObject)
+{
+    QJsonArray methods = statusMethods();
+    methods.append(method("putBatch", "void", QJsonArray{param("b", "Batch")}));
+    const QString c = makeSource("info_module", "InfoModule", "info_module_api.h",
+                                 methods, ApiStyle::Lp, {}, BindMode::Static, statusRecords());
+    EXPECT_TRUE(c.contains(
+        "static void recWrite_Status(logos::ArgsWriter& w, const InfoModule::Status& v) {\n"
+        "    w.beginObject();\n"
+        "    w.key(\"port\"); w.value(v.port);\n"
+        "    w.key(\"blob\"); w.bytes(v.blob);\n"
+        "    w.endObject();\n"
+        "}\n")) << c.toStdString();
+    EXPECT_TRUE(c.contains(
+        "    w.key(\"items\"); w.beginArray(); for (const auto& __e : v.items) "
+        "recWrite_Status(w, __e); w.endArray();\n")) << c.toStdString();
+    EXPECT_TRUE(c.contains(
+        "    w.key(\"tags\"); w.beginObject(); for (const auto& __kv : v.tags) { "
+        "w.key(__kv.first); recWrite_Status(w, __kv.second); } w.endObject();\n"))
+        << c.toStdString();
+    EXPECT_TRUE(c.contains("    logos::ArgsWriter _args;\n"
+                           "    recWrite_Status(_args, s);\n")) << c.toStdString();
+
+    // Only records some argument can carry get a writer.
+    const QString plain = makeSource("info_module", "InfoModule", "info_module_api.h",
+                                     statusMethods(), ApiStyle::Lp, {}, BindMode::Static,
+                                     statusRecords());
+    EXPECT_TRUE(plain.contains("static void recWrite_Status("));
+    EXPECT_FALSE(plain.contains("recWrite_Batch")) << plain.toStdString();
+}
+
+// A record return is read off the reply text field by field, with the same
+// decode recFromWire_* gives it, and without the json object.
+TEST(Records, LpRepliesAreReadWithoutAJsonObject)
+{
+    const QString c = makeSource("info_module", "InfoModule", "info_module_api.h",
+                                 statusMethods(), ApiStyle::Lp, {}, BindMode::Static,
+                                 statusRecords());
+    EXPECT_TRUE(c.contains(
+        "static void recRead_Status(logos::JsonReader& r, InfoModule::Status& out) {\n"
+        "    if (r.peek() != logos::JsonReader::Kind::Object) { r.skip(); return; }\n"
+        "    r.beginObject();\n"
+        "    std::string __key;\n"
+        "    while (r.nextKey(__key)) {\n"
+        "        if (__key == \"port\") { logos::readLenient(r, out.port); }\n"
+        "        else if (__key == \"blob\") { logos::readLenient(r, out.blob); }\n"
+        "        else r.skip();\n"
+        "    }\n"
+        "}\n")) << c.toStdString();
+    EXPECT_TRUE(c.contains(
+        "        else if (__key == \"items\") { out.items.clear(); "
+        "if (r.peek() == logos::JsonReader::Kind::Array) { r.beginArray(); "
+        "while (r.nextElement()) { out.items.emplace_back(); recRead_Status(r, out.items.back()); } "
+        "} else { r.skip(); } }\n")) << c.toStdString();
+    EXPECT_TRUE(c.contains(
+        "    return _r.read<InfoModule::Status>([](logos::JsonReader& r, InfoModule::Status& out) { "
+        "out = {}; recRead_Status(r, out); });\n")) << c.toStdString();
+
+    // Only records some blocking return can carry get a reader.
+    const QString plain = makeSource("info_module", "InfoModule", "info_module_api.h",
+                                     QJsonArray{method("getStatus", "Status")}, ApiStyle::Lp,
+                                     {}, BindMode::Static, statusRecords());
+    EXPECT_TRUE(plain.contains("static void recRead_Status("));
+    EXPECT_FALSE(plain.contains("recRead_Batch")) << plain.toStdString();
+}
+
 // A return type written before the `Class::` of a definition is outside class
 // scope and must be qualified; a parameter is inside it and must not be
 // (an unqualified return type simply does not compile).
@@ -214,3 +282,38 @@ TEST(Records, TypedEventCallbacksTakeTheStruct)
                                  statusRecords());
     EXPECT_TRUE(c.contains("recFromWire_Status(_args.at(0))"));
 }
+
+// On the Lp surface an event is decoded once per arrival, by a generated
+// decoder, and every listener is handed the same tuple.
+TEST(Records, LpEventListenersShareOneTypedDecode)
+{
+    QJsonObject ev;
+    ev["name"] = "statusChanged";
+    ev["params"] = QJsonArray{param("s", "Status"), param("at", "qlonglong")};
+    const QString c = makeSource("info_module", "InfoModule", "info_module_api.h",
+                                 statusMethods(), ApiStyle::Lp, QJsonArray{ev}, BindMode::Static,
+                                 statusRecords());
+    EXPECT_TRUE(c.contains(
+        "static bool lpDecodeEvent_statusChanged(const nlohmann::json& _a, "
+        "std::tuple<InfoModule::Status, int64_t>& _e) {\n"
+        "    if (!_a.is_array() || _a.size() < 2) return false;\n"
+        "    _e = std::tuple<InfoModule::Status, int64_t>(recFromWire_Status(_a.at(0)), "))
+        << c.toStdString();
+    EXPECT_TRUE(c.contains(
+        "    auto _sub = m_client.subscribeDecoded<std::tuple<Status, int64_t>>(\"statusChanged\", "
+        "&lpDecodeEvent_statusChanged,\n"
+        "        [callback = std::move(callback)](const std::tuple<Status, int64_t>& _e) "
+        "{ std::apply(callback, _e); },\n"
+        "        queue, executor);\n"));
+    EXPECT_TRUE(c.contains("#include <tuple>\n"));
+    EXPECT_FALSE(c.contains("nlohmann::json _a)"));
+
+    // A slow listener can ask for a bounded queue or an executor; by default
+    // it has neither.
+    const QString h = makeHeader("info_module", "InfoModule", statusMethods(),
+                                 ApiStyle::Lp, QJsonArray{ev}, BindMode::Static, statusRecords());
+    EXPECT_TRUE(h.contains(
+        "    bool onStatusChanged(std::function<void(const Status& s, int64_t at)> callback,\n"
+        "        const logos::EventQueueOptions& queue = {}, logos::Executor* executor = nullptr);\n"))
+        << h.toStdString();
+}
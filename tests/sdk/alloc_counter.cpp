@@ -0,0 +1,41 @@
+// The global allocator replacements behind AllocCount (alloc_counter.h).
+// Everything passes straight through to malloc/free; the only addition is a
+// per-thread count while an AllocCount is alive.
+
+#include "alloc_counter.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+thread_local bool t_counting = false;
+thread_local int t_allocs = 0;
+
+void* allocate(std::size_t n)
+{
+    if (t_counting) ++t_allocs;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+}  // namespace
+
+void* operator new(std::size_t n) { return allocate(n); }
+void* operator new[](std::size_t n) { return allocate(n); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace logos_tests {
+
+AllocCount::AllocCount() : m_start(t_allocs), m_outer(!t_counting) { t_counting = true; }
+
+AllocCount::~AllocCount()
+{
+    if (m_outer) t_counting = false;
+}
+
+int AllocCount::count() const { return t_allocs - m_start; }
+
+}  // namespace logos_tests
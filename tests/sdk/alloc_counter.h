@@ -0,0 +1,34 @@
+#ifndef LOGOS_TESTS_ALLOC_COUNTER_H
+#define LOGOS_TESTS_ALLOC_COUNTER_H
+
+// Counts this thread's global operator new calls for as long as an
+// AllocCount is alive, so a test can assert that a code path does not
+// allocate.
+//
+// The replacement operators live in alloc_counter.cpp and are linked only
+// into sdk_alloc_tests. Replacing the global allocator changes it for every
+// test in the executable, so the suites that do not count keep the
+// standard one; and with the replacements out of line, no translation unit
+// sees a `new` paired with the free() underneath, which GCC's
+// -Wmismatched-new-delete would flag.
+
+namespace logos_tests {
+
+class AllocCount {
+public:
+    AllocCount();
+    ~AllocCount();
+    AllocCount(const AllocCount&) = delete;
+    AllocCount& operator=(const AllocCount&) = delete;
+
+    // Allocations on this thread since construction.
+    int count() const;
+
+private:
+    int m_start;
+    bool m_outer;
+};
+
+}  // namespace logos_tests
+
+#endif // LOGOS_TESTS_ALLOC_COUNTER_H
@@ -0,0 +1,153 @@
+// logos::ArgsWriter on its own: the text it writes must be what json::dump()
+// writes for the same values, byte for byte, since a target parses both.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "logos_args_writer.h"
+
+TEST(ArgsWriter, ScalarsAndStringsMatchDump)
+{
+    const std::string tricky = "quote\" slash\\ nl\n tab\t bell\x07 del\x7f \xc3\xa9";
+    logos::ArgsWriter w;
+    w.value(true).value(false)
+     .value(std::int64_t(-42)).value(std::numeric_limits<std::uint64_t>::max()).value(7)
+     .value(1.0).value(0.1).value(std::nan("")).value(std::numeric_limits<double>::infinity())
+     .value(tricky).value("")
+     .value(std::vector<std::string>{"a", "b"})
+     .value(nlohmann::json{{"k", nlohmann::json::array({1, nullptr})}});
+
+    const nlohmann::json expected = nlohmann::json::array({
+        true, false, std::int64_t(-42), std::numeric_limits<std::uint64_t>::max(), 7,
+        1.0, 0.1, std::nan(""), std::numeric_limits<double>::infinity(),
+        tricky, "", std::vector<std::string>{"a", "b"},
+        nlohmann::json{{"k", nlohmann::json::array({1, nullptr})}}});
+    EXPECT_EQ(w.text(), expected.dump());
+}
+
+// Formatted on the stack rather than through a json: the layout is dump()'s
+// at each of its boundaries, where fixed notation gives way to exponents.
+TEST(ArgsWriter, DoublesAreLaidOutAsDumpLaysThem)
+{
+    const double cases[] = {
+        0.0, -0.0, 1.0, -2.5, 100.0, 0.1, 123.456, 1e-4, 1.2e-4, 1e-5, 1e15, 1e16,
+        123456789012345.0, 1234567890123456.0, 1e21, 1e300, 2.5e-8, -2.5e-300,
+        5e-324, std::numeric_limits<double>::max(), std::numeric_limits<double>::min(),
+        -std::numeric_limits<double>::infinity()};
+    for (double d : cases) {
+        logos::ArgsWriter w;
+        w.value(d);
+        EXPECT_EQ(w.text(), nlohmann::json::array({d}).dump()) << d;
+    }
+}
+
+// Where nlohmann's Grisu2 and the shortest spelling pick different digits,
+// the text may differ from dump()'s; the double it reads back as may not.
+TEST(ArgsWriter, EveryDoubleReadsBackAsItself)
+{
+    std::uint64_t bits = 0x9E3779B97F4A7C15ull;
+    for (int i = 0; i < 100000; ++i) {
+        bits ^= bits << 13;
+        bits ^= bits >> 7;
+        bits ^= bits << 17;
+        double d;
+        std::memcpy(&d, &bits, sizeof d);
+        if (!std::isfinite(d)) continue;
+        logos::ArgsWriter w;
+        w.value(d);
+        const nlohmann::json back = nlohmann::json::parse(w.text());
+        ASSERT_EQ(std::memcmp(&back[0].get_ref<const double&>(), &d, sizeof d), 0) << w.text();
+    }
+}
+
+TEST(ArgsWriter, BytesAreTaggedUnpaddedBase64Url)
+{
+    // RFC 4648's test vectors, plus the two characters base64url changes.
+    const std::vector<std::pair<std::string, std::string>> cases = {
+        {"", ""}, {"f", "Zg"}, {"fo", "Zm8"}, {"foo", "Zm9v"}, {"foob", "Zm9vYg"},
+        {"fooba", "Zm9vYmE"}, {"foobar", "Zm9vYmFy"}, {"\xfb\xff", "-_8"}};
+    for (const auto& c : cases) {
+        logos::ArgsWriter w;
+        w.bytes(std::vector<std::uint8_t>(c.first.begin(), c.first.end()));
+        EXPECT_EQ(w.text(), "[{\"_bytes\":\"" + c.second + "\"}]") << c.second;
+    }
+}
+
+TEST(ArgsWriter, RecordsAndListsNest)
+{
+    logos::ArgsWriter w;
+    w.beginArray();
+    for (int i = 0; i < 2; ++i) {
+        w.beginObject();
+        w.key("id").value(i);
+        w.key("tags").beginArray().value("x").endArray();
+        w.key("empty").beginObject().endObject();
+        w.endObject();
+    }
+    w.endArray();
+    w.value("after");
+
+    nlohmann::json list = nlohmann::json::array();
+    for (int i = 0; i < 2; ++i)
+        list.push_back({{"id", i}, {"tags", {"x"}}, {"empty", nlohmann::json::object()}});
+    // nlohmann sorts object keys; the writer keeps them in write order.
+    EXPECT_EQ(nlohmann::json::parse(w.text()), nlohmann::json::array({list, "after"}));
+    EXPECT_EQ(w.text().find("{\"id\":0,\"tags\":[\"x\"],\"empty\":{}}"), 2u) << w.text();
+}
+
+TEST(ArgsWriter, TheThreadsBufferIsReused)
+{
+    std::size_t grown = 0;
+    {
+        logos::ArgsWriter w;
+        w.value(std::string(4096, 'x'));
+        grown = w.text().capacity();
+
+        // A writer made while another is alive starts on a buffer of its own.
+        logos::ArgsWriter inner;
+        EXPECT_EQ(inner.text(), "[]");
+    }
+    logos::ArgsWriter again;
+    EXPECT_GE(again.text().capacity(), grown);
+    EXPECT_EQ(again.text(), "[]");
+}
+
+TEST(ArgsWriter, TextThatIsNotUtf8ThrowsAsDumpDoes)
+{
+    const std::vector<std::string> bad = {
+        "\xff", "a\xc3", "\xc0\xaf", "\xe0\x80\xaf", "\xed\xa0\x80", "\xf4\x90\x80\x80",
+        "ok \xe2\x82 then"};
+    for (const std::string& s : bad) {
+        std::string dumpWhat, writerWhat;
+        int dumpId = 0, writerId = 0;
+        try {
+            (void)nlohmann::json(s).dump();
+        } catch (const nlohmann::json::type_error& e) {
+            dumpWhat = e.what();
+            dumpId = e.id;
+        }
+        try {
+            logos::ArgsWriter w;
+            w.value(s);
+        } catch (const nlohmann::json::type_error& e) {
+            writerWhat = e.what();
+            writerId = e.id;
+        }
+        EXPECT_EQ(dumpId, 316);
+        EXPECT_EQ(writerId, dumpId);
+        EXPECT_EQ(writerWhat, dumpWhat);
+    }
+
+    // Keys are checked the same way; the 4-byte maximum is still fine.
+    logos::ArgsWriter w;
+    EXPECT_THROW(w.beginObject().key("\x80"), nlohmann::json::type_error);
+    logos::ArgsWriter ok;
+    ok.value("\xf4\x8f\xbf\xbf");
+    EXPECT_EQ(ok.text(), nlohmann::json::array({"\xf4\x8f\xbf\xbf"}).dump());
+}
@@ -0,0 +1,93 @@
+// logos::Deferred<T> — a method result that arrives later.
+//
+// The generated dispatch drives a Deferred through exactly two framework calls:
+// attach a continuation (logos_module_dispatch_async) or wait for the value
+// (logos_module_dispatch). Both consume the handle the method returned, which
+// is what lets a Deferred nobody kept settle as abandoned instead of hanging.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "logos_deferred.h"
+
+TEST(Deferred, OnlyTheFirstSettlementCounts)
+{
+    logos::Deferred<int64_t> d;
+    EXPECT_FALSE(d.settled());
+    EXPECT_TRUE(d.resolve(7));
+    EXPECT_FALSE(d.resolve(8));
+    EXPECT_FALSE(d.reject("late", "too late"));
+    EXPECT_TRUE(d.settled());
+    EXPECT_EQ(logos::Deferred<int64_t>(d)._logosCoreWait_(), 7);
+}
+
+TEST(Deferred, ContinuationRunsWhenAKeptCopySettles)
+{
+    logos::Deferred<std::string> kept;
+    std::optional<std::string> seen;
+    logos::Deferred<std::string>(kept)._logosCoreOnSettled_(
+        [&](const std::string* value, const logos::DeferredRejected* error) {
+            ASSERT_EQ(error, nullptr);
+            seen = *value;
+        });
+    EXPECT_FALSE(seen.has_value());
+    kept.resolve("done");
+    EXPECT_EQ(seen, "done");
+}
+
+TEST(Deferred, ContinuationRunsInlineWhenAlreadySettled)
+{
+    logos::Deferred<void> d;
+    d.resolve();
+    bool ran = false;
+    std::move(d)._logosCoreOnSettled_(
+        [&](const logos::detail::DeferredUnit* value, const logos::DeferredRejected* error) {
+            EXPECT_NE(value, nullptr);
+            EXPECT_EQ(error, nullptr);
+            ran = true;
+        });
+    EXPECT_TRUE(ran);
+}
+
+TEST(Deferred, DroppingEveryHandleAbandonsTheCall)
+{
+    std::string code;
+    logos::Deferred<int64_t>()._logosCoreOnSettled_(
+        [&](const int64_t* value, const logos::DeferredRejected* error) {
+            EXPECT_EQ(value, nullptr);
+            ASSERT_NE(error, nullptr);
+            code = error->code();
+        });
+    EXPECT_EQ(code, "deferred_abandoned");
+
+    // The waiting side gives up its own handle first, so it cannot keep the
+    // call alive by waiting on it.
+    try {
+        logos::Deferred<int64_t>()._logosCoreWait_();
+        FAIL() << "an abandoned Deferred returned a value";
+    } catch (const logos::DeferredRejected& e) {
+        EXPECT_EQ(e.code(), "deferred_abandoned");
+    }
+}
+
+TEST(Deferred, WaitReturnsAValueSettledOnAnotherThread)
+{
+    logos::Deferred<std::string> d;
+    std::thread producer([d] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        d.reject("not_found", "no such key");
+    });
+    try {
+        logos::Deferred<std::string>(d)._logosCoreWait_();
+        FAIL() << "a rejected Deferred returned a value";
+    } catch (const logos::DeferredRejected& e) {
+        EXPECT_EQ(e.code(), "not_found");
+        EXPECT_STREQ(e.what(), "no such key");
+    }
+    producer.join();
+}
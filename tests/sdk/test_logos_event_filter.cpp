@@ -0,0 +1,85 @@
+// logos::EventFilter on its own: reading the payload's text has to agree with
+// testing the parsed payload, since which one a listener's filter sees is a
+// detail of delivery.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "logos_event_filter.h"
+
+namespace {
+
+// Both forms, which must agree.
+bool matches(const logos::EventFilter& f, const std::string& text)
+{
+    const bool onText = f.matches(text);
+    const bool onDom = f.matches(nlohmann::json::parse(text));
+    EXPECT_EQ(onText, onDom) << text;
+    return onText;
+}
+
+}  // namespace
+
+TEST(EventFilter, EqualityOnAPositionalArgument)
+{
+    logos::EventFilter f;
+    f.equal({0}, "acct-42");
+    EXPECT_TRUE(matches(f, R"(["acct-42", 1])"));
+    EXPECT_FALSE(matches(f, R"(["acct-7", 1])"));
+    EXPECT_FALSE(matches(f, R"([42])"));
+    EXPECT_FALSE(matches(f, R"([])"));
+    EXPECT_FALSE(matches(f, R"({"0": "acct-42"})"));
+    EXPECT_TRUE(matches(logos::EventFilter(), R"([])")) << "no conditions passes everything";
+}
+
+TEST(EventFilter, RangesCompareNumbersNumericallyAndStringsByBytes)
+{
+    logos::EventFilter f;
+    f.greaterOrEqual({1}, 10).less({1}, 20.5);
+    EXPECT_TRUE(matches(f, R"([null, 10])"));
+    EXPECT_TRUE(matches(f, R"([null, 20.25])"));
+    EXPECT_TRUE(matches(f, R"([null, 1.5e1])"));
+    EXPECT_FALSE(matches(f, R"([null, 9.99])"));
+    EXPECT_FALSE(matches(f, R"([null, 21])"));
+    EXPECT_FALSE(matches(f, R"([null, "15"])")) << "a string is not in a numeric range";
+
+    logos::EventFilter s;
+    s.between({0}, "b", "d");
+    EXPECT_TRUE(matches(s, R"(["b"])"));
+    EXPECT_TRUE(matches(s, R"(["cat"])"));
+    EXPECT_TRUE(matches(s, R"(["d"])"));
+    EXPECT_FALSE(matches(s, R"(["da"])"));
+    EXPECT_FALSE(matches(s, R"([3])"));
+}
+
+TEST(EventFilter, PathsReachIntoRecordFields)
+{
+    logos::EventFilter f;
+    f.equal({0, "owner", "id"}, 7).notEqual({0, "state"}, "closed");
+    EXPECT_TRUE(matches(f, R"([{"owner": {"id": 7}, "state": "open"}])"));
+    EXPECT_TRUE(matches(f, R"([{"owner": {"id": 7.0}}])")) << "a missing member is notEqual";
+    EXPECT_FALSE(matches(f, R"([{"owner": {"id": 7}, "state": "closed"}])"));
+    EXPECT_FALSE(matches(f, R"([{"owner": {"id": 8}}])"));
+    EXPECT_FALSE(matches(f, R"([{"owner": [7]}])"));
+    // A repeated member is the parser's last one.
+    EXPECT_TRUE(matches(f, R"([{"owner": {"id": 1}, "owner": {"id": 7}}])"));
+    EXPECT_FALSE(matches(f, R"([{"owner": {"id": 7}, "owner": {"id": 1}}])"));
+
+    logos::EventFilter whole;
+    whole.equal({1}, nlohmann::json::parse(R"({"a": [1, 2]})"));
+    EXPECT_TRUE(matches(whole, R"([0, {"a": [1, 2]}])"));
+    EXPECT_FALSE(matches(whole, R"([0, {"a": [2, 1]}])"));
+}
+
+TEST(EventFilter, ReadsTheTextOnlyAsFarAsItsPathsReach)
+{
+    logos::EventFilter f;
+    f.equal({0}, "x");
+    // Malformed past the first argument: the text form cannot tell, which is
+    // why delivery drops a filtered arrival that then fails to parse.
+    EXPECT_TRUE(f.matches(std::string(R"(["x", oops)")));
+    EXPECT_FALSE(f.matches(std::string(R"([oops, "x"])")));
+    EXPECT_FALSE(f.matches(std::string("")));
+}
@@ -0,0 +1,170 @@
+// logos::EventQueue on its own: each overflow policy, with the listener held
+// on a gate so that the queue fills deterministically, and the close()
+// guarantee that nothing is delivered once it returns.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "logos_event_queue.h"
+
+namespace {
+
+using Overflow = logos::EventQueueOptions::Overflow;
+
+// A listener that records what it was handed and holds its first call until
+// open() — so the first push is taken off the queue and every later one
+// waits in it.
+struct GatedListener {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool gateOpen = false;
+    bool entered = false;
+    std::vector<int> seen;
+
+    std::function<void(const int&)> fn()
+    {
+        return [this](const int& v) {
+            std::unique_lock<std::mutex> lock(mutex);
+            entered = true;
+            cv.notify_all();
+            cv.wait(lock, [this] { return gateOpen; });
+            seen.push_back(v);
+            cv.notify_all();
+        };
+    }
+    void awaitEntered()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return entered; });
+    }
+    void open()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        gateOpen = true;
+        cv.notify_all();
+    }
+    std::vector<int> awaitSeen(std::size_t n)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return seen.size() >= n; });
+        return seen;
+    }
+};
+
+// Pushes 0 (taken by the held listener), then 1..5 into a queue of three.
+std::vector<int> overflow(Overflow policy, std::shared_ptr<const logos::EventQueueCounters>& counters,
+                          std::size_t expect)
+{
+    GatedListener listener;
+    auto queue = std::make_shared<logos::EventQueue<int>>(logos::EventQueueOptions{3, policy},
+                                                          listener.fn());
+    queue->start();
+    counters = queue->counters();
+    queue->push(0);
+    listener.awaitEntered();
+    for (int i = 1; i <= 5; ++i) queue->push(i);
+    listener.open();
+    std::vector<int> seen = listener.awaitSeen(expect);
+    queue->close();
+    return seen;
+}
+
+}  // namespace
+
+TEST(EventQueue, DropOldestKeepsTheLatestArrivals)
+{
+    std::shared_ptr<const logos::EventQueueCounters> c;
+    EXPECT_EQ(overflow(Overflow::DropOldest, c, 4), (std::vector<int>{0, 3, 4, 5}));
+    EXPECT_EQ(c->dropped.load(), 2u);
+    EXPECT_EQ(c->delivered.load(), 4u);
+}
+
+TEST(EventQueue, DropNewestKeepsAnUnbrokenPrefix)
+{
+    std::shared_ptr<const logos::EventQueueCounters> c;
+    EXPECT_EQ(overflow(Overflow::DropNewest, c, 4), (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(c->dropped.load(), 2u);
+}
+
+TEST(EventQueue, CoalesceKeepsOnlyTheLatestWaitingArrival)
+{
+    std::shared_ptr<const logos::EventQueueCounters> c;
+    EXPECT_EQ(overflow(Overflow::Coalesce, c, 2), (std::vector<int>{0, 5}));
+    EXPECT_EQ(c->coalesced.load(), 4u);
+    EXPECT_EQ(c->dropped.load(), 0u);
+}
+
+TEST(EventQueue, BlockHoldsTheDeliveringThreadUntilThereIsRoom)
+{
+    GatedListener listener;
+    auto queue = std::make_shared<logos::EventQueue<int>>(logos::EventQueueOptions{2, Overflow::Block},
+                                                          listener.fn());
+    queue->start();
+    queue->push(0);
+    listener.awaitEntered();
+    queue->push(1);
+    queue->push(2);
+    std::atomic<bool> pushed{false};
+    std::thread producer([&] {
+        queue->push(3);
+        pushed = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(pushed) << "a full Block queue let an arrival through";
+    EXPECT_EQ(queue->counters()->depth.load(), 2u);
+    listener.open();
+    producer.join();
+    EXPECT_EQ(listener.awaitSeen(4), (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(queue->counters()->blocked.load(), 1u);
+    EXPECT_EQ(queue->counters()->dropped.load(), 0u);
+    queue->close();
+}
+
+TEST(EventQueue, CloseReleasesABlockedArrivalAndStopsDelivery)
+{
+    GatedListener listener;
+    auto queue = std::make_shared<logos::EventQueue<int>>(logos::EventQueueOptions{1, Overflow::Block},
+                                                          listener.fn());
+    queue->start();
+    queue->push(0);
+    listener.awaitEntered();
+    queue->push(1);
+    std::thread producer([&] { queue->push(2); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    std::thread closer([&] { queue->close(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    listener.open();  // close() waits for the call in progress
+    closer.join();
+    producer.join();
+    EXPECT_EQ(listener.seen, (std::vector<int>{0})) << "delivered after close";
+}
+
+TEST(EventQueue, AListenerMayCloseItsOwnQueue)
+{
+    std::shared_ptr<logos::EventQueue<int>> queue;
+    std::atomic<int> calls{0};
+    std::atomic<bool> returned{false};
+    queue = std::make_shared<logos::EventQueue<int>>(
+        logos::EventQueueOptions{4, Overflow::DropOldest}, [&](const int&) {
+            ++calls;
+            queue->close();
+            returned = true;
+        });
+    queue->start();
+    std::weak_ptr<logos::EventQueue<int>> weak = queue;
+    queue->push(1);
+    queue->push(2);
+    while (!returned) std::this_thread::yield();
+    queue.reset();
+    // The delivery thread held the queue through its last call, and lets it
+    // go on its way out.
+    while (!weak.expired()) std::this_thread::yield();
+    EXPECT_EQ(calls.load(), 1);
+}
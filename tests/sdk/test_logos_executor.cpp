@@ -0,0 +1,104 @@
+// logos::ThreadPool, and logos::EventQueue draining on it: every task runs,
+// work submitted to one busy worker is taken by the others, and a queue's
+// listener is called in order and never twice at once however many workers
+// it shares.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "logos_event_queue.h"
+#include "logos_executor.h"
+
+TEST(ThreadPool, RunsEverySubmittedTaskBeforeItIsDestroyed)
+{
+    std::atomic<int> ran{0};
+    {
+        logos::ThreadPool pool(3);
+        EXPECT_EQ(pool.size(), 3u);
+        for (int i = 0; i < 1000; ++i) pool.execute([&ran] { ++ran; });
+    }
+    EXPECT_EQ(ran.load(), 1000);
+}
+
+TEST(ThreadPool, IdleWorkersStealFromABusyOne)
+{
+    logos::ThreadPool pool(4);
+    std::mutex m;
+    std::set<std::thread::id> threads;
+    std::atomic<int> done{0};
+    // Submitted from inside one task, so every child lands on that worker's
+    // own deque; only stealing gets them onto the others.
+    pool.execute([&] {
+        for (int i = 0; i < 64; ++i)
+            pool.execute([&] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                std::lock_guard<std::mutex> lock(m);
+                threads.insert(std::this_thread::get_id());
+                ++done;
+            });
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    });
+    while (done.load() < 64) std::this_thread::yield();
+    std::lock_guard<std::mutex> lock(m);
+    EXPECT_GT(threads.size(), 1u) << "no worker stole from the busy one";
+}
+
+TEST(EventQueue, AnExecutorQueueDeliversInOrderOneCallAtATime)
+{
+    logos::ThreadPool pool(4);
+    constexpr int kQueues = 8;
+    constexpr int kArrivals = 500;
+    struct Listener {
+        std::atomic<int> inside{0};
+        std::atomic<bool> overlapped{false};
+        std::vector<int> seen;
+    };
+    std::vector<Listener> listeners(kQueues);
+    std::vector<std::shared_ptr<logos::EventQueue<int>>> queues;
+    for (Listener& l : listeners) {
+        queues.push_back(std::make_shared<logos::EventQueue<int>>(
+            logos::EventQueueOptions{}, [&l](const int& v) {
+                if (l.inside.fetch_add(1) != 0) l.overlapped = true;
+                l.seen.push_back(v);
+                l.inside.fetch_sub(1);
+            }, &pool));
+        queues.back()->start();
+    }
+    for (int i = 0; i < kArrivals; ++i)
+        for (auto& q : queues) q->push(i);
+    for (auto& q : queues)
+        while (q->counters()->delivered.load() < kArrivals) std::this_thread::yield();
+    for (auto& q : queues) q->close();
+
+    for (const Listener& l : listeners) {
+        EXPECT_FALSE(l.overlapped) << "one listener was called on two workers at once";
+        ASSERT_EQ(l.seen.size(), static_cast<std::size_t>(kArrivals));
+        for (int i = 0; i < kArrivals; ++i) ASSERT_EQ(l.seen[i], i);
+    }
+}
+
+TEST(EventQueue, ClosingAnExecutorQueueWaitsForTheCallInProgress)
+{
+    logos::ThreadPool pool(2);
+    std::atomic<bool> entered{false}, finished{false};
+    auto queue = std::make_shared<logos::EventQueue<int>>(
+        logos::EventQueueOptions{}, [&](const int&) {
+            entered = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            finished = true;
+        }, &pool);
+    queue->start();
+    queue->push(1);
+    queue->push(2);
+    while (!entered) std::this_thread::yield();
+    queue->close();
+    EXPECT_TRUE(finished);
+    EXPECT_EQ(queue->counters()->delivered.load(), 1u);
+}
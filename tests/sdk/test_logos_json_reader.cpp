@@ -0,0 +1,114 @@
+// logos::JsonReader on its own: it must accept exactly the texts
+// nlohmann::json::parse accepts, and read them to the same values, since a
+// reply decoded through either has to come out the same.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "logos_json_reader.h"
+
+namespace {
+
+bool parses(const std::string& text)
+{
+    return !nlohmann::json::parse(text, nullptr, /*allow_exceptions=*/false).is_discarded();
+}
+
+bool reads(const std::string& text)
+{
+    logos::JsonReader r(text);
+    r.skip();
+    return r.finish();
+}
+
+}  // namespace
+
+TEST(JsonReader, AcceptsExactlyWhatTheParserAccepts)
+{
+    const std::vector<std::string> texts = {
+        // Well-formed.
+        "null", " true ", "false", "0", "-0", "12", "-7", "1.5", "1e3", "-2.5E-3",
+        "18446744073709551615", "18446744073709551616", "-9223372036854775809",
+        "\"\"", R"("a\"\\\/\b\f\n\r\t")", R"("\u00e9\u20ac\ud83d\ude00")",
+        "\"\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80\"",
+        "[]", "[1,[2,[3]],{}]", R"({"a":1,"b":{"c":[true,null]}})", R"({"k":1,"k":2})",
+        "\n\t[ 1 , 2 ]\r\n",
+        // Malformed.
+        "", " ", "nul", "tru", "01", "-", "1.", ".5", "1e", "+1", "1e999", "-1e999",
+        "\"abc", "\"\\x\"", "\"\\u12\"", R"("\ud83d")", R"("\ude00")", R"("\ud83dx")",
+        "\"\x01\"", "\"\xc3\"", "\"\xc0\xaf\"", "\"\xed\xa0\x80\"", "\"\xf4\x90\x80\x80\"", "\"\xff\"",
+        "[", "[1,]", "[,1]", "[1 2]", "{\"a\"}", "{\"a\":}", "{a:1}", "{\"a\":1,}",
+        "{\"a\":1 \"b\":2}", "1 2", "[]]", "{}x", "NaN", "Infinity"};
+    for (const std::string& t : texts)
+        EXPECT_EQ(reads(t), parses(t)) << t;
+}
+
+TEST(JsonReader, ReadsValuesAsTheParserStoresThem)
+{
+    const std::string text =
+        R"({"s":"x\u00e9\n","i":-3,"u":18446744073709551615,"big":18446744073709551616,)"
+        R"("f":2.5,"b":true,"n":null,"list":["a",1],"skipped":{"deep":[[{}]]}})";
+    const nlohmann::json dom = nlohmann::json::parse(text);
+
+    logos::JsonReader r(text);
+    ASSERT_TRUE(r.beginObject());
+    std::string key;
+    std::vector<std::string> seen;
+    while (r.nextKey(key)) {
+        seen.push_back(key);
+        logos::JsonReader::Number n;
+        if (key == "s") {
+            std::string s;
+            ASSERT_TRUE(r.readString(s));
+            EXPECT_EQ(s, dom["s"].get<std::string>());
+        } else if (key == "i") {
+            ASSERT_TRUE(r.readNumber(n));
+            EXPECT_EQ(n.kind, logos::JsonReader::Number::Int);
+            EXPECT_EQ(n.i, -3);
+        } else if (key == "u") {
+            ASSERT_TRUE(r.readNumber(n));
+            EXPECT_EQ(n.kind, logos::JsonReader::Number::UInt);
+            EXPECT_EQ(n.u, dom["u"].get<std::uint64_t>());
+        } else if (key == "big") {
+            ASSERT_TRUE(r.readNumber(n));
+            EXPECT_EQ(n.kind, logos::JsonReader::Number::Float);
+            EXPECT_TRUE(dom["big"].is_number_float());
+            EXPECT_EQ(n.d, dom["big"].get<double>());
+        } else if (key == "f") {
+            ASSERT_TRUE(r.readNumber(n));
+            EXPECT_EQ(n.d, 2.5);
+        } else if (key == "b") {
+            bool b = false;
+            ASSERT_TRUE(r.readBool(b));
+            EXPECT_TRUE(b);
+        } else if (key == "n") {
+            EXPECT_EQ(r.peek(), logos::JsonReader::Kind::Null);
+            ASSERT_TRUE(r.readNull());
+        } else if (key == "list") {
+            nlohmann::json j;
+            ASSERT_TRUE(r.readJson(j));
+            EXPECT_EQ(j, dom["list"]);
+        } else {
+            ASSERT_TRUE(r.skip());
+        }
+    }
+    EXPECT_TRUE(r.finish());
+    EXPECT_EQ(seen.size(), 9u);
+}
+
+TEST(JsonReader, TheFirstErrorLatches)
+{
+    const std::string text = "[1,\"a\"]";
+    logos::JsonReader r(text);
+    ASSERT_TRUE(r.beginArray());
+    ASSERT_TRUE(r.nextElement());
+    std::string s;
+    EXPECT_FALSE(r.readString(s));  // it is a number
+    EXPECT_TRUE(r.failed());
+    EXPECT_FALSE(r.skip());
+    EXPECT_FALSE(r.nextElement());
+    EXPECT_FALSE(r.finish());
+}
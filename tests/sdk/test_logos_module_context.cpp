@@ -166,6 +166,71 @@ TEST(LogosModuleContextTest, LogosModulesPointerIndependentOfContext)
     EXPECT_EQ(ctx.modulePath(), "/m");
 }
 
+// ── batchEvents() ───────────────────────────────────────────────────────────
+
+namespace {
+
+// Exposes the protected batchEvents() the way a module impl would use it.
+class BatchingImpl : public LogosModuleContext {
+public:
+    using LogosModuleContext::EventBatch;
+    EventBatch open() const { return batchEvents(); }
+};
+
+} // namespace
+
+TEST(LogosModuleContextTest, EventBatchOpensAndClosesThroughTheFrameworkPair)
+{
+    BatchingImpl impl;
+    std::string trace;
+    _logos_codegen_::maybeSetEventBatching(impl,
+        [&] { trace += "begin;"; },
+        [&] { trace += "end;"; });
+
+    {
+        auto outer = impl.open();
+        {
+            auto inner = impl.open();
+            EXPECT_EQ(trace, "begin;begin;");
+        }
+        EXPECT_EQ(trace, "begin;begin;end;");
+        // Moving a batch hands over the one end() call; it is not doubled.
+        auto moved = std::move(outer);
+    }
+    EXPECT_EQ(trace, "begin;begin;end;end;");
+}
+
+namespace {
+
+class CoalescingImpl : public LogosModuleContext {
+public:
+    void post(const std::string& name) { int payload = 0; coalesceEventImpl_(name, &payload); }
+};
+
+} // namespace
+
+TEST(LogosModuleContextTest, CoalescedEventsUseTheCoalescingCallbackWhenInstalled)
+{
+    CoalescingImpl impl;
+    std::string trace;
+    _logos_codegen_::maybeSetEmitEvent(impl, [&](const std::string& n, void*) { trace += "emit:" + n + ";"; });
+
+    // Without a coalescing callback the event is emitted, not lost.
+    impl.post("progress");
+    EXPECT_EQ(trace, "emit:progress;");
+
+    _logos_codegen_::maybeSetCoalesceEvent(impl, [&](const std::string& n, void*) { trace += "coalesce:" + n + ";"; });
+    impl.post("progress");
+    EXPECT_EQ(trace, "emit:progress;coalesce:progress;");
+}
+
+TEST(LogosModuleContextTest, EventBatchIsInertOutsideAFrameworkContext)
+{
+    BatchingImpl impl;
+    auto batch = impl.open();  // nothing installed: must not crash or throw
+    (void)batch;
+}
+
 // ── Tag-dispatched helpers (_logos_codegen_::maybeSet*) ─────────────────────
 
 TEST(LogosModuleContextHelpersTest, MaybeSetContextWritesForInheritingImpl)
@@ -198,6 +263,13 @@ TEST(LogosModuleContextHelpersTest, MaybeSetLogosModulesWritesForInheritingImpl)
     EXPECT_EQ(&impl.modules(), &mods);
 }
 
+TEST(LogosModuleContextHelpersTest, MaybeSetEventBatchingNoOpForNonInheritingImpl)
+{
+    NonInheritingImpl impl;
+    _logos_codegen_::maybeSetEventBatching(impl, [] {}, [] {});
+    EXPECT_EQ(impl.touched, 0);
+}
+
 TEST(LogosModuleContextHelpersTest, MaybeSetLogosModulesNoOpForNonInheritingImpl)
 {
     NonInheritingImpl impl;
@@ -0,0 +1,140 @@
+// logos::ReplyWriter and logos::dumpToMalloc — a C ABI reply serialized
+// straight into the buffer the ABI hands back.
+//
+// The contract is "`.dump()`, byte for byte, in one malloc'd buffer": the host
+// parses these bytes, so any difference from what the generated dispatch used
+// to send — a number spelled differently, a string escaped differently — is a
+// wire change, not an optimization.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "logos_reply_buffer.h"
+
+namespace {
+
+std::string viaMalloc(const nlohmann::json& j)
+{
+    char* raw = logos::dumpToMalloc(j);
+    EXPECT_NE(raw, nullptr);
+    std::string out = raw ? raw : "";
+    std::free(raw);   // what logos_module_string_free does
+    return out;
+}
+
+std::string released(logos::ReplyWriter& w)
+{
+    char* raw = w.release();
+    EXPECT_NE(raw, nullptr);
+    std::string out = raw ? raw : "";
+    std::free(raw);
+    return out;
+}
+
+}  // namespace
+
+TEST(ReplyBuffer, IsByteIdenticalToDump)
+{
+    const nlohmann::json cases[] = {
+        nullptr, true, false, 0, -1, 18446744073709551615ull, -9223372036854775807ll - 1,
+        3.0, -0.0, 0.1, 1e300, 2.5e-8,
+        "", "plain", "quote\" backslash\\ newline\n tab\t ctl\x01", "\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80",
+        nlohmann::json::array(), nlohmann::json::object(),
+        nlohmann::json{{"success", true}, {"value", {1, 2, 3}}, {"error", nullptr}},
+        nlohmann::json{{"_bytes", "AAEC"}},
+        nlohmann::json{{"z", {{"b", {1.5, "x", nullptr}}, {"a", nlohmann::json::object()}}},
+                       {"a", {nlohmann::json::array(), -7, 1e16}}},
+    };
+    for (const auto& j : cases)
+        EXPECT_EQ(viaMalloc(j), j.dump()) << j.dump();
+}
+
+TEST(ReplyBuffer, GrowsInPlaceForLargeReplies)
+{
+    // Well past the initial reservation, so the buffer is grown many times;
+    // a record list of this shape is the case the change was made for.
+    nlohmann::json records = nlohmann::json::array();
+    for (int i = 0; i < 5000; ++i)
+        records.push_back({{"id", i}, {"name", "record-" + std::to_string(i)},
+                           {"tags", {"a", "b"}}, {"score", i * 0.5}});
+    const std::string expected = records.dump();
+    ASSERT_GT(expected.size(), 64u * 1024u);
+    EXPECT_EQ(viaMalloc(records), expected);
+}
+
+TEST(ReplyBuffer, InvalidUtf8ThrowsLikeDumpAndLeaksNothing)
+{
+    // `.dump()` refuses a string that is not UTF-8; the dispatch reports that
+    // as dispatch_failed, so the buffer has to refuse it the same way rather
+    // than ship the bytes.
+    const nlohmann::json bad = std::string("ok\xff");
+    EXPECT_THROW(bad.dump(), nlohmann::json::type_error);
+    EXPECT_THROW(logos::dumpToMalloc(bad), nlohmann::json::type_error);
+}
+
+// What the generated dispatch writes for a `[Record]` return, field by field in
+// key order, against the DOM the codec used to build for it.
+TEST(ReplyWriter, ARecordListIsByteIdenticalToItsDump)
+{
+    struct Row {
+        std::int64_t id;
+        std::string name;
+        std::optional<double> score;
+        std::vector<std::uint8_t> blob;
+    };
+    std::vector<Row> rows;
+    for (int i = 0; i < 3000; ++i)
+        rows.push_back({i - 5, "row \"" + std::to_string(i) + "\"\n\xc3\xa9",
+                        i % 3 ? std::optional<double>(i * 0.25) : std::nullopt,
+                        std::vector<std::uint8_t>(static_cast<std::size_t>(i % 5), 0xfb)});
+
+    // The blobs' tagged text, by length: base64url, unpadded.
+    static const char* const kEncoded[] = {"", "-w", "-_s", "-_v7", "-_v7-w"};
+    nlohmann::json dom = nlohmann::json::array();
+    logos::ReplyWriter w;
+    w.beginArray();
+    for (const Row& r : rows) {
+        nlohmann::json o = {{"id", r.id}, {"name", r.name}, {"blob", {{"_bytes", kEncoded[r.blob.size()]}}}};
+        if (r.score) o["score"] = *r.score;
+        dom.push_back(o);
+
+        w.beginObject();
+        w.key("blob").bytes(r.blob);
+        w.key("id").value(r.id);
+        w.key("name").value(r.name);
+        if (r.score) w.key("score").value(*r.score);
+        w.endObject();
+    }
+    w.endArray();
+    EXPECT_EQ(released(w), dom.dump());
+}
+
+TEST(ReplyWriter, WritesScalarsAndNullAsDumpDoes)
+{
+    const auto one = [](auto write) {
+        logos::ReplyWriter w;
+        write(w);
+        return released(w);
+    };
+    EXPECT_EQ(one([](logos::ReplyWriter& w) { w.value(std::uint64_t(18446744073709551615ull)); }),
+              nlohmann::json(18446744073709551615ull).dump());
+    EXPECT_EQ(one([](logos::ReplyWriter& w) { w.value(1.0); }), "1.0");
+    EXPECT_EQ(one([](logos::ReplyWriter& w) { w.value(false); }), "false");
+    EXPECT_EQ(one([](logos::ReplyWriter& w) { w.null(); }), "null");
+    EXPECT_EQ(one([](logos::ReplyWriter& w) { w.beginArray().null().value(std::string("x")).endArray(); }),
+              "[null,\"x\"]");
+}
+
+TEST(ReplyWriter, InvalidUtf8ThrowsLikeDump)
+{
+    logos::ReplyWriter w;
+    w.beginArray();
+    EXPECT_THROW(w.value(std::string("ok\xff")), nlohmann::json::type_error);
+}
@@ -0,0 +1,106 @@
+// logos::ResultCache on its own: expiry, eviction, and the generation check
+// that keeps an in-flight reply from undoing an invalidation. The clock is
+// passed explicitly, so nothing here sleeps.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+
+#include "logos_result_cache.h"
+
+using namespace std::chrono_literals;
+using Clock = logos::ResultCache::Clock;
+
+namespace {
+
+// Looks up and, on a miss, stores `value` — the sequence a call makes.
+void fill(logos::ResultCache& cache, const std::string& method, const std::string& args,
+          const nlohmann::json& value, Clock::time_point now,
+          std::chrono::milliseconds ttl = 1000ms)
+{
+    nlohmann::json ignored;
+    std::uint64_t gen = 0;
+    ASSERT_FALSE(cache.lookup(method, args, ignored, &gen, now));
+    cache.store(method, args, value, ttl, gen, now);
+}
+
+}  // namespace
+
+TEST(ResultCache, AnEntryIsServedUntilItsTtlAndNotAfter)
+{
+    logos::ResultCache cache;
+    const Clock::time_point t0 = Clock::now();
+    fill(cache, "getConfig", "[]", {{"mode", "fast"}}, t0);
+
+    nlohmann::json out;
+    ASSERT_TRUE(cache.lookup("getConfig", "[]", out, nullptr, t0 + 999ms));
+    EXPECT_EQ(out["mode"], "fast");
+    EXPECT_FALSE(cache.lookup("getConfig", "[]", out, nullptr, t0 + 1000ms));
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(ResultCache, TheArgumentsArePartOfTheKey)
+{
+    logos::ResultCache cache;
+    const Clock::time_point t0 = Clock::now();
+    fill(cache, "resolve", "[\"a\"]", "1", t0);
+
+    nlohmann::json out;
+    EXPECT_FALSE(cache.lookup("resolve", "[\"b\"]", out, nullptr, t0));
+    // Nor does a method whose name runs into the arguments alias another.
+    EXPECT_FALSE(cache.lookup("resolve[", "\"a\"]", out, nullptr, t0));
+    EXPECT_TRUE(cache.lookup("resolve", "[\"a\"]", out, nullptr, t0));
+}
+
+TEST(ResultCache, TheLeastRecentlyUsedEntryIsEvictedPastCapacity)
+{
+    logos::ResultCache cache(2);
+    const Clock::time_point t0 = Clock::now();
+    fill(cache, "m", "[1]", 1, t0);
+    fill(cache, "m", "[2]", 2, t0);
+
+    nlohmann::json out;
+    ASSERT_TRUE(cache.lookup("m", "[1]", out, nullptr, t0));  // [1] is now the fresher
+    fill(cache, "m", "[3]", 3, t0);
+
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_TRUE(cache.lookup("m", "[1]", out, nullptr, t0));
+    EXPECT_FALSE(cache.lookup("m", "[2]", out, nullptr, t0));
+    EXPECT_TRUE(cache.lookup("m", "[3]", out, nullptr, t0));
+}
+
+TEST(ResultCache, InvalidationDropsOneMethodOrAll)
+{
+    logos::ResultCache cache;
+    const Clock::time_point t0 = Clock::now();
+    fill(cache, "a", "[]", 1, t0);
+    fill(cache, "b", "[]", 2, t0);
+
+    cache.invalidate("a");
+    nlohmann::json out;
+    EXPECT_FALSE(cache.lookup("a", "[]", out, nullptr, t0));
+    EXPECT_TRUE(cache.lookup("b", "[]", out, nullptr, t0));
+
+    cache.invalidate();
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(ResultCache, AReplyThatStartedBeforeAnInvalidationIsNotStored)
+{
+    logos::ResultCache cache;
+    const Clock::time_point t0 = Clock::now();
+    nlohmann::json out;
+    std::uint64_t gen = 0;
+    ASSERT_FALSE(cache.lookup("m", "[]", out, &gen, t0));
+
+    cache.invalidate("m");     // the target announced a change mid-call
+    cache.store("m", "[]", "old", 1000ms, gen, t0);
+    EXPECT_FALSE(cache.lookup("m", "[]", out, nullptr, t0));
+
+    cache.invalidate();        // and the same for a clear-all
+    ASSERT_FALSE(cache.lookup("m", "[]", out, &gen, t0));
+    cache.invalidate();
+    cache.store("m", "[]", "old", 1000ms, gen, t0);
+    EXPECT_EQ(cache.size(), 0u);
+}
@@ -0,0 +1,209 @@
+// logos::ScalarArgs — the generated dispatch's in-place reader for scalar-only
+// methods.
+//
+// The reader is only ever a FIRST attempt: whatever it declines falls through
+// to the nlohmann DOM path and logos::Codec, which is what produces every error
+// reply. So the property that matters is one-directional, and it is what the
+// corpus test below checks input by input: anything the reader ACCEPTS, the DOM
+// path accepts too, with the same value. A reader that declines too much is
+// merely slower; one that accepts too much answers a call the module would have
+// refused.
+
+#include <gtest/gtest.h>
+
+#include <clocale>
+#include <cstdint>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "logos_scalar_args.h"
+
+using logos::ScalarArgs;
+
+namespace {
+
+// What the DOM path would decode slot 0 of `json` to, by the codec's rule for
+// T — or false where it would refuse. Written against nlohmann's own value
+// categories, which is what logos::Codec<T>::from dispatches on.
+bool domInt(const std::string& json, int64_t& out)
+{
+    auto j = nlohmann::json::parse(json, nullptr, false);
+    if (j.is_discarded() || !j.is_array() || j.size() != 1) return false;
+    const auto& v = j[0];
+    if (v.is_number_unsigned()) {
+        if (v.get<uint64_t>() > static_cast<uint64_t>(INT64_MAX)) return false;
+        out = static_cast<int64_t>(v.get<uint64_t>());
+        return true;
+    }
+    if (v.is_number_integer()) { out = v.get<int64_t>(); return true; }
+    return false;
+}
+
+bool domUint(const std::string& json, uint64_t& out)
+{
+    auto j = nlohmann::json::parse(json, nullptr, false);
+    if (j.is_discarded() || !j.is_array() || j.size() != 1) return false;
+    if (!j[0].is_number_unsigned()) return false;
+    out = j[0].get<uint64_t>();
+    return true;
+}
+
+bool domDouble(const std::string& json, double& out)
+{
+    auto j = nlohmann::json::parse(json, nullptr, false);
+    if (j.is_discarded() || !j.is_array() || j.size() != 1) return false;
+    if (!j[0].is_number()) return false;
+    out = j[0].get<double>();
+    return true;
+}
+
+bool domString(const std::string& json, std::string& out)
+{
+    auto j = nlohmann::json::parse(json, nullptr, false);
+    if (j.is_discarded() || !j.is_array() || j.size() != 1) return false;
+    if (!j[0].is_string()) return false;
+    out = j[0].get<std::string>();
+    return true;
+}
+
+template <typename T>
+bool fast(const std::string& json, T& out)
+{
+    ScalarArgs in(json.c_str());
+    return in.read(out) && in.atEnd();
+}
+
+}  // namespace
+
+TEST(ScalarArgs, ReadsEachScalarKindInPlace)
+{
+    ScalarArgs in(" [ -42 , 7, 2.5e1, true, \"h\\u00e9\\n\" ] ");
+    int64_t i = 0;
+    uint64_t u = 0;
+    double d = 0;
+    bool b = false;
+    std::string s;
+    ASSERT_TRUE(in.read(i));
+    ASSERT_TRUE(in.read(u));
+    ASSERT_TRUE(in.read(d));
+    ASSERT_TRUE(in.read(b));
+    ASSERT_TRUE(in.read(s));
+    EXPECT_TRUE(in.atEnd());
+    EXPECT_EQ(i, -42);
+    EXPECT_EQ(u, 7u);
+    EXPECT_EQ(d, 25.0);
+    EXPECT_TRUE(b);
+    EXPECT_EQ(s, "h\xc3\xa9\n");
+}
+
+TEST(ScalarArgs, NullOrEmptyInputIsAnEmptyArgumentList)
+{
+    // The dispatch has always read a NULL or empty args_json as `[]`.
+    EXPECT_TRUE(ScalarArgs(nullptr).atEnd());
+    EXPECT_TRUE(ScalarArgs("").atEnd());
+    EXPECT_TRUE(ScalarArgs(" [ ] ").atEnd());
+    int64_t v = 0;
+    EXPECT_FALSE(ScalarArgs(nullptr).read(v));
+}
+
+// Arity is the DOM path's to report, with the count in the message, so the
+// reader declines both too few and too many.
+TEST(ScalarArgs, DeclinesAnythingButTheExactArity)
+{
+    int64_t a = 0, b = 0;
+    {
+        ScalarArgs in("[1]");
+        EXPECT_TRUE(in.read(a));
+        EXPECT_FALSE(in.read(b));
+        EXPECT_FALSE(in.atEnd());
+    }
+    {
+        ScalarArgs in("[1, 2, 3]");
+        EXPECT_TRUE(in.read(a));
+        EXPECT_TRUE(in.read(b));
+        EXPECT_FALSE(in.atEnd());
+    }
+}
+
+TEST(ScalarArgs, AFailedReadStaysFailed)
+{
+    ScalarArgs in("[\"x\", 1]");
+    int64_t v = 0;
+    EXPECT_FALSE(in.read(v));
+    EXPECT_FALSE(in.read(v));   // never resynchronises onto a later slot
+    EXPECT_FALSE(in.atEnd());
+}
+
+// The codec's strictness, slot by slot: a value the DOM path would refuse is
+// declined here, so the refusal — and its message — still comes from there.
+TEST(ScalarArgs, DeclinesWhatTheCodecRejects)
+{
+    int64_t i = 0;
+    uint64_t u = 0;
+    bool b = false;
+    std::string s;
+    EXPECT_FALSE(fast("[3.7]", i));                    // truncation
+    EXPECT_FALSE(fast("[3.0]", i));                    // a float to the DOM too
+    EXPECT_FALSE(fast("[1e2]", i));
+    EXPECT_FALSE(fast("[9223372036854775808]", i));    // INT64_MAX + 1
+    EXPECT_FALSE(fast("[-1]", u));                     // the silent sign flip
+    EXPECT_FALSE(fast("[18446744073709551616]", u));   // UINT64_MAX + 1
+    EXPECT_FALSE(fast("[1]", b));
+    EXPECT_FALSE(fast("[null]", b));
+    EXPECT_FALSE(fast("[5]", s));
+    EXPECT_FALSE(fast("[null]", s));
+    EXPECT_FALSE(fast("[[1]]", i));
+}
+
+TEST(ScalarArgs, DeclinesMalformedJson)
+{
+    int64_t i = 0;
+    std::string s;
+    for (const char* bad : { "[01]", "[+1]", "[1.]", "[.5]", "[1,]", "[1", "1",
+                             "[1] x", "{}", "[1e]", "[-]" })
+        EXPECT_FALSE(fast(bad, i)) << bad;
+    for (const char* bad : { "[\"a\\ud800\"]", "[\"a\\udc00\"]", "[\"a\\q\"]",
+                             "[\"\x01\"]", "[\"\xc0\xaf\"]", "[\"\xed\xa0\x80\"]",
+                             "[\"\xf4\x90\x80\x80\"]", "[\"abc" })
+        EXPECT_FALSE(fast(bad, s)) << bad;
+}
+
+TEST(ScalarArgs, ExtremesDecodeExactly)
+{
+    int64_t i = 0;
+    uint64_t u = 0;
+    EXPECT_TRUE(fast("[-9223372036854775808]", i));
+    EXPECT_EQ(i, INT64_MIN);
+    EXPECT_TRUE(fast("[9223372036854775807]", i));
+    EXPECT_EQ(i, INT64_MAX);
+    EXPECT_TRUE(fast("[18446744073709551615]", u));
+    EXPECT_EQ(u, UINT64_MAX);
+    std::string s;
+    EXPECT_TRUE(fast("[\"\\ud83d\\ude00\\u0000x\"]", s));
+    EXPECT_EQ(s, std::string("\xf0\x9f\x98\x80\0x", 6));
+}
+
+// The one-directional property, over a corpus: every input the reader accepts
+// decodes, through the DOM path, to the identical value.
+TEST(ScalarArgs, AcceptsOnlyWhatTheDomPathAcceptsWithTheSameValue)
+{
+    const char* corpus[] = {
+        "[0]", "[-0]", "[1]", "[-1]", "[42]", "[ 7 ]", "[3.5]", "[-2.25e-3]",
+        "[1E10]", "[1e400]", "[9223372036854775807]", "[9223372036854775808]",
+        "[-9223372036854775809]", "[18446744073709551615]", "[18446744073709551616]",
+        "[true]", "[false]", "[null]", "[\"\"]", "[\"a\\\"b\"]", "[\"\\/\\b\\f\\r\\t\"]",
+        "[\"\xe2\x82\xac\"]", "[\"\\u20AC\"]", "[\"\\uD83D\\uDE00\"]", "[\"\xff\"]",
+        "[1,2]", "[]", "[[]]", "[{}]", "[\"x\"] ", "\t[\r\n1\n]\n",
+    };
+    for (const char* c : corpus) {
+        int64_t fi = 0, di = 0;
+        if (fast(c, fi)) { ASSERT_TRUE(domInt(c, di)) << c; EXPECT_EQ(fi, di) << c; }
+        uint64_t fu = 0, du = 0;
+        if (fast(c, fu)) { ASSERT_TRUE(domUint(c, du)) << c; EXPECT_EQ(fu, du) << c; }
+        double fd = 0, dd = 0;
+        if (fast(c, fd)) { ASSERT_TRUE(domDouble(c, dd)) << c; EXPECT_EQ(fd, dd) << c; }
+        std::string fs, ds;
+        if (fast(c, fs)) { ASSERT_TRUE(domString(c, ds)) << c; EXPECT_EQ(fs, ds) << c; }
+    }
+}
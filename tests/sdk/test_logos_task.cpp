@@ -0,0 +1,245 @@
+// logos::Task<T> and LpClient::invokeCo — the C++20 surface the generated
+// `<name>Co` wrappers are built on.
+//
+// Built as its own C++20 executable (see the CMakeLists): the rest of
+// sdk_tests is C++17, where logos_task.h compiles to LOGOS_HAS_COROUTINES == 0
+// and nothing else. If this target ever loses C++20, the #else branch at the
+// bottom fails it rather than letting it pass empty.
+//
+// As in test_lp_client.cpp, the lp_* symbols are LOCAL STUBS. lp_invoke_async
+// either answers inline, refuses synchronously, or holds the call for the test
+// to answer later — the three orders in which a reply can meet the awaiting
+// coroutine.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "logos_lp_client.h"
+
+#if LOGOS_HAS_COROUTINES
+
+namespace {
+
+enum class AsyncStub {
+    Inline,      // calls back before lp_invoke_async returns
+    RefuseSync,  // returns LP_ERR_INVALID_ARG and does NOT call back
+    Hold,        // accepts the call and answers later, from g_held
+};
+AsyncStub g_asyncStub = AsyncStub::Inline;
+
+struct HeldCall {
+    std::string args;
+    lp_result_cb cb;
+    void* ud;
+};
+std::vector<HeldCall> g_held;
+
+void resetStubs()
+{
+    g_asyncStub = AsyncStub::Inline;
+    g_held.clear();
+}
+
+// A coroutine that doubles the reply of `twice`, to drive invokeCo the way a
+// generated `<name>Co` does.
+logos::Task<logos::AsyncResult<int64_t>> doubled(logos::LpClient& client, int64_t x)
+{
+    const nlohmann::json args = nlohmann::json::array({x});
+    logos::AsyncResult<nlohmann::json> r = co_await client.invokeCo("twice", args);
+    logos::AsyncResult<int64_t> out;
+    out.error = r.error;
+    if (r.ok()) out.value = r.value.get<int64_t>() * 2;
+    co_return out;
+}
+
+}  // namespace
+
+extern "C" {
+
+lp_client* lp_client_create(const char*, const char*, const char*, const char*)
+{
+    return reinterpret_cast<lp_client*>(new std::uintptr_t(0xC0FFEEu));
+}
+
+void lp_client_destroy(lp_client* client)
+{
+    delete reinterpret_cast<std::uintptr_t*>(client);
+}
+
+// The reply is the first argument, echoed, so `twice(x)` answers x.
+int lp_invoke_async(lp_client*, const char*, const char* args_json, int,
+                    lp_result_cb cb, void* user_data)
+{
+    switch (g_asyncStub) {
+    case AsyncStub::Inline: {
+        const auto args = nlohmann::json::parse(args_json);
+        cb(1, args.at(0).dump().c_str(), user_data);
+        return LP_OK;
+    }
+    case AsyncStub::RefuseSync:
+        return LP_ERR_INVALID_ARG;
+    case AsyncStub::Hold:
+        g_held.push_back({args_json, cb, user_data});
+        return LP_OK;
+    }
+    return LP_OK;
+}
+
+// Only the result cache subscribes, and nothing here emits an event.
+lp_subscription* lp_subscribe(lp_client*, const char*, lp_event_cb, void*)
+{
+    return reinterpret_cast<lp_subscription*>(new int(0));
+}
+
+void lp_unsubscribe(lp_subscription* sub)
+{
+    delete reinterpret_cast<int*>(sub);
+}
+
+}  // extern "C"
+
+TEST(Task, AReplyThatLandsInlineResumesWithoutSuspending)
+{
+    resetStubs();
+    logos::LpClient client("dep", "me");
+    auto t = doubled(client, 21);
+    ASSERT_TRUE(t.ready());
+    std::optional<logos::AsyncResult<int64_t>> got;
+    [](logos::Task<logos::AsyncResult<int64_t>>& task,
+       std::optional<logos::AsyncResult<int64_t>>& out) -> logos::Task<void> {
+        out = co_await task;
+    }(t, got);
+    ASSERT_TRUE(got.has_value());
+    EXPECT_TRUE(got->ok());
+    EXPECT_EQ(got->value, 42);
+}
+
+TEST(Task, EveryCallIsInFlightBeforeTheFirstIsAwaited)
+{
+    // Eager: each `doubled` has issued its call by the time it returns, so a
+    // loop of them fans out rather than running one after another.
+    resetStubs();
+    g_asyncStub = AsyncStub::Hold;
+    logos::LpClient client("dep", "me");
+    std::vector<logos::Task<logos::AsyncResult<int64_t>>> calls;
+    for (int64_t i = 1; i <= 3; ++i) calls.push_back(doubled(client, i));
+    ASSERT_EQ(g_held.size(), 3u);
+
+    int64_t total = -1;
+    [](std::vector<logos::Task<logos::AsyncResult<int64_t>>>& tasks, int64_t& out) -> logos::Task<void> {
+        int64_t sum = 0;
+        for (auto& t : tasks) sum += (co_await t).value;
+        out = sum;
+    }(calls, total);
+    EXPECT_EQ(total, -1);
+
+    // Answered out of order: the awaiting coroutine picks each one up when its
+    // turn comes, whether it is already there or not.
+    for (int i : {2, 0, 1}) {
+        const auto args = nlohmann::json::parse(g_held[i].args);
+        g_held[i].cb(1, args.at(0).dump().c_str(), g_held[i].ud);
+    }
+    EXPECT_EQ(total, (1 + 2 + 3) * 2);
+}
+
+TEST(Task, ASynchronousRefusalCompletesWithCallFailed)
+{
+    resetStubs();
+    g_asyncStub = AsyncStub::RefuseSync;
+    logos::LpClient client("dep", "me");
+    auto t = doubled(client, 1);
+    ASSERT_TRUE(t.ready());
+    std::string code;
+    [](logos::Task<logos::AsyncResult<int64_t>>& task, std::string& out) -> logos::Task<void> {
+        out = (co_await task).error.code;
+    }(t, code);
+    EXPECT_EQ(code, "call_failed");
+}
+
+TEST(Task, ADroppedTaskStillRunsToTheEnd)
+{
+    resetStubs();
+    g_asyncStub = AsyncStub::Hold;
+    logos::LpClient client("dep", "me");
+    bool finished = false;
+    [](logos::LpClient& c, bool& done) -> logos::Task<void> {
+        const nlohmann::json args = nlohmann::json::array({1});
+        co_await c.invokeCo("twice", args);
+        done = true;
+    }(client, finished);
+    ASSERT_EQ(g_held.size(), 1u);
+    EXPECT_FALSE(finished);
+    g_held[0].cb(1, "1", g_held[0].ud);
+    EXPECT_TRUE(finished);
+}
+
+TEST(Task, ACachedReplyCompletesWithoutACall)
+{
+    resetStubs();
+    logos::LpClient client("dep", "me");
+    client.cacheMethod("twice", 60000, {"changed"});
+    EXPECT_EQ(doubled(client, 21).ready(), true);
+
+    g_asyncStub = AsyncStub::Hold;  // a call that reached the transport would hang
+    auto t = doubled(client, 21);
+    EXPECT_TRUE(g_held.empty());
+    ASSERT_TRUE(t.ready());
+    int64_t got = 0;
+    [](logos::Task<logos::AsyncResult<int64_t>>& task, int64_t& out) -> logos::Task<void> {
+        out = (co_await task).value;
+    }(t, got);
+    EXPECT_EQ(got, 42);
+}
+
+TEST(Task, AnIdenticalCallInFlightIsJoinedRatherThanIssued)
+{
+    resetStubs();
+    g_asyncStub = AsyncStub::Hold;
+    logos::LpClient client("dep", "me");
+    client.singleFlight("twice");
+    auto first = doubled(client, 5);
+    auto second = doubled(client, 5);
+    ASSERT_EQ(g_held.size(), 1u);
+    EXPECT_FALSE(second.ready());
+
+    g_held[0].cb(1, "5", g_held[0].ud);
+    ASSERT_TRUE(first.ready());
+    ASSERT_TRUE(second.ready());
+    int64_t got = 0;
+    [](logos::Task<logos::AsyncResult<int64_t>>& task, int64_t& out) -> logos::Task<void> {
+        out = (co_await task).value;
+    }(second, got);
+    EXPECT_EQ(got, 10);
+}
+
+TEST(Task, AnExceptionReachesTheAwaiter)
+{
+    resetStubs();
+    auto failing = []() -> logos::Task<int> {
+        throw std::runtime_error("boom");
+        co_return 0;
+    };
+    std::string what;
+    [](logos::Task<int> task, std::string& out) -> logos::Task<void> {
+        try {
+            co_await task;
+        } catch (const std::runtime_error& e) {
+            out = e.what();
+        }
+    }(failing(), what);
+    EXPECT_EQ(what, "boom");
+}
+
+#else
+
+TEST(Task, ThisBuildHasCoroutines)
+{
+    FAIL() << "sdk_coroutine_tests must be built as C++20";
+}
+
+#endif  // LOGOS_HAS_COROUTINES
@@ -23,13 +23,22 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <ctime>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <set>
+#include <string>
 #include <thread>
+#include <tuple>
 #include <vector>
 
 #include "logos_lp_client.h"
@@ -48,6 +57,8 @@ std::atomic<bool> g_slowCreate{false};
 
 std::mutex g_seenMutex;
 std::vector<lp_client*> g_seen;   // the client each getMethods() call observed
+std::set<lp_client*> g_live;      // created and not yet destroyed, under g_seenMutex
+std::atomic<int> g_invokedOnDead{0};  // async calls issued on a destroyed client
 std::atomic<int> g_stringsFreed{0};
 
 // How the next lp_invoke_async should behave. Named for the C ABI outcome each
@@ -56,17 +67,68 @@ enum class AsyncStub {
     Success,        // ok != 0, `json` is the result value
     FailWithError,  // ok == 0, `json` is the canonical {code, message, origin}
     FailMalformed,  // ok == 0, `json` is not a usable error object
+    Reject,         // ok != 0, `json` is a provider's rejection object
     RefuseSync,     // returns LP_ERR_INVALID_ARG and does NOT call back
+    Hold,           // accepts the call and answers later, from g_held
 };
 AsyncStub g_asyncStub = AsyncStub::Success;
 
+// Calls accepted under AsyncStub::Hold, answered by the test in whatever order
+// it likes. The result is the method name, so a reply shows which call it
+// belongs to.
+struct HeldCall {
+    std::string method;
+    lp_result_cb cb;
+    void* ud;
+    void answer() const { cb(1, ("\"" + method + "\"").c_str(), ud); }
+    void fail() const { cb(0, "{\"code\":\"timeout\",\"message\":\"late\",\"origin\":\"target\"}", ud); }
+};
+std::vector<HeldCall> g_held;
+std::atomic<int> g_asyncCalls{0};  // lp_invoke_async calls that reached the stub
+
+// lp_invoke answers with the method name, once the gate is open.
+std::atomic<int> g_syncCalls{0};
+std::string g_lastArgs;  // the argument text of the latest call, sync or async
+int g_lastAsyncTimeout = 0;  // the timeout_ms the latest async call was issued with
+std::mutex g_gateMutex;
+std::condition_variable g_gateCv;
+bool g_gateOpen = true;
+
+void setGate(bool open) {
+    {
+        std::lock_guard<std::mutex> lock(g_gateMutex);
+        g_gateOpen = open;
+    }
+    g_gateCv.notify_all();
+}
+
+// Live lp_subscribe registrations, so a test can emit an event of the target.
+struct StubSubscription {
+    std::string event;
+    lp_event_cb cb;
+    void* ud;
+};
+std::vector<StubSubscription*> g_subs;
+
+void emitEvent(const std::string& event, const char* payload = "[]") {
+    for (StubSubscription* sub : std::vector<StubSubscription*>(g_subs))
+        if (sub->event == event) sub->cb(event.c_str(), payload, sub->ud);
+}
+
 void resetStubs() {
     g_created = 0;
     g_destroyed = 0;
     g_failNext = 0;
     g_slowCreate = false;
     g_asyncStub = AsyncStub::Success;
+    g_held.clear();
+    g_asyncCalls = 0;
+    g_syncCalls = 0;
+    g_lastArgs.clear();
+    g_lastAsyncTimeout = 0;
+    setGate(true);
     g_stringsFreed = 0;
+    g_invokedOnDead = 0;
     std::lock_guard<std::mutex> lock(g_seenMutex);
     g_seen.clear();
 }
@@ -80,11 +142,18 @@ lp_client* lp_client_create(const char*, const char*, const char*, const char*)
     g_created.fetch_add(1, std::memory_order_relaxed);
     if (g_slowCreate.load()) std::this_thread::sleep_for(std::chrono::milliseconds(5));
     // lp_client is opaque; any distinct heap address stands in for one.
-    return reinterpret_cast<lp_client*>(new std::uintptr_t(0xC0FFEEu));
+    auto* client = reinterpret_cast<lp_client*>(new std::uintptr_t(0xC0FFEEu));
+    std::lock_guard<std::mutex> lock(g_seenMutex);
+    g_live.insert(client);
+    return client;
 }
 
 void lp_client_destroy(lp_client* client) {
     g_destroyed.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(g_seenMutex);
+        g_live.erase(client);
+    }
     delete reinterpret_cast<std::uintptr_t*>(client);
 }
 
@@ -112,7 +181,15 @@ void lp_string_free(char* s) {
     std::free(s);
 }
 
-int lp_invoke_async(lp_client*, const char*, const char*, int, lp_result_cb cb, void* ud) {
+int lp_invoke_async(lp_client* client, const char* method, const char* args, int timeout_ms,
+                    lp_result_cb cb, void* ud) {
+    g_asyncCalls.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(g_seenMutex);
+        if (!g_live.count(client)) g_invokedOnDead.fetch_add(1);
+    }
+    g_lastArgs = args;
+    g_lastAsyncTimeout = timeout_ms;
     switch (g_asyncStub) {
     case AsyncStub::Success:
         cb(1, "\"hi\"", ud);
@@ -123,14 +200,47 @@ int lp_invoke_async(lp_client*, const char*, const char*, int, lp_result_cb cb,
     case AsyncStub::FailMalformed:
         cb(0, "not json at all", ud);
         return LP_OK;
+    case AsyncStub::Reject:
+        cb(1, "{\"code\":\"invalid_args\",\"message\":\"no\",\"origin\":\"target\"}", ud);
+        return LP_OK;
     case AsyncStub::RefuseSync:
         // The ABI's rule: a synchronous argument/handle rejection does NOT
         // call back.
         return LP_ERR_INVALID_ARG;
+    case AsyncStub::Hold:
+        g_held.push_back({method, cb, ud});
+        return LP_OK;
+    }
+    return LP_OK;
+}
+
+int lp_invoke(lp_client*, const char* method, const char* args, int, char** out, char** err) {
+    g_syncCalls.fetch_add(1, std::memory_order_relaxed);
+    {
+        // Under the gate's lock: blocking calls can be in here at once.
+        std::unique_lock<std::mutex> lock(g_gateMutex);
+        g_lastArgs = args;
+        g_gateCv.wait(lock, [] { return g_gateOpen; });
     }
+    const std::string reply = "\"" + std::string(method) + "\"";
+    *out = static_cast<char*>(std::malloc(reply.size() + 1));
+    std::memcpy(*out, reply.c_str(), reply.size() + 1);
+    *err = nullptr;
     return LP_OK;
 }
 
+lp_subscription* lp_subscribe(lp_client*, const char* event, lp_event_cb cb, void* ud) {
+    auto* sub = new StubSubscription{event, cb, ud};
+    g_subs.push_back(sub);
+    return reinterpret_cast<lp_subscription*>(sub);
+}
+
+void lp_unsubscribe(lp_subscription* handle) {
+    auto* sub = reinterpret_cast<StubSubscription*>(handle);
+    g_subs.erase(std::find(g_subs.begin(), g_subs.end(), sub));
+    delete sub;
+}
+
 }  // extern "C"
 
 class LpClientEnsureTest : public ::testing::Test {
@@ -219,6 +329,40 @@ TEST_F(LpClientEnsureTest, AFailedCreateIsRetriedRatherThanLatched) {
     EXPECT_NE(soleSeenClient(), nullptr);
 }
 
+// One transport client per (target, origin), however many LpClients ask for
+// it: a second wrapper instance must not cost a second connection and
+// handshake. It lives until the last of them is gone.
+TEST_F(LpClientEnsureTest, ClientsForOneTargetAndOriginShareOneTransportClient) {
+    const std::size_t before = logos::LpClientRegistry::instance().size();
+    auto first = std::make_unique<logos::LpClient>("target", "origin");
+    auto second = std::make_unique<logos::LpClient>("target", "origin");
+    logos::LpClient otherOrigin("target", "elsewhere");
+    logos::LpClient otherTarget("other", "origin");
+    first->getMethods();
+    second->getMethods();
+    otherOrigin.getMethods();
+    otherTarget.getMethods();
+    EXPECT_EQ(g_created.load(), 3);
+    EXPECT_EQ(logos::LpClientRegistry::instance().size(), before + 3);
+    {
+        std::lock_guard<std::mutex> lock(g_seenMutex);
+        ASSERT_EQ(g_seen.size(), 4u);
+        EXPECT_EQ(g_seen[0], g_seen[1]);
+        EXPECT_NE(g_seen[0], g_seen[2]);
+        EXPECT_NE(g_seen[0], g_seen[3]);
+    }
+
+    first.reset();
+    EXPECT_EQ(g_destroyed.load(), 0) << "the second holder still uses it";
+    second.reset();
+    EXPECT_EQ(g_destroyed.load(), 1);
+
+    // Gone with its last holder, so the next one builds afresh.
+    logos::LpClient again("target", "origin");
+    again.getMethods();
+    EXPECT_EQ(g_created.load(), 4);
+}
+
 // ─── invokeAsyncResult: the error-carrying async ────────────────────────────
 //
 // The generated `<name>AsyncResult` wrappers are built on this, so what it
@@ -324,3 +468,940 @@ TEST_F(LpClientAsyncResultTest, ANullCallbackIsANoOpRatherThanACall) {
     client.invokeAsyncResult("m", nlohmann::json::array(), nullptr);
     EXPECT_EQ(g_created.load(), 0) << "a callback-less call must not even build a client";
 }
+
+// ─── Completion slots: no allocation per call ───────────────────────────────
+//
+// Both async entry points hand their callback to a pooled, fixed-size slot
+// rather than a `new std::function` box. These pin that a big callback still
+// works, and that a synchronous refusal releases its slot by completing it.
+// That a warm pool issues a small one without allocating is counted in
+// test_lp_client_allocs.cpp, its own executable.
+
+class LpClientCompletionSlotTest : public LpClientEnsureTest {};
+
+TEST_F(LpClientCompletionSlotTest, ACallbackTooBigForTheSlotIsBoxedAndStillRuns) {
+    logos::LpClient client("target", "origin");
+    std::array<char, 256> big{};
+    big[255] = 'x';
+    char seen = 0;
+    client.invokeAsync("m", nlohmann::json::array(), [big, &seen](nlohmann::json r) {
+        EXPECT_EQ(r, nlohmann::json("hi"));
+        seen = big[255];
+    });
+    EXPECT_EQ(seen, 'x');
+}
+
+TEST_F(LpClientCompletionSlotTest, ARefusedPlainAsyncCallCompletesWithNull) {
+    // invokeAsync promised "fires exactly once ... null on failure" but left a
+    // refused call's box behind uncalled. The refusal now completes the slot.
+    logos::LpClient client("target", "origin");
+    g_asyncStub = AsyncStub::RefuseSync;
+    int calls = 0;
+    nlohmann::json got = "sentinel";
+    client.invokeAsync("m", nlohmann::json::array(), [&](nlohmann::json r) { ++calls; got = std::move(r); });
+    EXPECT_EQ(calls, 1);
+    EXPECT_TRUE(got.is_null());
+}
+
+// ─── invokeBatch: many calls, one round trip ────────────────────────────────
+//
+// Every call is handed to the transport before any reply is waited for, each
+// call hears its own reply as it lands, and `done` sees every outcome in the
+// order the calls were made — not the order they were answered.
+
+class LpClientBatchTest : public LpClientEnsureTest {};
+
+TEST_F(LpClientBatchTest, EveryCallIsInFlightBeforeTheFirstReply) {
+    logos::LpClient client("target", "origin");
+    g_asyncStub = AsyncStub::Hold;
+
+    std::vector<std::string> heard;
+    std::vector<logos::AsyncResult<nlohmann::json>> results;
+    int doneCalls = 0;
+    std::vector<logos::LpCall> calls;
+    for (const char* m : {"a", "b", "c"}) {
+        logos::LpCall call;
+        call.method = m;
+        call.onResult = [&heard](nlohmann::json r, const logos::CallError& e) {
+            EXPECT_TRUE(e.ok());
+            heard.push_back(r.get<std::string>());
+        };
+        calls.push_back(std::move(call));
+    }
+    client.invokeBatch(std::move(calls), [&](std::vector<logos::AsyncResult<nlohmann::json>> r) {
+        ++doneCalls;
+        results = std::move(r);
+    });
+
+    ASSERT_EQ(g_held.size(), 3u) << "a batch must not wait for one reply before sending the next call";
+    EXPECT_EQ(g_created.load(), 1);
+
+    // Answered back to front.
+    for (auto it = g_held.rbegin(); it != g_held.rend(); ++it) {
+        EXPECT_EQ(doneCalls, 0);
+        it->answer();
+    }
+    EXPECT_EQ(heard, (std::vector<std::string>{"c", "b", "a"}));
+    ASSERT_EQ(doneCalls, 1);
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_EQ(results[0].value, nlohmann::json("a"));
+    EXPECT_EQ(results[1].value, nlohmann::json("b"));
+    EXPECT_EQ(results[2].value, nlohmann::json("c"));
+}
+
+TEST_F(LpClientBatchTest, ARefusedCallStillCompletesTheBatch) {
+    logos::LpClient client("target", "origin");
+    g_asyncStub = AsyncStub::RefuseSync;
+
+    std::vector<logos::AsyncResult<nlohmann::json>> results;
+    client.invokeBatch({{"a", nlohmann::json::array(), nullptr}, {"b", nlohmann::json::array(), nullptr}},
+                       [&](std::vector<logos::AsyncResult<nlohmann::json>> r) { results = std::move(r); });
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].error.code, "call_failed");
+    EXPECT_EQ(results[1].error.code, "call_failed");
+}
+
+// What the generated Batch builder queues: the arguments already written as
+// text, sent as they are.
+TEST_F(LpClientBatchTest, ACallWithArgumentTextSendsThatText) {
+    logos::LpClient client("target", "origin");
+    g_asyncStub = AsyncStub::Hold;
+
+    logos::ArgsWriter args;
+    args.value(7).value("x");
+    logos::LpCall call;
+    call.method = "a";
+    call.argsText = args.take();
+    client.invokeBatch({std::move(call)}, nullptr);
+    ASSERT_EQ(g_held.size(), 1u);
+    EXPECT_EQ(g_lastArgs, "[7,\"x\"]");
+
+    client.invokeBatch({{"b", nlohmann::json::array({1, 2}), nullptr}}, nullptr);
+    EXPECT_EQ(g_lastArgs, "[1,2]");
+    for (const HeldCall& held : g_held) held.answer();
+}
+
+TEST_F(LpClientBatchTest, AnEmptyBatchCompletesWithoutAClient) {
+    logos::LpClient client("target", "origin");
+    int doneCalls = 0;
+    client.invokeBatch({}, [&](std::vector<logos::AsyncResult<nlohmann::json>> r) {
+        ++doneCalls;
+        EXPECT_TRUE(r.empty());
+    });
+    EXPECT_EQ(doneCalls, 1);
+    EXPECT_EQ(g_created.load(), 0);
+}
+
+// ─── Result cache: repeat reads answered locally ────────────────────────────
+
+class LpClientCacheTest : public LpClientEnsureTest {
+protected:
+    // One invokeAsyncResult, returning what it delivered.
+    static logos::AsyncResult<nlohmann::json> call(logos::LpClient& client, int arg) {
+        logos::AsyncResult<nlohmann::json> out;
+        client.invokeAsyncResult("get", nlohmann::json::array({arg}),
+            [&out](nlohmann::json r, const logos::CallError& e) { out.value = std::move(r); out.error = e; });
+        return out;
+    }
+};
+
+TEST_F(LpClientCacheTest, ARepeatReadIsAnsweredWithoutTheTransport) {
+    logos::LpClient client("target", "origin");
+    client.cacheMethod("get", 60000);
+
+    EXPECT_EQ(call(client, 1).value, nlohmann::json("hi"));
+    const auto again = call(client, 1);
+    EXPECT_TRUE(again.ok());
+    EXPECT_EQ(again.value, nlohmann::json("hi"));
+    EXPECT_EQ(g_asyncCalls.load(), 1);
+
+    call(client, 2);  // other arguments, another question
+    EXPECT_EQ(g_asyncCalls.load(), 2);
+
+    // An uncached method on the same client is untouched.
+    client.invokeAsync("other", nlohmann::json::array(), [](nlohmann::json) {});
+    client.invokeAsync("other", nlohmann::json::array(), [](nlohmann::json) {});
+    EXPECT_EQ(g_asyncCalls.load(), 4);
+}
+
+TEST_F(LpClientCacheTest, FailuresAndRejectionsAreNeverRemembered) {
+    logos::LpClient client("target", "origin");
+    client.cacheMethod("get", 60000);
+
+    g_asyncStub = AsyncStub::FailWithError;
+    call(client, 1);
+    call(client, 1);
+    g_asyncStub = AsyncStub::Reject;
+    call(client, 1);
+    call(client, 1);
+    EXPECT_EQ(g_asyncCalls.load(), 4);
+}
+
+TEST_F(LpClientCacheTest, AnInvalidatingEventFromTheTargetDropsTheEntry) {
+    logos::LpClient client("target", "origin");
+    client.cacheMethod("get", 60000, {"changed"});
+
+    call(client, 1);
+    ASSERT_EQ(g_subs.size(), 1u) << "the invalidating event is subscribed on the first miss";
+    call(client, 1);
+    EXPECT_EQ(g_asyncCalls.load(), 1);
+
+    emitEvent("unrelated");
+    call(client, 1);
+    EXPECT_EQ(g_asyncCalls.load(), 1);
+
+    emitEvent("changed");
+    call(client, 1);
+    EXPECT_EQ(g_asyncCalls.load(), 2);
+    EXPECT_EQ(g_subs.size(), 1u) << "subscribed once, not per miss";
+}
+
+TEST_F(LpClientCacheTest, AReplyInFlightAcrossAnInvalidationIsNotStored) {
+    logos::LpClient client("target", "origin");
+    client.cacheMethod("get", 60000);
+
+    g_asyncStub = AsyncStub::Hold;
+    client.invokeAsyncResult("get", nlohmann::json::array({1}),
+                             [](nlohmann::json, const logos::CallError&) {});
+    ASSERT_EQ(g_held.size(), 1u);
+    client.invalidateCache("get");
+    g_held[0].answer();
+
+    g_asyncStub = AsyncStub::Success;
+    call(client, 1);
+    EXPECT_EQ(g_asyncCalls.load(), 2);
+}
+
+TEST_F(LpClientCacheTest, TheInvalidationSubscriptionsEndWithTheClient) {
+    {
+        logos::LpClient client("target", "origin");
+        client.cacheMethod("get", 60000, {"changed"});
+        call(client, 1);
+        EXPECT_EQ(g_subs.size(), 1u);
+    }
+    EXPECT_TRUE(g_subs.empty());
+    EXPECT_EQ(g_destroyed.load(), 1);
+}
+
+// ─── Single-flight: identical calls in flight share one request ─────────────
+
+class LpClientSingleFlightTest : public LpClientEnsureTest {};
+
+TEST_F(LpClientSingleFlightTest, IdenticalAsyncCallsShareOneRequest) {
+    logos::LpClient client("target", "origin");
+    client.singleFlight("get");
+    g_asyncStub = AsyncStub::Hold;
+
+    std::vector<std::string> heard;
+    auto ask = [&](int arg) {
+        client.invokeAsyncResult("get", nlohmann::json::array({arg}),
+            [&heard](nlohmann::json r, const logos::CallError& e) {
+                EXPECT_TRUE(e.ok());
+                heard.push_back(r.get<std::string>());
+            });
+    };
+    ask(1);
+    ask(1);
+    client.invokeAsync("get", nlohmann::json::array({1}),
+                       [&heard](nlohmann::json r) { heard.push_back("plain:" + r.get<std::string>()); });
+    ask(2);  // other arguments, its own request
+    ASSERT_EQ(g_held.size(), 2u);
+
+    g_held[0].answer();
+    std::sort(heard.begin(), heard.end());  // joiners hear before the leader
+    EXPECT_EQ(heard, (std::vector<std::string>{"get", "get", "plain:get"}));
+
+    // Landed, so the flight is over: the next identical call goes out again.
+    ask(1);
+    EXPECT_EQ(g_held.size(), 3u);
+    g_held[1].answer();
+    g_held[2].answer();
+    EXPECT_EQ(heard.size(), 5u);
+}
+
+TEST_F(LpClientSingleFlightTest, AFailureReachesEveryJoiner) {
+    logos::LpClient client("target", "origin");
+    client.singleFlight();  // every method
+    g_asyncStub = AsyncStub::Hold;
+
+    std::vector<std::string> codes;
+    for (int i = 0; i < 3; ++i)
+        client.invokeAsyncResult("any", nlohmann::json::array(),
+            [&codes](nlohmann::json, const logos::CallError& e) { codes.push_back(e.code); });
+    ASSERT_EQ(g_held.size(), 1u);
+    g_held[0].fail();
+    EXPECT_EQ(codes, (std::vector<std::string>(3, "timeout")));
+}
+
+TEST_F(LpClientSingleFlightTest, ARefusedLeaderStillReleasesItsFlight) {
+    logos::LpClient client("target", "origin");
+    client.singleFlight("get");
+    g_asyncStub = AsyncStub::RefuseSync;
+    std::string code;
+    client.invokeAsyncResult("get", nlohmann::json::array(),
+        [&code](nlohmann::json, const logos::CallError& e) { code = e.code; });
+    EXPECT_EQ(code, "call_failed");
+
+    g_asyncStub = AsyncStub::Success;
+    nlohmann::json got;
+    client.invokeAsync("get", nlohmann::json::array(), [&got](nlohmann::json r) { got = std::move(r); });
+    EXPECT_EQ(got, nlohmann::json("hi"));
+}
+
+// A blocking call never waits on someone else's request: it could not keep
+// its own timeout, and could be the thread that request needs to land. It
+// goes alone while a flight is out, and leads one that async callers join
+// when none is.
+TEST_F(LpClientSingleFlightTest, ABlockingCallNeverJoinsButMayLead) {
+    logos::LpClient client("target", "origin");
+    client.singleFlight("get");
+    setGate(false);
+
+    nlohmann::json leaderGot, secondGot;
+    std::thread leader([&] { leaderGot = client.invoke("get", nlohmann::json::array(), nullptr); });
+    while (g_syncCalls.load() == 0) std::this_thread::yield();
+    std::thread second([&] {
+        logos::CallError err;
+        secondGot = client.invoke("get", nlohmann::json::array(), &err);
+        EXPECT_TRUE(err.ok());
+    });
+    while (g_syncCalls.load() < 2) std::this_thread::yield();
+
+    // An async caller joins the blocking leader's flight.
+    nlohmann::json asyncGot;
+    client.invokeAsync("get", nlohmann::json::array(), [&asyncGot](nlohmann::json r) { asyncGot = std::move(r); });
+    EXPECT_EQ(g_asyncCalls.load(), 0);
+
+    setGate(true);
+    leader.join();
+    second.join();
+    EXPECT_EQ(g_syncCalls.load(), 2);
+    EXPECT_EQ(leaderGot, nlohmann::json("get"));
+    EXPECT_EQ(secondGot, nlohmann::json("get"));
+    EXPECT_EQ(asyncGot, nlohmann::json("get"));
+}
+
+TEST_F(LpClientSingleFlightTest, WithTheCacheAColdStampedeCostsOneRequest) {
+    logos::LpClient client("target", "origin");
+    client.cacheMethod("get", 60000);
+    client.singleFlight("get");
+    g_asyncStub = AsyncStub::Hold;
+
+    int answered = 0;
+    for (int i = 0; i < 4; ++i)
+        client.invokeAsync("get", nlohmann::json::array(), [&answered](nlohmann::json) { ++answered; });
+    ASSERT_EQ(g_held.size(), 1u);
+    g_held[0].answer();
+    EXPECT_EQ(answered, 4);
+
+    client.invokeAsync("get", nlohmann::json::array(), [&answered](nlohmann::json) { ++answered; });
+    EXPECT_EQ(answered, 5);
+    EXPECT_EQ(g_asyncCalls.load(), 1);
+}
+
+// ─── Pre-written arguments ──────────────────────────────────────────────────
+
+TEST_F(LpClientEnsureTest, AnArgsWriterReachesTheTransportAsWritten) {
+    logos::LpClient client("target", "origin");
+    const std::vector<uint8_t> blob = {'f', 'o', 'o'};
+    {
+        logos::ArgsWriter args;
+        args.value("a\"b").value(int64_t(3)).bytes(blob);
+        logos::CallError err;
+        EXPECT_EQ(client.invoke("m", args, &err), nlohmann::json("m"));
+        EXPECT_TRUE(err.ok());
+    }
+    EXPECT_EQ(g_lastArgs, R"(["a\"b",3,{"_bytes":"Zm9v"}])");
+
+    nlohmann::json got;
+    logos::ArgsWriter again;
+    again.value(true);
+    client.invokeAsyncResult("m", again,
+        [&got](nlohmann::json r, const logos::CallError&) { got = std::move(r); });
+    EXPECT_EQ(g_lastArgs, "[true]");
+    EXPECT_EQ(got, nlohmann::json("hi"));
+}
+
+// ─── Replies read without a DOM ─────────────────────────────────────────────
+
+namespace {
+
+char* heapText(const std::string& text) {
+    char* p = static_cast<char*>(std::malloc(text.size() + 1));
+    std::memcpy(p, text.c_str(), text.size() + 1);
+    return p;
+}
+
+// The rejection shape, as the result cache tests it on a DOM.
+bool rejectionShaped(const nlohmann::json& j) {
+    if (!j.is_object() || j.size() != 3) return false;
+    for (const char* key : {"code", "message", "origin"})
+        if (!j.contains(key) || !j[key].is_string()) return false;
+    return true;
+}
+
+}  // namespace
+
+TEST(LpReply, ReadsEveryTypeAsTheJsonDecodersDo) {
+    const std::vector<std::string> texts = {
+        "\"s\\u00e9\"", "-5", "7", "18446744073709551615", "2.75", "true", "null",
+        R"(["a",1,"b",null])", "[]", R"({"_bytes":"Zm9v"})", R"({"_bytes":"Zm9v","x":1})",
+        R"({"_bytes":1,"_bytes":"YQ"})", R"({"_bytes":"YQ","_bytes":1})", "{}",
+        R"({"code":"dispatch_failed","message":"m","origin":"o"})",
+        R"({"code":"a","message":"b","origin":"c","code":"d"})",
+        R"({"code":"a","message":"b"})", R"({"code":1,"message":"b","origin":"c"})",
+        "[\"a\",", "\"\xff\"", "", "1e999", "\"s\" x"};
+    for (const std::string& t : texts) {
+        const nlohmann::json j = nlohmann::json::parse(t, nullptr, /*allow_exceptions=*/false);
+        const nlohmann::json dom = j.is_discarded() ? nlohmann::json() : j;
+        // Once as the transport's text, once as a cache hit's json value.
+        for (int held = 0; held < 2; ++held) {
+            auto reply = [&] {
+                return held ? logos::LpReply(dom) : logos::LpReply::adopt(heapText(t));
+            };
+            SCOPED_TRACE(t + (held ? " (json)" : " (text)"));
+            EXPECT_EQ(reply().json(), dom);
+            EXPECT_EQ(reply().as<std::string>(), dom.is_string() ? dom.get<std::string>() : std::string());
+            EXPECT_EQ(reply().as<int64_t>(),
+                      dom.is_number_integer() ? dom.get<int64_t>()
+                          : (dom.is_number() ? static_cast<int64_t>(dom.get<double>()) : 0));
+            EXPECT_EQ(reply().as<uint64_t>(),
+                      dom.is_number_integer() ? dom.get<uint64_t>()
+                          : (dom.is_number() ? static_cast<uint64_t>(dom.get<double>()) : 0u));
+            EXPECT_EQ(reply().as<double>(), dom.is_number() ? dom.get<double>() : 0.0);
+            EXPECT_EQ(reply().as<bool>(), dom.is_boolean() ? dom.get<bool>() : false);
+            EXPECT_EQ(reply().as<std::vector<std::string>>(), logos::jsonToStringVec(dom));
+            EXPECT_EQ(reply().as<std::vector<uint8_t>>(), logos::jsonToBytes(dom));
+            // A prefilter: it may let through what is not a rejection, but
+            // never turn one away.
+            if (rejectionShaped(dom)) {
+                EXPECT_TRUE(reply().mayBeRejection());
+            }
+            if (!dom.is_object()) {
+                EXPECT_FALSE(reply().mayBeRejection());
+            }
+        }
+    }
+}
+
+TEST_F(LpClientEnsureTest, ABlockingReplyIsReadFromItsTextAndThenFreed) {
+    logos::LpClient client("target", "origin");
+    logos::CallError err;
+    {
+        logos::ArgsWriter args;
+        logos::LpReply reply = client.invokeReply("name", args, &err);
+        EXPECT_TRUE(err.ok());
+        EXPECT_EQ(reply.as<std::string>(), "name");
+        EXPECT_FALSE(reply.mayBeRejection());
+        EXPECT_EQ(g_stringsFreed.load(), 0);
+    }
+    EXPECT_EQ(g_stringsFreed.load(), 1);
+
+    // A cached method still gets its value stored, and a hit reads the same.
+    client.cacheMethod("get", 60000);
+    EXPECT_EQ(client.invokeReply("get", nlohmann::json::array(), &err).as<std::string>(), "get");
+    EXPECT_EQ(client.invokeReply("get", nlohmann::json::array(), &err).as<std::string>(), "get");
+    EXPECT_EQ(g_syncCalls.load(), 2);
+}
+
+// ─── Cancellation and deadlines ─────────────────────────────────────────────
+
+class LpClientCancellationTest : public LpClientEnsureTest {};
+
+TEST_F(LpClientCancellationTest, ACancelledCallIsNeverIssued) {
+    logos::LpClient client("target", "origin");
+    logos::CancellationToken token;
+    token.cancel();
+
+    int calls = 0;
+    client.invokeAsyncResult("m", nlohmann::json::array(),
+        [&calls](nlohmann::json, const logos::CallError&) { ++calls; }, token);
+    EXPECT_EQ(g_asyncCalls.load(), 0);
+    EXPECT_EQ(calls, 0);
+}
+
+TEST_F(LpClientCancellationTest, CancellingDropsTheCallbackOfACallInFlight) {
+    logos::LpClient client("target", "origin");
+    g_asyncStub = AsyncStub::Hold;
+    const logos::CancellationToken parent;
+    const logos::CancellationToken token = parent.child();
+
+    int calls = 0;
+    client.invokeAsyncResult("m", nlohmann::json::array(),
+        [&calls](nlohmann::json, const logos::CallError&) { ++calls; }, token);
+    client.invokeAsyncResult("other", nlohmann::json::array(),
+        [&calls](nlohmann::json, const logos::CallError&) { calls += 10; }, logos::CancellationToken());
+    ASSERT_EQ(g_held.size(), 2u);
+
+    parent.cancel();  // reaches the child
+    EXPECT_TRUE(token.cancelled());
+    for (const HeldCall& held : std::vector<HeldCall>(g_held)) held.answer();
+    EXPECT_EQ(calls, 10);
+}
+
+// The callback, and everything it captured, goes when the token is
+// cancelled, not when a reply nobody wants arrives; a call that completes
+// normally leaves no registration behind on the token.
+TEST_F(LpClientCancellationTest, CancellingReleasesTheCallbackAtOnce) {
+    logos::LpClient client("target", "origin");
+    g_asyncStub = AsyncStub::Hold;
+    const logos::CancellationToken token;
+
+    auto captured = std::make_shared<int>(0);
+    std::weak_ptr<int> watch = captured;
+    client.invokeAsyncResult("m", nlohmann::json::array(),
+        [captured](nlohmann::json, const logos::CallError&) { ++*captured; }, token);
+    captured.reset();
+    ASSERT_EQ(g_held.size(), 1u);
+    EXPECT_FALSE(watch.expired());
+
+    token.cancel();
+    EXPECT_TRUE(watch.expired()) << "cancel() must not leave the callback to the reply";
+    g_held[0].answer();  // lands on an empty cell
+}
+
+// What that rests on: a hook runs once, through a parent as well, at once on
+// a token already cancelled, and not at all once its handle is dropped.
+TEST_F(LpClientCancellationTest, OnCancelHooksRunOnceAndOnlyWhileHeld) {
+    const logos::CancellationToken parent;
+    const logos::CancellationToken token = parent.child();
+    int held = 0, dropped = 0;
+    std::shared_ptr<void> handle = token.onCancel([&held] { ++held; });
+    token.onCancel([&dropped] { ++dropped; });  // handle dropped at once
+
+    parent.cancel();
+    token.cancel();
+    EXPECT_EQ(held, 1);
+    EXPECT_EQ(dropped, 0);
+
+    int late = 0;
+    handle = token.onCancel([&late] { ++late; });
+    EXPECT_EQ(late, 1);
+}
+
+TEST_F(LpClientCancellationTest, TheRemainingDeadlineIsForwardedAndAPassedOneFailsFast) {
+    logos::LpClient client("target", "origin");
+    const auto token = logos::CancellationToken::withTimeout(std::chrono::seconds(60));
+
+    logos::CallError err;
+    client.invokeAsyncResult("m", nlohmann::json::array(),
+        [&err](nlohmann::json, const logos::CallError& e) { err = e; }, token.child(std::chrono::seconds(5)));
+    EXPECT_TRUE(err.ok());
+    EXPECT_GT(g_lastAsyncTimeout, 4000);
+    EXPECT_LE(g_lastAsyncTimeout, 5000);
+
+    // No deadline: the protocol default.
+    client.invokeAsyncResult("m", nlohmann::json::array(),
+        [](nlohmann::json, const logos::CallError&) {}, logos::CancellationToken());
+    EXPECT_EQ(g_lastAsyncTimeout, 0);
+
+    const auto late = logos::CancellationToken::withDeadline(
+        logos::CancellationToken::Clock::now() - std::chrono::milliseconds(1));
+    client.invokeAsyncResult("m", nlohmann::json::array(),
+        [&err](nlohmann::json, const logos::CallError& e) { err = e; }, late);
+    EXPECT_EQ(err.code, "timeout");
+    EXPECT_EQ(g_asyncCalls.load(), 2);
+}
+
+// ─── Concurrency limit and admission control ────────────────────────────────
+
+class LpClientConcurrencyLimitTest : public LpClientEnsureTest {
+protected:
+    static logos::ConcurrencyLimiter::Options fixed(int limit, std::size_t maxQueued) {
+        logos::ConcurrencyLimiter::Options o;
+        o.limit = limit;
+        o.maxQueued = maxQueued;
+        o.adaptive = false;
+        return o;
+    }
+};
+
+TEST_F(LpClientConcurrencyLimitTest, CallsOverTheLimitWaitInLineOrAreShed) {
+    logos::LpClient client("target", "origin");
+    client.limitConcurrency(fixed(2, 2));
+    g_asyncStub = AsyncStub::Hold;
+
+    std::vector<std::string> heard;
+    std::vector<logos::CallError> errors;
+    for (const char* m : {"a", "b", "c", "d", "e"})
+        client.invokeAsyncResult(m, nlohmann::json::array(),
+            [&](nlohmann::json r, const logos::CallError& e) {
+                if (e.ok()) heard.push_back(r.get<std::string>());
+                else errors.push_back(e);
+            });
+    ASSERT_EQ(g_held.size(), 2u);  // a, b out; c, d in line
+    ASSERT_EQ(errors.size(), 1u);  // e shed
+    EXPECT_EQ(errors[0].code, "overloaded");
+    EXPECT_EQ(errors[0].origin, "target");
+    EXPECT_EQ(client.concurrencyLimiter()->queued(), 2u);
+
+    // Each reply frees the permit the next in line is issued with, in order.
+    g_held[0].answer();
+    ASSERT_EQ(g_held.size(), 3u);
+    EXPECT_EQ(g_held[2].method, "c");
+    g_held[1].fail();
+    ASSERT_EQ(g_held.size(), 4u);
+    EXPECT_EQ(g_held[3].method, "d");
+    g_held[2].answer();
+    g_held[3].answer();
+    EXPECT_EQ(heard, (std::vector<std::string>{"a", "c", "d"}));
+    EXPECT_EQ(client.concurrencyLimiter()->inFlight(), 0);
+}
+
+TEST_F(LpClientConcurrencyLimitTest, ARefusedCallGivesItsPermitBack) {
+    logos::LpClient client("target", "origin");
+    client.limitConcurrency(fixed(1, 0));
+    g_asyncStub = AsyncStub::RefuseSync;
+    std::string code;
+    client.invokeAsyncResult("m", nlohmann::json::array(),
+        [&code](nlohmann::json, const logos::CallError& e) { code = e.code; });
+    EXPECT_EQ(code, "call_failed");
+
+    g_asyncStub = AsyncStub::Success;
+    client.invokeAsyncResult("m", nlohmann::json::array(),
+        [&code](nlohmann::json, const logos::CallError& e) { code = e.code; });
+    EXPECT_EQ(code, "");
+    EXPECT_EQ(client.concurrencyLimiter()->inFlight(), 0);
+}
+
+TEST_F(LpClientConcurrencyLimitTest, ABlockingCallWaitsForAPermitOrIsShed) {
+    logos::LpClient client("target", "origin");
+    client.limitConcurrency(fixed(1, 1));
+    g_asyncStub = AsyncStub::Hold;
+    client.invokeAsync("held", nlohmann::json::array(), [](nlohmann::json) {});
+    ASSERT_EQ(g_held.size(), 1u);
+
+    nlohmann::json got;
+    std::thread blocked([&] { got = client.invoke("sync", nlohmann::json::array(), nullptr); });
+    while (client.concurrencyLimiter()->queued() == 0) std::this_thread::yield();
+    EXPECT_EQ(g_syncCalls.load(), 0);
+
+    // The line is full: the next blocking call does not wait.
+    logos::CallError err;
+    EXPECT_TRUE(client.invoke("shed", nlohmann::json::array(), &err).is_null());
+    EXPECT_EQ(err.code, "overloaded");
+
+    g_held[0].answer();
+    blocked.join();
+    EXPECT_EQ(got, nlohmann::json("sync"));
+    EXPECT_EQ(client.concurrencyLimiter()->inFlight(), 0);
+}
+
+TEST_F(LpClientConcurrencyLimitTest, CallsStillInLineFailWhenTheClientGoesAway) {
+    std::string code;
+    {
+        logos::LpClient client("target", "origin");
+        client.limitConcurrency(fixed(1, 4));
+        g_asyncStub = AsyncStub::Hold;
+        client.invokeAsync("out", nlohmann::json::array(), [](nlohmann::json) {});
+        client.invokeAsyncResult("waiting", nlohmann::json::array(),
+            [&code](nlohmann::json, const logos::CallError& e) { code = e.code; });
+        EXPECT_EQ(code, "");
+    }
+    EXPECT_EQ(code, "object_unavailable");
+    // The call that was out lands after its client, and starts nothing.
+    g_held[0].answer();
+    EXPECT_EQ(g_held.size(), 1u);
+}
+
+// A completion takes the next call off the line and starts it outside the
+// limiter's lock. A client destroyed in between finds the line already empty,
+// so only the queued call's own reference keeps the transport client alive
+// until it is issued.
+TEST_F(LpClientConcurrencyLimitTest, ACallStartedAsItsClientGoesIsNotIssuedOnADeadClient) {
+    g_asyncStub = AsyncStub::Hold;
+    for (int round = 0; round < 300; ++round) {
+        auto client = std::make_unique<logos::LpClient>("target", "origin");
+        client->limitConcurrency(fixed(1, 4));
+        g_held.clear();
+        client->invokeAsync("out", nlohmann::json::array(), [](nlohmann::json) {});
+        client->invokeAsync("waiting", nlohmann::json::array(), [](nlohmann::json) {});
+        ASSERT_EQ(g_held.size(), 1u);
+        const HeldCall out = g_held[0];
+        std::atomic<bool> go{false};
+        std::thread completion([&] {
+            while (!go) std::this_thread::yield();
+            out.answer();
+        });
+        go = true;
+        // Sweeps the destruction across the completion's window.
+        std::this_thread::sleep_for(std::chrono::microseconds((round % 30) * 10));
+        client.reset();
+        completion.join();
+        // Whichever way the race went, every call has been answered or failed.
+        for (std::size_t i = 1; i < g_held.size(); ++i) g_held[i].answer();
+    }
+    EXPECT_EQ(g_invokedOnDead.load(), 0);
+    EXPECT_EQ(g_created.load(), g_destroyed.load());
+}
+
+TEST(ConcurrencyLimiter, SlowRepliesCutTheLimitOnceAndFastOnesGrowIt) {
+    using Clock = logos::ConcurrencyLimiter::Clock;
+    logos::ConcurrencyLimiter::Options o;
+    o.limit = 10;
+    logos::ConcurrencyLimiter limiter(o);
+    std::vector<Clock::time_point> issued;
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(limiter.tryAcquire());
+        issued.push_back(Clock::now());
+    }
+    EXPECT_FALSE(limiter.tryAcquire());
+
+    // Fast replies while the limit is in use: 10 + 1/10 is still 10 permits,
+    // and the next ten replies are what it takes to earn the 11th.
+    limiter.release(issued[0]);
+    EXPECT_EQ(limiter.limit(), 10);
+
+    // A reply far over the baseline is congestion: cut by the backoff.
+    limiter.release(issued[1] - std::chrono::milliseconds(200));
+    EXPECT_EQ(limiter.limit(), 9);
+    // A call that was out before the cut saw the same stall: no second cut.
+    limiter.release(issued[2] - std::chrono::milliseconds(200));
+    EXPECT_EQ(limiter.limit(), 9);
+
+    for (int i = 0; i < 40; ++i) {
+        ASSERT_TRUE(limiter.tryAcquire());
+        limiter.release(Clock::now());
+    }
+    EXPECT_GT(limiter.limit(), 9);
+}
+
+// ─── Event hub: one subscription and one parse per event, N listeners ───────
+
+class LpClientEventHubTest : public LpClientEnsureTest {};
+
+TEST_F(LpClientEventHubTest, ListenersOfOneEventShareOneSubscriptionAndOneParse) {
+    logos::LpClient client("target", "origin");
+    std::vector<const nlohmann::json*> seen;
+    int byValue = 0;
+    auto a = client.subscribe("tick", [&seen](const nlohmann::json& p) { seen.push_back(&p); });
+    auto b = client.subscribe("tick", [&seen](const nlohmann::json& p) { seen.push_back(&p); });
+    auto c = client.subscribe("tick", [&byValue](nlohmann::json p) { byValue += p.at(0).get<int>(); });
+    auto other = client.subscribe("tock", [](const nlohmann::json&) {});
+    ASSERT_TRUE(a.valid() && b.valid() && c.valid() && other.valid());
+    EXPECT_EQ(g_subs.size(), 2u);
+
+    emitEvent("tick", "[7]");
+    ASSERT_EQ(seen.size(), 2u);
+    EXPECT_EQ(seen[0], seen[1]) << "each listener parsed the payload again";
+    EXPECT_EQ(byValue, 7);
+
+    // The subscription stays while any listener does.
+    a = logos::LpSubscription();
+    b = logos::LpSubscription();
+    EXPECT_EQ(g_subs.size(), 2u);
+    emitEvent("tick", "[1]");
+    EXPECT_EQ(seen.size(), 2u);
+    EXPECT_EQ(byValue, 8);
+    c = logos::LpSubscription();
+    EXPECT_EQ(g_subs.size(), 1u);
+
+    // And a later listener subscribes afresh.
+    auto d = client.subscribe("tick", [&byValue](const nlohmann::json&) { ++byValue; });
+    EXPECT_EQ(g_subs.size(), 2u);
+    emitEvent("tick");
+    EXPECT_EQ(byValue, 9);
+}
+
+TEST_F(LpClientEventHubTest, AListenerMayRemoveItselfFromItsOwnCallback) {
+    logos::LpClient client("target", "origin");
+    int once = 0, always = 0;
+    logos::LpSubscription self;
+    self = client.subscribe("tick", [&](const nlohmann::json&) {
+        ++once;
+        self = logos::LpSubscription();
+    });
+    auto keep = client.subscribe("tick", [&always](const nlohmann::json&) { ++always; });
+    emitEvent("tick");
+    emitEvent("tick");
+    EXPECT_EQ(once, 1);
+    EXPECT_EQ(always, 2);
+}
+
+TEST_F(LpClientEventHubTest, RemovalWaitsForACallRunningOnAnotherThread) {
+    logos::LpClient client("target", "origin");
+    std::atomic<bool> entered{false}, release{false}, finished{false};
+    auto sub = client.subscribe("tick", [&](const nlohmann::json&) {
+        entered = true;
+        while (!release) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        finished = true;
+    });
+    std::thread deliver([] { emitEvent("tick"); });
+    while (!entered) std::this_thread::yield();
+    std::thread opener([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        release = true;
+    });
+    // The removal sleeps through the wait: a slow listener must not cost
+    // the remover a core for as long as it runs.
+    const std::clock_t cpuBefore = std::clock();
+    sub = logos::LpSubscription();
+    const double cpuMs = 1000.0 * double(std::clock() - cpuBefore) / CLOCKS_PER_SEC;
+    EXPECT_TRUE(finished) << "the handle went while its callback was still running";
+    EXPECT_LT(cpuMs, 50.0) << "the removal spun while it waited";
+    deliver.join();
+    opener.join();
+}
+
+// ─── Decoded channels: one decode per arrival for every typed listener ──────
+
+namespace {
+
+int g_decodes = 0;
+
+bool decodeTick(const nlohmann::json& a, std::tuple<std::string, int64_t>& out) {
+    ++g_decodes;
+    if (!a.is_array() || a.size() < 2 || !a.at(0).is_string() || !a.at(1).is_number()) return false;
+    out = std::make_tuple(a.at(0).get<std::string>(), a.at(1).get<int64_t>());
+    return true;
+}
+
+bool decodeFirst(const nlohmann::json& a, std::string& out) {
+    ++g_decodes;
+    if (!a.is_array() || a.empty() || !a.at(0).is_string()) return false;
+    out = a.at(0).get<std::string>();
+    return true;
+}
+
+}  // namespace
+
+TEST_F(LpClientEventHubTest, ListenersWithOneDecoderShareOneDecode) {
+    g_decodes = 0;
+    logos::LpClient client("target", "origin");
+    using Tick = std::tuple<std::string, int64_t>;
+    std::vector<const Tick*> seen;
+    int64_t price = 0;
+    auto a = client.subscribeDecoded<Tick>("tick", &decodeTick, [&](const Tick& t) {
+        seen.push_back(&t);
+        price = std::get<1>(t);
+    });
+    auto b = client.subscribeDecoded<Tick>("tick", &decodeTick, [&seen](const Tick& t) { seen.push_back(&t); });
+    std::string first;
+    auto c = client.subscribeDecoded<std::string>("tick", &decodeFirst,
+                                                  [&first](const std::string& s) { first = s; });
+    int raw = 0;
+    auto d = client.subscribe("tick", [&raw](const nlohmann::json&) { ++raw; });
+    EXPECT_EQ(g_subs.size(), 1u);
+
+    emitEvent("tick", "[\"btc\", 42]");
+    ASSERT_EQ(seen.size(), 2u);
+    EXPECT_EQ(seen[0], seen[1]) << "each listener decoded the payload again";
+    EXPECT_EQ(price, 42);
+    EXPECT_EQ(first, "btc");
+    EXPECT_EQ(raw, 1);
+    EXPECT_EQ(g_decodes, 2) << "one decode per decoder, not per listener";
+
+    // A payload the decoder rejects reaches none of its listeners.
+    emitEvent("tick", "[\"btc\"]");
+    EXPECT_EQ(seen.size(), 2u);
+    EXPECT_EQ(raw, 2);
+
+    a = logos::LpSubscription();
+    b = logos::LpSubscription();
+    c = logos::LpSubscription();
+    EXPECT_EQ(g_subs.size(), 1u) << "the raw listener still holds the subscription";
+    g_decodes = 0;
+    emitEvent("tick", "[\"eth\", 1]");
+    EXPECT_EQ(g_decodes, 0) << "a channel with no listeners left still decoded";
+    d = logos::LpSubscription();
+    EXPECT_TRUE(g_subs.empty());
+}
+
+TEST_F(LpClientEventHubTest, FilteredListenersHearOnlyTheArrivalsTheyMatch) {
+    logos::LpClient client("target", "origin");
+    std::vector<int64_t> mine, big, all;
+    logos::EventFilter acct;
+    acct.equal({0}, "acct-42");
+    auto a = client.subscribe("transferred", acct, [&mine](const nlohmann::json& p) {
+        mine.push_back(p.at(1).at("amount").get<int64_t>());
+    });
+    logos::EventFilter large;
+    large.greaterOrEqual({1, "amount"}, 1000);
+    auto b = client.subscribe("transferred", large, [&big](const nlohmann::json& p) {
+        big.push_back(p.at(1).at("amount").get<int64_t>());
+    });
+    EXPECT_EQ(g_subs.size(), 1u) << "filtered listeners share the event's subscription";
+
+    emitEvent("transferred", R"(["acct-7", {"amount": 5}])");
+    emitEvent("transferred", R"(["acct-42", {"amount": 10}])");
+    emitEvent("transferred", R"(["acct-7", {"amount": 2500}])");
+    EXPECT_EQ(mine, (std::vector<int64_t>{10}));
+    EXPECT_EQ(big, (std::vector<int64_t>{2500}));
+
+    // Text that only looks right as far as the filter read is not delivered
+    // to it; an unfiltered listener still gets the empty argument list.
+    auto c = client.subscribe("transferred", [&all](const nlohmann::json& p) {
+        all.push_back(static_cast<int64_t>(p.size()));
+    });
+    emitEvent("transferred", R"(["acct-42", {"amount": 11}] trailing)");
+    EXPECT_EQ(mine, (std::vector<int64_t>{10}));
+    EXPECT_EQ(all, (std::vector<int64_t>{0}));
+}
+
+TEST_F(LpClientEventHubTest, AQueuedListenerRunsOffTheDeliveringThread) {
+    logos::LpClient client("target", "origin");
+    std::mutex m;
+    std::condition_variable cv;
+    bool release = false;
+    std::vector<int> slow;
+    std::thread::id slowThread;
+    int fast = 0;
+    bool entered = false;
+    auto a = client.subscribe("tick", [&](const nlohmann::json& p) {
+        std::unique_lock<std::mutex> lock(m);
+        slowThread = std::this_thread::get_id();
+        entered = true;
+        cv.notify_all();
+        cv.wait(lock, [&] { return release; });
+        slow.push_back(p.at(0).get<int>());
+        cv.notify_all();
+    }, logos::EventQueueOptions{2, logos::EventQueueOptions::Overflow::DropOldest});
+    auto b = client.subscribe("tick", [&fast](const nlohmann::json&) { ++fast; });
+    ASSERT_NE(a.queueCounters(), nullptr);
+    EXPECT_EQ(b.queueCounters(), nullptr);
+
+    // The held listener takes the first arrival, two wait, and the rest push
+    // the oldest out. None of it holds up the unqueued listener.
+    emitEvent("tick", "[0]");
+    {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [&] { return entered; });
+    }
+    for (int i = 1; i < 6; ++i) emitEvent("tick", ("[" + std::to_string(i) + "]").c_str());
+    EXPECT_EQ(fast, 6);
+    {
+        std::unique_lock<std::mutex> lock(m);
+        release = true;
+        cv.notify_all();
+        cv.wait(lock, [&] { return slow.size() == 3; });
+    }
+    EXPECT_EQ(slow.front(), 0);
+    EXPECT_EQ(slow.back(), 5);
+    EXPECT_NE(slowThread, std::this_thread::get_id());
+    EXPECT_EQ(a.queueCounters()->dropped.load(), 3u);
+
+    a = logos::LpSubscription();
+    emitEvent("tick", "[9]");
+    EXPECT_EQ(slow.size(), 3u);
+}
+
+TEST_F(LpClientEventHubTest, AnExecutorMovesAListenerOffTheDeliveringThreadInOrder) {
+    logos::LpClient client("target", "origin");
+    logos::ThreadPool pool(2);
+    std::mutex m;
+    std::vector<int> seen;
+    std::set<std::thread::id> threads;
+    auto sub = client.subscribe("tick", [&](const nlohmann::json& p) {
+        std::lock_guard<std::mutex> lock(m);
+        seen.push_back(p.at(0).get<int>());
+        threads.insert(std::this_thread::get_id());
+    }, {}, &pool);
+    ASSERT_NE(sub.queueCounters(), nullptr);
+    for (int i = 0; i < 100; ++i) emitEvent("tick", ("[" + std::to_string(i) + "]").c_str());
+    while (sub.queueCounters()->delivered.load() < 100) std::this_thread::yield();
+    sub = logos::LpSubscription();
+
+    ASSERT_EQ(seen.size(), 100u);
+    for (int i = 0; i < 100; ++i) EXPECT_EQ(seen[i], i);
+    EXPECT_EQ(threads.count(std::this_thread::get_id()), 0u);
+}
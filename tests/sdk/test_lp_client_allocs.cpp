@@ -0,0 +1,171 @@
+// LpClient's completion slots, counted: a warm pool issues a small callback
+// without allocating for it.
+//
+// Both async entry points hand their callback to a pooled, fixed-size slot
+// rather than a `new std::function` box (test_lp_client.cpp covers what the
+// slots do). What this suite pins is what they COST, which takes a counting
+// global allocator — so it is its own executable, sdk_alloc_tests, and the
+// rest of the SDK's tests keep the standard one (see alloc_counter.h).
+//
+// As in test_lp_client.cpp, the lp_* symbols are LOCAL STUBS. lp_invoke_async
+// holds every call for the test to answer, from whichever thread it likes.
+
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "alloc_counter.h"
+#include "logos_lp_client.h"
+
+namespace {
+
+struct HeldCall {
+    lp_result_cb cb;
+    void* ud;
+    void answer() const { cb(1, "\"m\"", ud); }
+};
+std::vector<HeldCall> g_held;
+
+}  // namespace
+
+extern "C" {
+
+lp_client* lp_client_create(const char*, const char*, const char*, const char*)
+{
+    return reinterpret_cast<lp_client*>(new std::uintptr_t(0xC0FFEEu));
+}
+
+void lp_client_destroy(lp_client* client)
+{
+    delete reinterpret_cast<std::uintptr_t*>(client);
+}
+
+int lp_invoke_async(lp_client*, const char*, const char*, int, lp_result_cb cb, void* user_data)
+{
+    g_held.push_back({cb, user_data});
+    return LP_OK;
+}
+
+// Only the result cache subscribes, and nothing here turns it on.
+lp_subscription* lp_subscribe(lp_client*, const char*, lp_event_cb, void*)
+{
+    return reinterpret_cast<lp_subscription*>(new int(0));
+}
+
+void lp_unsubscribe(lp_subscription* sub)
+{
+    delete reinterpret_cast<int*>(sub);
+}
+
+}  // extern "C"
+
+class LpClientCompletionAllocTest : public ::testing::Test {
+protected:
+    void SetUp() override { g_held.clear(); }
+};
+
+TEST_F(LpClientCompletionAllocTest, AWarmPoolIssuesASmallCallbackWithoutAllocating)
+{
+    logos::LpClient client("target", "origin");
+    g_held.reserve(8);
+    const nlohmann::json args = nlohmann::json::array();
+
+    // The shape the generated `<name>AsyncResult` adapter has: a lambda that
+    // captures the caller's std::function.
+    int delivered = 0;
+    std::function<void(int)> user = [&delivered](int n) { delivered += n; };
+    auto issue = [&] {
+        client.invokeAsyncResult("m", args, [user](nlohmann::json, const logos::CallError&) { user(1); });
+    };
+    issue();                 // builds the client and warms the pool
+    g_held.back().answer();
+
+    // Serializing the arguments allocates inside nlohmann's serializer, which
+    // is not this path's to remove, so it is measured and subtracted: the
+    // completion itself must add nothing.
+    int serializerAllocs = 0;
+    {
+        logos_tests::AllocCount allocs;
+        (void)args.dump();
+        serializerAllocs = allocs.count();
+    }
+    {
+        logos_tests::AllocCount allocs;
+        issue();
+        EXPECT_EQ(allocs.count(), serializerAllocs);
+    }
+
+    g_held.back().answer();
+    EXPECT_EQ(delivered, 2);
+}
+
+// The real transport completes on a thread of its own, so the slots a caller
+// takes are freed somewhere else. They must find their way back through the
+// shared list, a batch at a time, rather than the caller allocating afresh
+// once its own cache is spent.
+TEST_F(LpClientCompletionAllocTest, SlotsFreedOnTheTransportThreadAreReusedByTheCaller)
+{
+    logos::LpClient client("target", "origin");
+    constexpr int kRound = 100;
+    g_held.reserve(kRound);
+    const nlohmann::json args = nlohmann::json::array();
+
+    // Stands in for the transport's thread: answers every held call, a round
+    // at a time, and lives across rounds as that thread does.
+    std::mutex mutex;
+    std::condition_variable cv;
+    int requested = 0, answered = 0;
+    bool stop = false;
+    std::thread transport([&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            cv.wait(lock, [&] { return stop || requested > answered; });
+            if (stop) return;
+            for (const HeldCall& call : g_held) call.answer();
+            g_held.clear();
+            ++answered;
+            cv.notify_all();
+        }
+    });
+    int delivered = 0;
+    auto round = [&] {
+        for (int i = 0; i < kRound; ++i)
+            client.invokeAsyncResult("m", args, [&delivered](nlohmann::json, const logos::CallError&) { ++delivered; });
+        std::unique_lock<std::mutex> lock(mutex);
+        ++requested;
+        cv.notify_all();
+        cv.wait(lock, [&] { return answered == requested; });
+    };
+
+    // Warms both threads' caches and the shared list. Until the transport's
+    // cache is full it keeps a slot a round for itself, so that can take as
+    // many rounds as the cache holds.
+    const int warm = static_cast<int>(logos::detail::CompletionPool::kMaxLocal);
+    for (int i = 0; i < warm; ++i) round();
+
+    int serializerAllocs = 0;
+    {
+        logos_tests::AllocCount allocs;
+        (void)args.dump();
+        serializerAllocs = allocs.count();
+    }
+    {
+        logos_tests::AllocCount allocs;
+        round();
+        EXPECT_EQ(allocs.count(), kRound * serializerAllocs);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    cv.notify_all();
+    transport.join();
+    EXPECT_EQ(delivered, (warm + 1) * kRound);
+}